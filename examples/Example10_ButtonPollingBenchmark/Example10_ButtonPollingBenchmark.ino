@@ -0,0 +1,191 @@
+//      ******************************************************************
+//      *                                                                *
+//      *          Benchmark the time used to poll the buttons           *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Most sketches call getButtonEvent() from loop(), thousands of times a 
+// second.  By default, each call reads the buttons with analogRead(), which 
+// waits about 110uS for the ADC to finish a conversion, even when no button 
+// is pressed.  On AVR boards, the library can instead read the buttons with 
+// "split phase" conversions: each call starts a conversion and returns the 
+// result of the previous one without waiting.  The ADC can also be clocked 
+// faster, since the resistor ladder doesn't need 10 bit accuracy.
+//
+// This sketch counts the number of times loop() can poll the buttons in one 
+// second, first with analogRead(), then with split phase conversions.  
+// Results are shown on the LCD and printed to the Serial Monitor.  Don't 
+// press any buttons while it runs.
+//
+// 
+// Documentation for the "Arduino User Interface" library and "Arduino UI Shield"  
+// can be found at:
+//    https://github.com/Stan-Reifel/ArduinoUserInterface
+
+
+
+// ***********************************************************************
+
+#include <ArduinoUserInterface.h>
+
+
+//
+// assign IO pin numbers for the LCD display and buttons
+//
+#ifdef ARDUINO_AVR_NANO
+  //
+  // use these pin numbers if the display is connected to an Arduino NANO
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = A3;
+  const byte BUTTONS_ANALOG_PIN = A6;
+#else
+  //
+  // use these pin numbers if the display is connected to an Uno or Mega
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = 4;
+  const byte BUTTONS_ANALOG_PIN = A3;
+#endif
+
+
+//
+// length of each measurement in milliseconds
+//
+const unsigned long MEASUREMENT_PERIOD_MS = 1000;
+
+
+//
+// create the user interface object
+//
+ArduinoUserInterface ui;
+
+
+//
+// measured results in loops per second
+//
+unsigned long analogReadLoopsPerSecond;
+unsigned long splitPhaseLoopsPerSecond;
+
+
+// ---------------------------------------------------------------------------------
+//                                 Setup the hardware
+// ---------------------------------------------------------------------------------
+
+void setup() 
+{
+  Serial.begin(9600);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN);
+
+  ui.lcdClearDisplay();
+  ui.lcdSetCursorXY(0, 2);
+  ui.lcdPrintString("Measuring...");
+
+  //
+  // measure polling with analogRead()
+  //
+  ui.buttonsUseSplitPhaseADC(false);
+  analogReadLoopsPerSecond = measureLoopsPerSecond();
+  printResults("analogRead()", analogReadLoopsPerSecond);
+
+  //
+  // measure polling with split phase conversions and a fast ADC clock
+  //
+  ui.buttonsUseSplitPhaseADC(true, BUTTON_ADC_PRESCALER_16);
+  splitPhaseLoopsPerSecond = measureLoopsPerSecond();
+  printResults("Split phase", splitPhaseLoopsPerSecond);
+
+  //
+  // show the results on the LCD
+  //
+  showResults();
+}
+
+
+
+//
+// nothing more to do after the measurements are taken
+//
+void loop() 
+{
+}
+
+
+// ---------------------------------------------------------------------------------
+//                              Measure and show results
+// ---------------------------------------------------------------------------------
+
+//
+// poll the buttons as fast as possible, return the number of polls in one second
+//
+unsigned long measureLoopsPerSecond(void)
+{
+  unsigned long startTime;
+  unsigned long loopCount;
+  
+  loopCount = 0;
+  startTime = millis();
+  while(millis() - startTime < MEASUREMENT_PERIOD_MS)
+  {
+    ui.getButtonEvent();
+    loopCount++;
+  }
+
+  return((loopCount * 1000L) / MEASUREMENT_PERIOD_MS);
+}
+
+
+
+//
+// show the results on the LCD
+//
+void showResults(void)
+{
+  ui.lcdClearDisplay();
+
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString("Loops per sec:");
+
+  ui.lcdSetCursorXY(0, 2);
+  ui.lcdPrintString("analogRead()");
+  ui.lcdSetCursorXY(6, 3);
+  printLongOnLCD(analogReadLoopsPerSecond);
+
+  ui.lcdSetCursorXY(0, 4);
+  ui.lcdPrintString("Split phase");
+  ui.lcdSetCursorXY(6, 5);
+  printLongOnLCD(splitPhaseLoopsPerSecond);
+}
+
+
+
+//
+// print a number that may be too big for lcdPrintInt()
+//
+void printLongOnLCD(unsigned long n)
+{
+  char s[12];
+
+  ultoa(n, s, 10);
+  ui.lcdPrintString(s);
+}
+
+
+
+//
+// print the results of one measurement to the serial monitor
+//
+void printResults(char *modeName, unsigned long loopsPerSecond)
+{
+  Serial.print(modeName);
+  Serial.print(": ");
+  Serial.print(loopsPerSecond);
+  Serial.println(" loops per second");
+}
+
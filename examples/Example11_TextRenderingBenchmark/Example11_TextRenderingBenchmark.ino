@@ -0,0 +1,196 @@
+//      ******************************************************************
+//      *                                                                *
+//      *             Benchmark the time used to draw text               *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Most of the time spent updating the screen goes to drawing text: menu 
+// items, the button bar and the application's own displays.  This sketch 
+// measures the time to draw one character (glyph), for both normal and 
+// reverse video text.
+//
+// Each is measured twice.  The first draws directly to the LCD, so it 
+// includes sending the bytes.  The second draws into a frame buffer in RAM, 
+// which leaves just the time to fetch the glyph from the font table and 
+// render it.  Results are given in CPU cycles per glyph, shown on the LCD 
+// and printed to the Serial Monitor.
+//
+// Reverse video text is faster when the library is built with 
+// ARDUINO_USER_INTERFACE_REVERSE_FONT set to 1 (see ArduinoUserInterface.h), 
+// which stores a pre-inverted copy of the font in program memory.
+//
+// 
+// Documentation for the "Arduino User Interface" library and "Arduino UI Shield"  
+// can be found at:
+//    https://github.com/Stan-Reifel/ArduinoUserInterface
+
+
+
+// ***********************************************************************
+
+#include <ArduinoUserInterface.h>
+
+
+//
+// assign IO pin numbers for the LCD display and buttons
+//
+#ifdef ARDUINO_AVR_NANO
+  //
+  // use these pin numbers if the display is connected to an Arduino NANO
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = A3;
+  const byte BUTTONS_ANALOG_PIN = A6;
+#else
+  //
+  // use these pin numbers if the display is connected to an Uno or Mega
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = 4;
+  const byte BUTTONS_ANALOG_PIN = A3;
+#endif
+
+
+//
+// text drawn for each measurement, and the number of times it's drawn
+//
+char testString[] = "The quick fox";
+const int NUMBER_OF_REPEATS = 50;
+
+
+//
+// create the user interface object, and a frame buffer to draw into
+//
+ArduinoUserInterface ui;
+byte frameBuffer[LCD_FRAME_BUFFER_SIZE];
+
+
+//
+// measured results in CPU cycles per glyph
+//
+unsigned long normalToLCDCycles;
+unsigned long reverseToLCDCycles;
+unsigned long normalToBufferCycles;
+unsigned long reverseToBufferCycles;
+
+
+// ---------------------------------------------------------------------------------
+//                                 Setup the hardware
+// ---------------------------------------------------------------------------------
+
+void setup() 
+{
+  Serial.begin(9600);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN);
+
+  //
+  // measure drawing directly to the LCD
+  //
+  normalToLCDCycles = measureCyclesPerGlyph(false);
+  reverseToLCDCycles = measureCyclesPerGlyph(true);
+
+  //
+  // measure drawing into the frame buffer, then stop using it
+  //
+  ui.lcdUseFrameBuffer(frameBuffer);
+  normalToBufferCycles = measureCyclesPerGlyph(false);
+  reverseToBufferCycles = measureCyclesPerGlyph(true);
+  ui.lcdUseFrameBuffer(NULL);
+
+  printResults("Normal to LCD", normalToLCDCycles);
+  printResults("Reverse to LCD", reverseToLCDCycles);
+  printResults("Normal to buffer", normalToBufferCycles);
+  printResults("Reverse to buffer", reverseToBufferCycles);
+
+  //
+  // show the results on the LCD
+  //
+  showResults();
+}
+
+
+
+//
+// nothing more to do after the measurements are taken
+//
+void loop() 
+{
+}
+
+
+// ---------------------------------------------------------------------------------
+//                              Measure and show results
+// ---------------------------------------------------------------------------------
+
+//
+// draw the test string many times, return the average CPU cycles for one glyph
+//  Enter:  reverseFlg = true to draw reverse video text
+//
+unsigned long measureCyclesPerGlyph(boolean reverseFlg)
+{
+  unsigned long startTime;
+  unsigned long elapsedMicros;
+  int i;
+  
+  startTime = micros();
+  for (i = 0; i < NUMBER_OF_REPEATS; i++)
+  {
+    ui.lcdSetCursorXY(0, 2);
+    if (reverseFlg)
+      ui.lcdPrintStringReverse(testString);
+    else
+      ui.lcdPrintString(testString);
+  }
+  elapsedMicros = micros() - startTime;
+
+  return((elapsedMicros * (F_CPU / 1000000L)) / ((long) NUMBER_OF_REPEATS * strlen(testString)));
+}
+
+
+
+//
+// show the results on the LCD
+//
+void showResults(void)
+{
+  ui.lcdClearDisplay();
+
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString("Cycles/glyph:");
+
+  ui.lcdSetCursorXY(0, 1);
+  ui.lcdPrintString("LCD     ");
+  ui.lcdPrintInt(normalToLCDCycles);
+
+  ui.lcdSetCursorXY(0, 2);
+  ui.lcdPrintString("LCD rev ");
+  ui.lcdPrintInt(reverseToLCDCycles);
+
+  ui.lcdSetCursorXY(0, 3);
+  ui.lcdPrintString("RAM     ");
+  ui.lcdPrintInt(normalToBufferCycles);
+
+  ui.lcdSetCursorXY(0, 4);
+  ui.lcdPrintString("RAM rev ");
+  ui.lcdPrintInt(reverseToBufferCycles);
+}
+
+
+
+//
+// print the results of one measurement to the serial monitor
+//
+void printResults(char *measurementName, unsigned long cyclesPerGlyph)
+{
+  Serial.print(measurementName);
+  Serial.print(": ");
+  Serial.print(cyclesPerGlyph);
+  Serial.println(" CPU cycles per glyph");
+}
+
@@ -0,0 +1,199 @@
+//      ******************************************************************
+//      *                                                                *
+//      *         Large digits for readouts that update quickly          *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Values that need to be read from across the room can be drawn with the 
+// font scaled up 2 or 3 times, making characters 16 or 24 pixels high.  
+// This sketch shows a timer counting hundredths of a second, updated 100 
+// times a second.  Since usually only the last digit or two change, the timer 
+// is drawn with lcdUpdateStringLarge(), which only sends the characters that 
+// are different from the last time.  
+//
+// The time used by each update is shown below the timer.  Press the "Reset" 
+// button to start the timer over.
+//
+// 
+// Documentation for the "Arduino User Interface" library and "Arduino UI Shield"  
+// can be found at:
+//    https://github.com/Stan-Reifel/ArduinoUserInterface
+
+
+
+// ***********************************************************************
+
+#include <ArduinoUserInterface.h>
+
+
+//
+// assign IO pin numbers for the LCD display and buttons
+//
+#ifdef ARDUINO_AVR_NANO
+  //
+  // use these pin numbers if the display is connected to an Arduino NANO
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = A3;
+  const byte BUTTONS_ANALOG_PIN = A6;
+#else
+  //
+  // use these pin numbers if the display is connected to an Uno or Mega
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = 4;
+  const byte BUTTONS_ANALOG_PIN = A3;
+#endif
+
+
+//
+// position and size of the timer
+//
+const byte TIMER_SCALE = 3;
+const byte TIMER_LINE_NUMBER = 0;
+
+
+//
+// milliseconds between updates of the timer
+//
+const unsigned long UPDATE_PERIOD_MS = 10;
+
+
+//
+// create the user interface object
+//
+ArduinoUserInterface ui;
+
+
+//
+// local vars
+//
+unsigned long timerStartTime;
+unsigned long lastUpdateTime;
+char timerText[8];
+char previousTimerText[8];
+unsigned long updateMicrosTotal;
+unsigned int updateCount;
+
+
+// ---------------------------------------------------------------------------------
+//                                 Setup the hardware
+// ---------------------------------------------------------------------------------
+
+void setup() 
+{
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN);
+
+  //
+  // use the proportional font so the digits fit across the screen
+  //
+  ui.lcdSetFont(&lcdFontProportional);
+  ui.drawButtonBar("Reset", "");
+
+  resetTimer();
+}
+
+
+
+//
+// update the timer every 10ms, and the time used by the updates once a second
+//
+void loop() 
+{
+  unsigned long timeNow;
+  unsigned long updateStartMicros;
+
+  if (ui.getButtonEvent() == BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT)
+    resetTimer();
+
+  timeNow = millis();
+  if (timeNow - lastUpdateTime < UPDATE_PERIOD_MS)
+    return;
+  lastUpdateTime = timeNow;
+
+  //
+  // draw the characters of the timer that changed, timing how long it takes
+  //
+  updateStartMicros = micros();
+  formatTimer(timeNow - timerStartTime, timerText);
+  ui.lcdSetCursorXY(timerColumnX(), TIMER_LINE_NUMBER);
+  ui.lcdUpdateStringLarge(timerText, previousTimerText, TIMER_SCALE);
+  strcpy(previousTimerText, timerText);
+  updateMicrosTotal += micros() - updateStartMicros;
+  updateCount++;
+
+  //
+  // once a second, show the average time for an update
+  //
+  if (updateCount >= 1000 / UPDATE_PERIOD_MS)
+  {
+    ui.lcdSetCursorXY(0, 4);
+    ui.lcdPrintString("uS/update: ");
+    ui.lcdPrintIntLeftJustified(updateMicrosTotal / updateCount, 5);
+    updateMicrosTotal = 0;
+    updateCount = 0;
+  }
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                  Timer functions
+// ---------------------------------------------------------------------------------
+
+//
+// start the timer over, drawing it completely
+//
+void resetTimer(void)
+{
+  ui.clearDisplaySpace();
+
+  timerStartTime = millis();
+  lastUpdateTime = timerStartTime;
+  formatTimer(0, timerText);
+  ui.lcdSetCursorXY(timerColumnX(), TIMER_LINE_NUMBER);
+  ui.lcdPrintStringLarge(timerText, TIMER_SCALE);
+  strcpy(previousTimerText, timerText);
+
+  updateMicrosTotal = 0;
+  updateCount = 0;
+}
+
+
+
+//
+// format the time as seconds and hundredths, such as "12.34"
+//  Enter:  milliSeconds = time to format
+//          s -> buffer for the formatted time
+//
+void formatTimer(unsigned long milliSeconds, char *s)
+{
+  unsigned int seconds;
+  byte hundredths;
+
+  seconds = (milliSeconds / 1000L) % 100;
+  hundredths = (milliSeconds % 1000L) / 10;
+
+  s[0] = (seconds / 10) + '0';
+  s[1] = (seconds % 10) + '0';
+  s[2] = '.';
+  s[3] = (hundredths / 10) + '0';
+  s[4] = (hundredths % 10) + '0';
+  s[5] = 0;
+}
+
+
+
+//
+// column where the timer starts, so that it's centered
+//
+byte timerColumnX(void)
+{
+  return((LCD_WIDTH_IN_PIXELS - (ui.lcdStringWidthInPixels("00.00") * TIMER_SCALE)) / 2);
+}
+
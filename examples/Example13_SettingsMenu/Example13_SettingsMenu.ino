@@ -0,0 +1,225 @@
+//      ******************************************************************
+//      *                                                                *
+//      *        A settings menu made from a table of the settings       *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Example6 saves two settings, and for each one it needs a menu command, a
+// slider callback and functions to read and write the EEPROM.  This sketch
+// saves four settings with none of that code.
+//
+// The settings are kept together in a struct that is loaded from the EEPROM
+// with loadConfiguration().  A table lists each setting: its label, the field
+// of the struct it changes, and its limits.  The library builds a menu from
+// the table.  Selecting a number opens a slider for it, and selecting a toggle
+// changes it.  When Set is pressed, the settings are saved to the EEPROM.
+// The current value of each setting is shown in the menu.
+//
+// The function mySettingChanged() is called each time a setting changes, so
+// the contrast can be seen changing as its slider is moved.
+//
+//
+// Documentation for the "Arduino User Interface" library and "Arduino UI Shield"
+// can be found at:
+//    https://github.com/Stan-Reifel/ArduinoUserInterface
+
+
+
+// ***********************************************************************
+
+#include <ArduinoUserInterface.h>
+
+
+//
+// assign IO pin numbers for the LCD display and buttons
+//
+#ifdef ARDUINO_AVR_NANO
+  //
+  // use these pin numbers if the display is connected to an Arduino NANO
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = A3;
+  const byte BUTTONS_ANALOG_PIN = A6;
+#else
+  //
+  // use these pin numbers if the display is connected to an Uno or Mega
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = 4;
+  const byte BUTTONS_ANALOG_PIN = A3;
+#endif
+
+
+//
+// other pin assignments
+//
+const int LED_PIN = 13;
+
+
+//
+// create the user interface object
+//
+ArduinoUserInterface ui;
+
+
+// ---------------------------------------------------------------------------------
+//                          The settings saved in EEPROM
+// ---------------------------------------------------------------------------------
+
+//
+// all of the settings, new fields should be added to the end
+//
+struct MY_CONFIG
+{
+  byte Contrast;
+  byte LEDOn;
+  int BlinkTime;                         // in hundredths of a second
+  byte BlinkCount;
+};
+
+MY_CONFIG config;
+
+
+//
+// the default value of each field, used until the settings are saved
+//
+const CONFIG_FIELD myConfigFields[] PROGMEM = {
+  CONFIG_FIELD_ENTRY(MY_CONFIG, Contrast, 80),
+  CONFIG_FIELD_ENTRY(MY_CONFIG, LEDOn, false),
+  CONFIG_FIELD_ENTRY(MY_CONFIG, BlinkTime, 50),
+  CONFIG_FIELD_ENTRY(MY_CONFIG, BlinkCount, 3)};
+
+
+//
+// where the settings are saved: EEPROM address 0, 32 bytes reserved for the 
+// struct, version 1 and no migrate function.  2 * (32 + 6) bytes of EEPROM are 
+// used
+//
+CONFIG_SCHEMA_DEFINE(myConfigSchema, 0, 32, 1, config, myConfigFields, NULL);
+
+
+//
+// the settings menu, each entry gives the label, the field and its limits
+//
+SETTINGS_TABLE_P(mySettings,
+  SETTING_ENTRY_INT(MY_CONFIG, Contrast, "Contrast", 1, 127, 1),
+  SETTING_ENTRY_TOGGLE(MY_CONFIG, LEDOn, "LED", 0, 1),
+  SETTING_ENTRY_DECIMAL(MY_CONFIG, BlinkTime, "Blink time", 10, 200, 5, 2),
+  SETTING_ENTRY_TOGGLE(MY_CONFIG, BlinkCount, "Blinks", 1, 5));
+
+SETTINGS_MENU mySettingsMenu = {
+  mySettings, sizeof(mySettings) / sizeof(mySettings[0]), mySettingChanged};
+
+
+// ---------------------------------------------------------------------------------
+//                                 Setup the hardware
+// ---------------------------------------------------------------------------------
+
+void setup()
+{
+  //
+  // setup the LED pin and enable print statements
+  //
+  pinMode(LED_PIN, OUTPUT);
+  Serial.begin(9600);
+
+
+  //
+  // assign pin numbers to the LCD display and buttons
+  //
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN);
+
+
+  //
+  // read the settings from EEPROM, then set the contrast and LED
+  //
+  ui.loadConfiguration(&myConfigSchema);
+  ui.lcdSetContrast(config.Contrast);
+  digitalWrite(LED_PIN, config.LEDOn ? HIGH : LOW);
+}
+
+
+// ---------------------------------------------------------------------------------
+//           Define the menus and top level loop, place menus after setup()
+// ---------------------------------------------------------------------------------
+
+//
+// for each menu, create a forward declaration with "extern"
+//
+extern MENU_ITEM mainMenu[];
+
+
+//
+// the main menu
+//
+MENU_ITEM mainMenu[] = {
+  {MENU_ITEM_TYPE_MAIN_MENU_HEADER,  "",                NULL,                       mainMenu},
+  {MENU_ITEM_TYPE_COMMAND,           "Blink LED",       menuCommandBlinkLED,        NULL},
+  {MENU_ITEM_TYPE_COMMAND,           "Settings",        menuCommandSettings,        NULL},
+  {MENU_ITEM_TYPE_END_OF_MENU,       "",                NULL,                       NULL}
+};
+
+
+
+//
+// display the menu, then execute commands selected by the user
+//
+void loop()
+{
+  ui.displayAndExecuteMenu(mainMenu);
+}
+
+
+
+// ---------------------------------------------------------------------------------
+//                            Commands executed from the menu
+// ---------------------------------------------------------------------------------
+
+//
+// menu command to: blink the LED using the blink settings
+//
+void menuCommandBlinkLED(void)
+{
+  byte i;
+
+  for (i = 0; i < config.BlinkCount; i++)
+  {
+    digitalWrite(LED_PIN, config.LEDOn ? LOW : HIGH);
+    delay(config.BlinkTime * 10L);
+    digitalWrite(LED_PIN, config.LEDOn ? HIGH : LOW);
+    delay(config.BlinkTime * 10L);
+  }
+}
+
+
+
+//
+// menu command to: show the settings menu, it returns when Back is pressed
+//
+void menuCommandSettings(void)
+{
+  ui.displayAndExecuteMenu(&mySettingsMenu);
+}
+
+
+
+//
+// called when a setting is changed from the settings menu, the new value is
+// already in the config struct
+//  Enter:  settingNumber = which setting changed (0 = first in the table)
+//          operation = SLIDER_DISPLAY_VALUE_CHANGED while the slider moves,
+//            SLIDER_DISPLAY_VALUE_SET once saved, SLIDER_DISPLAY_CANCELED when
+//            the old value is restored
+//
+void mySettingChanged(int settingNumber, byte operation)
+{
+  ui.lcdSetContrast(config.Contrast);
+  digitalWrite(LED_PIN, config.LEDOn ? HIGH : LOW);
+}
+
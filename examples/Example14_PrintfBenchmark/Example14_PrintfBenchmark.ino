@@ -0,0 +1,241 @@
+//      ******************************************************************
+//      *                                                                *
+//      *          Benchmark formatting numbers with lcdPrintf()         *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// A line of text that mixes labels and numbers is often built with sprintf() 
+// into a buffer, then printed.  On the AVR, sprintf() adds about 1.5K bytes 
+// to the sketch, and printing a value with decimals means using floats and 
+// dtostrf(), which adds more.  lcdPrintf() formats the line as it's drawn: 
+// it needs no buffer, keeps the format string in flash, and prints a fixed 
+// point value (such as tenths of a degree) without any float math.
+//
+// This sketch draws the same line three ways and measures the CPU cycles 
+// for each: sprintf() then lcdPrintString(), dtostrf() then lcdPrintString(), 
+// and lcdPrintf().  The lines are drawn into a frame buffer in RAM so the 
+// time to send the bytes to the LCD isn't counted.  Results are shown on 
+// the LCD and printed to the Serial Monitor.
+//
+// To see how much smaller the sketch is using just lcdPrintf(), set 
+// INCLUDE_SPRINTF_TESTS to 0 and compare the sketch size reported when 
+// compiling.
+//
+// 
+// Documentation for the "Arduino User Interface" library and "Arduino UI Shield"  
+// can be found at:
+//    https://github.com/Stan-Reifel/ArduinoUserInterface
+
+
+
+// ***********************************************************************
+
+#include <ArduinoUserInterface.h>
+
+
+//
+// set to 0 to leave out the sprintf() and dtostrf() tests
+//
+#define INCLUDE_SPRINTF_TESTS 1
+
+
+//
+// assign IO pin numbers for the LCD display and buttons
+//
+#ifdef ARDUINO_AVR_NANO
+  //
+  // use these pin numbers if the display is connected to an Arduino NANO
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = A3;
+  const byte BUTTONS_ANALOG_PIN = A6;
+#else
+  //
+  // use these pin numbers if the display is connected to an Uno or Mega
+  //
+  const byte LCD_CLOCK_PIN = A0;
+  const byte LCD_DATA_IN_PIN = A1;
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = 4;
+  const byte BUTTONS_ANALOG_PIN = A3;
+#endif
+
+
+//
+// the value printed for each measurement, in tenths of a degree, and the 
+// number of times the line is drawn
+//
+int temperatureInTenths = 215;
+const int NUMBER_OF_REPEATS = 50;
+
+
+//
+// create the user interface object, and a frame buffer to draw into
+//
+ArduinoUserInterface ui;
+byte frameBuffer[LCD_FRAME_BUFFER_SIZE];
+
+
+//
+// measured results in CPU cycles per line
+//
+unsigned long sprintfCycles;
+unsigned long dtostrfCycles;
+unsigned long lcdPrintfCycles;
+
+
+// ---------------------------------------------------------------------------------
+//                                 Setup the hardware
+// ---------------------------------------------------------------------------------
+
+void setup() 
+{
+  Serial.begin(9600);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN);
+
+  //
+  // measure drawing into the frame buffer, then stop using it
+  //
+  ui.lcdUseFrameBuffer(frameBuffer);
+#if INCLUDE_SPRINTF_TESTS
+  sprintfCycles = measureCyclesPerLine(drawLineWithSprintf);
+  dtostrfCycles = measureCyclesPerLine(drawLineWithDtostrf);
+#endif
+  lcdPrintfCycles = measureCyclesPerLine(drawLineWithLcdPrintf);
+  ui.lcdUseFrameBuffer(NULL);
+
+#if INCLUDE_SPRINTF_TESTS
+  printResults("sprintf", sprintfCycles);
+  printResults("dtostrf", dtostrfCycles);
+#endif
+  printResults("lcdPrintf", lcdPrintfCycles);
+
+  //
+  // show the results on the LCD
+  //
+  showResults();
+}
+
+
+
+//
+// nothing more to do after the measurements are taken
+//
+void loop() 
+{
+}
+
+
+// ---------------------------------------------------------------------------------
+//                             The lines being measured
+// ---------------------------------------------------------------------------------
+
+#if INCLUDE_SPRINTF_TESTS
+//
+// draw the line by formatting it into a buffer with sprintf()
+//
+void drawLineWithSprintf(void)
+{
+  char line[16];
+
+  sprintf(line, "Temp %3d.%d C", temperatureInTenths / 10, temperatureInTenths % 10);
+  ui.lcdPrintString(line);
+}
+
+
+
+//
+// draw the line by converting the value to a float, then to a string 
+// with dtostrf()
+//
+void drawLineWithDtostrf(void)
+{
+  char number[8];
+
+  dtostrf(temperatureInTenths / 10.0, 5, 1, number);
+  ui.lcdPrintString("Temp ");
+  ui.lcdPrintString(number);
+  ui.lcdPrintString(" C");
+}
+#endif
+
+
+
+//
+// draw the line with lcdPrintf(), no buffer or float math is used
+//
+void drawLineWithLcdPrintf(void)
+{
+  ui.lcdPrintf(F("Temp %5.1d C"), temperatureInTenths);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                              Measure and show results
+// ---------------------------------------------------------------------------------
+
+//
+// draw a line many times, return the average CPU cycles for one line
+//  Enter:  drawLine -> function that draws the line at the cursor
+//
+unsigned long measureCyclesPerLine(void (*drawLine)(void))
+{
+  unsigned long startTime;
+  unsigned long elapsedMicros;
+  int i;
+  
+  startTime = micros();
+  for (i = 0; i < NUMBER_OF_REPEATS; i++)
+  {
+    ui.lcdSetCursorXY(0, 2);
+    drawLine();
+  }
+  elapsedMicros = micros() - startTime;
+
+  return((elapsedMicros * (F_CPU / 1000000L)) / NUMBER_OF_REPEATS);
+}
+
+
+
+//
+// show the results on the LCD
+//
+void showResults(void)
+{
+  ui.lcdClearDisplay();
+
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString("Cycles/line:");
+
+#if INCLUDE_SPRINTF_TESTS
+  ui.lcdSetCursorXY(0, 1);
+  ui.lcdPrintf(F("sprintf %6lu"), sprintfCycles);
+
+  ui.lcdSetCursorXY(0, 2);
+  ui.lcdPrintf(F("dtostrf %6lu"), dtostrfCycles);
+#endif
+
+  ui.lcdSetCursorXY(0, 3);
+  ui.lcdPrintf(F("lcdPrtf %6lu"), lcdPrintfCycles);
+
+  ui.lcdSetCursorXY(0, 5);
+  drawLineWithLcdPrintf();
+}
+
+
+
+//
+// print the results of one measurement to the serial monitor
+//
+void printResults(char *measurementName, unsigned long cyclesPerLine)
+{
+  Serial.print(measurementName);
+  Serial.print(": ");
+  Serial.print(cyclesPerLine);
+  Serial.println(" CPU cycles per line");
+}
+
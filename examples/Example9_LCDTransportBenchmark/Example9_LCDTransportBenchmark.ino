@@ -0,0 +1,213 @@
+
+//      ******************************************************************
+//      *                                                                *
+//      *            Benchmark the transports used by the LCD            *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The library can send bytes to the LCD two ways.  The default "bit bang"  
+// transport works with any digital pins, toggling the clock and data lines  
+// in software.  The "hardware SPI" transport uses the Arduino's SPI hardware  
+// which is much faster, but requires the LCD's CLK and DIN pins be wired to 
+// the board's SCK and MOSI pins (13 & 11 on a Uno or Nano, 52 & 51 on a Mega).
+//
+// This sketch repeatedly clears the display using each transport, then 
+// reports the time per clear and the number of bytes per second sent to the 
+// LCD.  Results are shown on the LCD and printed to the Serial Monitor.
+//
+// Note: The "Arduino UI Shield" wires the LCD to A0 and A1, which are not the  
+// SPI pins.  With the shield, only the bit bang transport can be measured.  
+// If your LCD is wired to the SPI pins, set LCD_WIRED_TO_SPI_PINS to true.
+//
+// 
+// Documentation for the "Arduino User Interface" library and "Arduino UI Shield"  
+// can be found at:
+//    https://github.com/Stan-Reifel/ArduinoUserInterface
+
+
+
+// ***********************************************************************
+
+#include <ArduinoUserInterface.h>
+
+
+//
+// set to true if the LCD's CLK & DIN pins are connected to SCK & MOSI
+//
+const boolean LCD_WIRED_TO_SPI_PINS = false;
+
+
+//
+// assign IO pin numbers for the LCD display and buttons
+//
+#ifdef ARDUINO_AVR_NANO
+  //
+  // use these pin numbers if the display is connected to an Arduino NANO
+  //
+  const byte LCD_CLOCK_PIN = (LCD_WIRED_TO_SPI_PINS ? SCK : A0);
+  const byte LCD_DATA_IN_PIN = (LCD_WIRED_TO_SPI_PINS ? MOSI : A1);
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = A3;
+  const byte BUTTONS_ANALOG_PIN = A6;
+#else
+  //
+  // use these pin numbers if the display is connected to an Uno or Mega
+  //
+  const byte LCD_CLOCK_PIN = (LCD_WIRED_TO_SPI_PINS ? SCK : A0);
+  const byte LCD_DATA_IN_PIN = (LCD_WIRED_TO_SPI_PINS ? MOSI : A1);
+  const byte LCD_DATA_CONTROL_PIN = A2;
+  const byte LCD_CHIP_ENABLE_PIN = 4;
+  const byte BUTTONS_ANALOG_PIN = A3;
+#endif
+
+
+//
+// number of times the display is cleared for each measurement
+//
+const int NUMBER_OF_CLEARS = 20;
+
+
+//
+// bytes sent for each clear: 504 data bytes, the address wraps back to the top 
+// left after the last one so once the LCD's address is known no commands are sent
+//
+const long BYTES_PER_CLEAR = LCD_WIDTH_IN_PIXELS * LCD_HEIGHT_IN_PIXELS / 8;
+
+
+//
+// create the user interface object
+//
+ArduinoUserInterface ui;
+
+
+//
+// measured results in microseconds per clear
+//
+unsigned long bitBangMicrosPerClear;
+unsigned long hardwareSPIMicrosPerClear;
+
+
+// ---------------------------------------------------------------------------------
+//                                 Setup the hardware
+// ---------------------------------------------------------------------------------
+
+void setup() 
+{
+  Serial.begin(9600);
+
+  //
+  // measure the bit bang transport
+  //
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_BIT_BANG);
+  bitBangMicrosPerClear = measureMicrosPerClear();
+  printResults("Bit bang", bitBangMicrosPerClear);
+
+  //
+  // measure the hardware SPI transport
+  //
+  if (LCD_WIRED_TO_SPI_PINS)
+  {
+    ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_HARDWARE_SPI);
+    hardwareSPIMicrosPerClear = measureMicrosPerClear();
+    printResults("Hardware SPI", hardwareSPIMicrosPerClear);
+  }
+
+  //
+  // show the results on the LCD
+  //
+  showResults();
+}
+
+
+
+//
+// nothing more to do after the measurements are taken
+//
+void loop() 
+{
+}
+
+
+// ---------------------------------------------------------------------------------
+//                              Measure and show results
+// ---------------------------------------------------------------------------------
+
+//
+// clear the display many times, return the average time for one clear
+//
+unsigned long measureMicrosPerClear(void)
+{
+  unsigned long startTime;
+  int i;
+  
+  //
+  // clear once before timing, so the cursor commands sent while the LCD's 
+  // address isn't known yet aren't counted
+  //
+  ui.lcdClearDisplay();
+
+  startTime = micros();
+  for (i = 0; i < NUMBER_OF_CLEARS; i++)
+    ui.lcdClearDisplay();
+
+  return((micros() - startTime) / NUMBER_OF_CLEARS);
+}
+
+
+
+//
+// show the results of all transports on the LCD
+//
+void showResults(void)
+{
+  ui.lcdClearDisplay();
+
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString("uS per byte:");
+
+  ui.lcdSetCursorXY(0, 1);
+  ui.lcdPrintString("Bit bang ");
+  printMicrosPerByte(bitBangMicrosPerClear);
+
+  if (LCD_WIRED_TO_SPI_PINS)
+  {
+    ui.lcdSetCursorXY(0, 2);
+    ui.lcdPrintString("SPI      ");
+    printMicrosPerByte(hardwareSPIMicrosPerClear);
+  }
+}
+
+
+
+//
+// print the time to send one byte to the LCD, with one digit right of the decimal point
+//
+void printMicrosPerByte(unsigned long microsPerClear)
+{
+  int tenthsOfMicrosPerByte;
+  
+  tenthsOfMicrosPerByte = (microsPerClear * 10L) / BYTES_PER_CLEAR;
+  ui.lcdPrintInt(tenthsOfMicrosPerByte / 10);
+  ui.lcdPrintCharacter('.');
+  ui.lcdPrintInt(tenthsOfMicrosPerByte % 10);
+}
+
+
+
+//
+// print the results of one transport to the serial monitor
+//
+void printResults(char *transportName, unsigned long microsPerClear)
+{
+  Serial.print(transportName);
+  Serial.print(": ");
+  Serial.print(microsPerClear);
+  Serial.print(" uS per clear, ");
+  Serial.print(BYTES_PER_CLEAR);
+  Serial.print(" bytes per clear, ");
+  Serial.print((BYTES_PER_CLEAR * 1000000L) / microsPerClear);
+  Serial.println(" bytes per second");
+}
+
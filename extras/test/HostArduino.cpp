@@ -0,0 +1,736 @@
+//      ******************************************************************
+//      *                                                                *
+//      *        Host model of the Arduino, its LCD and its EEPROM       *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "HostArduino.h"
+
+
+//
+// number of modeled pins, an Uno's digital pins and A0 - A7
+//
+const byte HOST_NUMBER_OF_PINS = 22;
+const byte HOST_NO_PIN = 0xff;
+
+
+//
+// the modeled hardware
+//
+Pcd8544Model hostLcd;
+HOST_BUS_COUNTS hostBusCounts;
+HardwareSerial Serial;
+SPIClass SPI;
+
+volatile uint8_t SREG = _BV(SREG_I);
+HostADCControlRegister ADCSRA;
+volatile uint8_t ADMUX;
+volatile uint16_t ADC;
+volatile uint8_t OCR0A;
+volatile uint8_t TIMSK0;
+
+static HostPortRegister hostPorts[PD + 1];
+static byte hostPinValues[HOST_NUMBER_OF_PINS];
+static int hostAnalogValues[8];
+static byte hostADCConversionChannel;
+static unsigned long hostMicros;
+
+
+//
+// the pins the LCD is connected to, and the bits being shifted into it
+//
+static byte hostLcdClockPin = HOST_NO_PIN;
+static byte hostLcdDataInPin = HOST_NO_PIN;
+static byte hostLcdDataControlPin = HOST_NO_PIN;
+static byte hostLcdChipEnablePin = HOST_NO_PIN;
+static byte hostLcdShiftRegister;
+static byte hostLcdBitCount;
+
+
+static void hostSetPin(byte pin, byte value);
+static void hostLcdReceiveByte(byte lcdByte);
+
+
+// ---------------------------------------------------------------------------------
+//                             Functions used by the tests
+// ---------------------------------------------------------------------------------
+
+//
+// put all of the modeled hardware in its power on state, the LCD is
+// disconnected from the pins until hostConnectLCD() is called
+//
+void hostReset(void)
+{
+  byte i;
+
+  for (i = 0; i <= PD; i++)
+  {
+    hostPorts[i].portNumber = i;
+    hostPorts[i].value = 0;
+  }
+
+  memset(hostPinValues, LOW, sizeof(hostPinValues));
+  for (i = 0; i < 8; i++)
+    hostAnalogValues[i] = 1023;
+
+  SREG = _BV(SREG_I);
+  ADCSRA.value = 0;
+  hostADCConversionChannel = 0;
+  ADMUX = 0;
+  ADC = 0;
+  OCR0A = 0;
+  TIMSK0 = 0;
+  hostMicros = 0;
+
+  hostLcdClockPin = HOST_NO_PIN;
+  hostLcdDataInPin = HOST_NO_PIN;
+  hostLcdDataControlPin = HOST_NO_PIN;
+  hostLcdChipEnablePin = HOST_NO_PIN;
+  hostLcdBitCount = 0;
+
+  hostLcd.reset();
+  hostClearBusCounts();
+}
+
+
+
+//
+// connect the LCD model to the pins, bits clocked out on them are given to it
+//  Enter:  clockPin, dataInPin, dataControlPin, chipEnablePin = pin numbers,
+//            the same as given to connectToPins()
+//
+void hostConnectLCD(byte clockPin, byte dataInPin, byte dataControlPin, byte chipEnablePin)
+{
+  hostLcdClockPin = clockPin;
+  hostLcdDataInPin = dataInPin;
+  hostLcdDataControlPin = dataControlPin;
+  hostLcdChipEnablePin = chipEnablePin;
+  hostLcdBitCount = 0;
+}
+
+
+
+//
+// the library's transport function when using LCD_TRANSPORT_CALLBACK, give it
+// to lcdSetTransportCallback() so bytes go straight to the LCD model
+//  Enter:  dataOrCommand = HIGH for a data byte, LOW for a command
+//          lcdByte = the byte
+//
+void hostLCDTransport(byte dataOrCommand, byte lcdByte)
+{
+  if (dataOrCommand == HIGH)
+    hostBusCounts.DataBytes++;
+  else
+    hostBusCounts.CommandBytes++;
+
+  hostLcd.writeByte(dataOrCommand, lcdByte);
+}
+
+
+
+//
+// clear the bus counts, so the cost of the next function called can be read
+//
+void hostClearBusCounts(void)
+{
+  memset(&hostBusCounts, 0, sizeof(hostBusCounts));
+}
+
+
+
+//
+// convert estimated CPU cycles to time
+//  Enter:  counts -> bus counts
+//  Exit:   estimated microseconds on a 16 MHz AVR returned
+//
+unsigned long hostEstimatedMicros(const HOST_BUS_COUNTS *counts)
+{
+  return(counts->EstimatedCycles / HOST_CPU_CYCLES_PER_MICROSECOND);
+}
+
+
+
+//
+// get the level of a pin
+//  Enter:  pin = pin number
+//  Exit:   HIGH or LOW returned
+//
+byte hostGetPin(byte pin)
+{
+  if (pin >= HOST_NUMBER_OF_PINS)
+    return(LOW);
+
+  return(hostPinValues[pin]);
+}
+
+
+
+//
+// set the voltage read from an analog pin
+//  Enter:  pin = A0 - A7
+//          value = ADC reading (0 - 1023)
+//
+void hostSetAnalogValue(byte pin, int value)
+{
+  hostAnalogValues[(pin - A0) & 0x07] = value;
+}
+
+
+
+//
+// move the clock forward
+//  Enter:  milliseconds = time to add to the clock
+//
+void hostAdvanceMillis(unsigned long milliseconds)
+{
+  hostMicros += milliseconds * 1000;
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                 The pin model
+// ---------------------------------------------------------------------------------
+
+//
+// change the level of one pin, if the LCD is connected to the pins the bit is
+// shifted into it on the rising edge of the clock while it's selected
+//  Enter:  pin = pin number
+//          value = HIGH or LOW
+//
+static void hostSetPin(byte pin, byte value)
+{
+  if (pin >= HOST_NUMBER_OF_PINS)
+    return;
+
+  if (hostPinValues[pin] == value)
+    return;
+
+  hostPinValues[pin] = value;
+  hostBusCounts.PinToggles++;
+
+  if (pin == hostLcdChipEnablePin)
+  {
+    if (value == LOW)
+      hostBusCounts.ChipSelects++;
+    hostLcdBitCount = 0;
+    return;
+  }
+
+  if ((pin == hostLcdClockPin) && (value == HIGH) && (hostPinValues[hostLcdChipEnablePin] == LOW))
+  {
+    hostLcdShiftRegister = (hostLcdShiftRegister << 1) | hostPinValues[hostLcdDataInPin];
+    hostLcdBitCount++;
+    if (hostLcdBitCount == 8)
+    {
+      hostLcdBitCount = 0;
+      hostLcdReceiveByte(hostLcdShiftRegister);
+    }
+  }
+}
+
+
+
+//
+// give a byte shifted into the LCD to the model, the D/C pin selects data or
+// command
+//  Enter:  lcdByte = the byte
+//
+static void hostLcdReceiveByte(byte lcdByte)
+{
+  hostLCDTransport(hostPinValues[hostLcdDataControlPin], lcdByte);
+}
+
+
+
+//
+// find the pin number of a port's bit
+//  Enter:  port = PB, PC or PD
+//          bitNumber = 0 - 7
+//  Exit:   pin number returned, HOST_NO_PIN if the bit isn't a pin
+//
+static byte hostPortBitToPin(byte port, byte bitNumber)
+{
+  switch(port)
+  {
+    case PD: return(bitNumber);
+    case PB: return(bitNumber < 6 ? 8 + bitNumber : HOST_NO_PIN);
+    case PC: return(bitNumber < 6 ? A0 + bitNumber : HOST_NO_PIN);
+  }
+  return(HOST_NO_PIN);
+}
+
+
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  (void) pin;
+  (void) mode;
+}
+
+
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  HostPortRegister *port;
+
+  hostBusCounts.DigitalWrites++;
+  hostBusCounts.EstimatedCycles += HOST_DIGITAL_WRITE_CYCLES;
+
+  //
+  // keep the port register the same as the pin
+  //
+  port = portOutputRegister(digitalPinToPort(pin));
+  if (port != NULL)
+  {
+    if (value == LOW)
+      port->value &= ~digitalPinToBitMask(pin);
+    else
+      port->value |= digitalPinToBitMask(pin);
+  }
+
+  hostSetPin(pin, value == LOW ? LOW : HIGH);
+}
+
+
+
+int analogRead(uint8_t pin)
+{
+  hostBusCounts.AnalogReads++;
+  hostBusCounts.EstimatedCycles += HOST_ANALOG_READ_CYCLES;
+
+  //
+  // select the channel, start a conversion and wait for it, the same as the 
+  // Arduino core.  If a conversion was already running this gets its result
+  //
+  if (pin >= A0)
+    pin -= A0;
+  ADMUX = 0x40 | (pin & 0x07);
+  ADCSRA |= _BV(ADSC);
+  while (ADCSRA & _BV(ADSC))
+    ;
+  return(ADC);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                             The AVR register models
+// ---------------------------------------------------------------------------------
+
+void cli(void)
+{
+  hostBusCounts.InterruptGuards++;
+  hostBusCounts.EstimatedCycles += HOST_INTERRUPT_GUARD_CYCLES;
+  SREG &= ~_BV(SREG_I);
+}
+
+
+
+void sei(void)
+{
+  SREG |= _BV(SREG_I);
+}
+
+
+
+uint8_t digitalPinToPort(uint8_t pin)
+{
+  if (pin < 8)
+    return(PD);
+  if (pin < 14)
+    return(PB);
+  if (pin < 20)
+    return(PC);
+  return(0);
+}
+
+
+
+uint8_t digitalPinToBitMask(uint8_t pin)
+{
+  if (pin < 8)
+    return(_BV(pin));
+  if (pin < 14)
+    return(_BV(pin - 8));
+  if (pin < 20)
+    return(_BV(pin - A0));
+  return(0);
+}
+
+
+
+HostPortRegister *portOutputRegister(uint8_t port)
+{
+  if ((port < PB) || (port > PD))
+    return(NULL);
+
+  return(&hostPorts[port]);
+}
+
+
+
+HostPortRegister::HostPortRegister(void)
+{
+  portNumber = 0;
+  value = 0;
+}
+
+
+
+//
+// write the port, each pin that changes is given to the pin model.  Setting or
+// clearing bits through a pointer is a read-modify-write on the AVR, so it's
+// counted as unprotected if interrupts are enabled.
+//
+HostPortRegister &HostPortRegister::operator=(uint8_t newValue)
+{
+  uint8_t changedBits;
+  byte bitNumber;
+
+  hostBusCounts.PortWrites++;
+  hostBusCounts.EstimatedCycles += HOST_PORT_WRITE_CYCLES;
+  if (SREG & _BV(SREG_I))
+    hostBusCounts.UnprotectedPortWrites++;
+
+  changedBits = value ^ newValue;
+  value = newValue;
+  for (bitNumber = 0; bitNumber < 8; bitNumber++)
+  {
+    if (changedBits & _BV(bitNumber))
+      hostSetPin(hostPortBitToPin(portNumber, bitNumber), (newValue & _BV(bitNumber)) ? HIGH : LOW);
+  }
+  return(*this);
+}
+
+
+
+HostPortRegister &HostPortRegister::operator|=(uint8_t bits)
+{
+  return(*this = value | bits);
+}
+
+
+
+HostPortRegister &HostPortRegister::operator&=(uint8_t bits)
+{
+  return(*this = value & bits);
+}
+
+
+
+HostPortRegister::operator uint8_t() const
+{
+  return(value);
+}
+
+
+
+//
+// write the ADC control register, writing a 1 to ADIF clears it, and setting
+// ADSC starts converting the channel selected then.  As on the AVR, changing 
+// ADMUX or setting ADSC again while a conversion is running has no effect on 
+// it.  The conversion finishes the next time the register is read
+//
+HostADCControlRegister &HostADCControlRegister::operator=(uint8_t newValue)
+{
+  uint8_t conversionCompleteFlag;
+  uint8_t conversionRunningFlag;
+
+  conversionCompleteFlag = value & _BV(ADIF);
+  if (newValue & _BV(ADIF))
+    conversionCompleteFlag = 0;
+
+  conversionRunningFlag = value & _BV(ADSC);
+  value = (newValue & ~_BV(ADIF)) | conversionCompleteFlag | conversionRunningFlag;
+
+  if ((value & _BV(ADSC)) && !conversionRunningFlag)
+    hostADCConversionChannel = ADMUX & 0x07;
+  return(*this);
+}
+
+
+
+//
+// finish the conversion that's running, if any
+//
+void HostADCControlRegister::finishConversion(void)
+{
+  if (value & _BV(ADSC))
+  {
+    ADC = hostAnalogValues[hostADCConversionChannel];
+    value = (value & ~_BV(ADSC)) | _BV(ADIF);
+  }
+}
+
+
+
+HostADCControlRegister &HostADCControlRegister::operator|=(uint8_t bits)
+{
+  return(*this = value | bits);
+}
+
+
+
+HostADCControlRegister &HostADCControlRegister::operator&=(uint8_t bits)
+{
+  return(*this = value & bits);
+}
+
+
+
+//
+// read the ADC control register, a conversion is taken to have finished by 
+// the time it's read, as the application has done other work since starting it
+//
+HostADCControlRegister::operator uint8_t()
+{
+  finishConversion();
+  return(value);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                   The SPI model
+// ---------------------------------------------------------------------------------
+
+void SPIClass::begin(void)
+{
+}
+
+
+
+void SPIClass::end(void)
+{
+}
+
+
+
+void SPIClass::beginTransaction(SPISettings settings)
+{
+  (void) settings;
+}
+
+
+
+void SPIClass::endTransaction(void)
+{
+}
+
+
+
+//
+// send a byte on the SPI pins, the LCD receives it if it's selected
+//
+uint8_t SPIClass::transfer(uint8_t data)
+{
+  hostBusCounts.SPITransfers++;
+  hostBusCounts.EstimatedCycles += HOST_SPI_BYTE_CYCLES;
+
+  if ((hostLcdChipEnablePin != HOST_NO_PIN) && (hostPinValues[hostLcdChipEnablePin] == LOW))
+    hostLcdReceiveByte(data);
+
+  return(0);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                               Time and conversions
+// ---------------------------------------------------------------------------------
+
+unsigned long millis(void)
+{
+  return(hostMicros / 1000);
+}
+
+
+
+unsigned long micros(void)
+{
+  return(hostMicros);
+}
+
+
+
+void delay(unsigned long ms)
+{
+  hostAdvanceMillis(ms);
+}
+
+
+
+char *itoa(int value, char *s, int radix)
+{
+  return(ltoa(value, s, radix));
+}
+
+
+
+char *ltoa(long value, char *s, int radix)
+{
+  if ((radix == 10) && (value < 0))
+  {
+    s[0] = '-';
+    ultoa(-(unsigned long) value, s + 1, radix);
+    return(s);
+  }
+  return(ultoa((unsigned long) value, s, radix));
+}
+
+
+
+char *ultoa(unsigned long value, char *s, int radix)
+{
+  char digits[34];
+  int count;
+  int i;
+
+  count = 0;
+  do
+  {
+    digits[count++] = "0123456789abcdefghijklmnopqrstuvwxyz"[value % radix];
+    value /= radix;
+  } while (value != 0);
+
+  for (i = 0; i < count; i++)
+    s[i] = digits[count - 1 - i];
+  s[count] = 0;
+  return(s);
+}
+
+
+
+char *dtostrf(double value, signed char width, unsigned char precision, char *s)
+{
+  sprintf(s, "%*.*f", width, precision, value);
+  return(s);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                  Serial output
+// ---------------------------------------------------------------------------------
+
+size_t Print::print(const char *s)
+{
+  size_t count = 0;
+
+  while (*s)
+    count += write(*s++);
+  return(count);
+}
+
+
+
+size_t Print::print(const __FlashStringHelper *s)
+{
+  return(print((const char *) s));
+}
+
+
+
+size_t Print::print(char c)
+{
+  return(write(c));
+}
+
+
+
+size_t Print::print(int n)
+{
+  return(print((long) n));
+}
+
+
+
+size_t Print::print(unsigned int n)
+{
+  return(print((unsigned long) n));
+}
+
+
+
+size_t Print::print(long n)
+{
+  char s[24];
+
+  ltoa(n, s, 10);
+  return(print(s));
+}
+
+
+
+size_t Print::print(unsigned long n)
+{
+  char s[24];
+
+  ultoa(n, s, 10);
+  return(print(s));
+}
+
+
+
+size_t Print::println(void)
+{
+  return(write('\n'));
+}
+
+
+
+size_t Print::println(const char *s)
+{
+  return(print(s) + println());
+}
+
+
+
+size_t Print::println(const __FlashStringHelper *s)
+{
+  return(print(s) + println());
+}
+
+
+
+size_t Print::println(int n)
+{
+  return(print(n) + println());
+}
+
+
+
+size_t Print::println(unsigned int n)
+{
+  return(print(n) + println());
+}
+
+
+
+size_t Print::println(long n)
+{
+  return(print(n) + println());
+}
+
+
+
+size_t Print::println(unsigned long n)
+{
+  return(print(n) + println());
+}
+
+
+
+void HardwareSerial::begin(long baudRate)
+{
+  (void) baudRate;
+}
+
+
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  putchar(c);
+  return(1);
+}
@@ -0,0 +1,77 @@
+//      ******************************************************************
+//      *                                                                *
+//      *        Host model of the Arduino, its LCD and its EEPROM       *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The pins of an Uno are modeled, written either with digitalWrite() or
+// through the port registers.  When the LCD's pins are given with
+// hostConnectLCD(), the bits clocked out on them are shifted into bytes and
+// given to the PCD8544 model, the same as the hardware SPI transfers.  For
+// tests that don't need the pins, lcdSetTransportCallback(hostLCDTransport)
+// gives the library's bytes straight to the model.
+//
+// Everything that crosses the bus is counted in hostBusCounts, along with an
+// estimate of the CPU cycles it would take on a 16 MHz AVR.  Clear the counts,
+// call a library function, then read the counts to find its wire cost.
+
+
+#ifndef HostArduino_h
+#define HostArduino_h
+
+#include <Arduino.h>
+#include "Pcd8544Model.h"
+
+
+//
+// estimated CPU cycles on a 16 MHz AVR for each thing counted on the bus
+//
+const unsigned int HOST_DIGITAL_WRITE_CYCLES = 50;     // pin table lookups, timer check, RMW
+const unsigned int HOST_PORT_WRITE_CYCLES = 5;         // LD, OR/AND, ST through a pointer
+const unsigned int HOST_INTERRUPT_GUARD_CYCLES = 3;    // IN SREG, CLI, OUT SREG
+const unsigned int HOST_SPI_BYTE_CYCLES = 36;          // 8 bits at 4 MHz, then polling SPIF
+const unsigned int HOST_ANALOG_READ_CYCLES = 1780;     // 13 ADC clocks with a prescaler of 128
+const unsigned long HOST_CPU_CYCLES_PER_MICROSECOND = 16;
+
+
+//
+// what has crossed the bus since the counts were cleared
+//
+typedef struct _HOST_BUS_COUNTS
+{
+  long PinToggles;
+  long DigitalWrites;
+  long PortWrites;
+  long UnprotectedPortWrites;
+  long InterruptGuards;
+  long ChipSelects;
+  long CommandBytes;
+  long DataBytes;
+  long SPITransfers;
+  long AnalogReads;
+  unsigned long EstimatedCycles;
+} HOST_BUS_COUNTS;
+
+
+//
+// the modeled hardware
+//
+extern Pcd8544Model hostLcd;
+extern HOST_BUS_COUNTS hostBusCounts;
+
+
+//
+// functions used by the tests
+//
+void hostReset(void);
+void hostConnectLCD(byte clockPin, byte dataInPin, byte dataControlPin, byte chipEnablePin);
+void hostLCDTransport(byte dataOrCommand, byte lcdByte);
+void hostClearBusCounts(void);
+unsigned long hostEstimatedMicros(const HOST_BUS_COUNTS *counts);
+byte hostGetPin(byte pin);
+void hostSetAnalogValue(byte pin, int value);
+void hostAdvanceMillis(unsigned long milliseconds);
+
+#endif
@@ -0,0 +1,132 @@
+//      ******************************************************************
+//      *                                                                *
+//      *                   Host model of the EEPROM                     *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+
+#include <EEPROM.h>
+#include "HostEEPROM.h"
+
+
+HOST_EEPROM hostEEPROM;
+EEPROMClass EEPROM;
+
+
+// ---------------------------------------------------------------------------------
+//                             Functions used by the tests
+// ---------------------------------------------------------------------------------
+
+//
+// erase every cell to 0xff, the same as a new part, and clear the counts
+//
+void hostEEPROMErase(void)
+{
+  memset(hostEEPROM.Cells, 0xff, sizeof(hostEEPROM.Cells));
+  hostEEPROMClearCounts();
+  hostEEPROMRestorePower();
+}
+
+
+
+//
+// lose power after some more writes, the writes after that are dropped
+//  Enter:  numberOfWrites = writes that still complete
+//
+void hostEEPROMFailPowerAfter(long numberOfWrites)
+{
+  hostEEPROM.WritesUntilPowerFails = numberOfWrites;
+  hostEEPROM.PowerFailedFlag = false;
+}
+
+
+
+//
+// power up again, writes are no longer dropped
+//
+void hostEEPROMRestorePower(void)
+{
+  hostEEPROM.WritesUntilPowerFails = -1;
+  hostEEPROM.PowerFailedFlag = false;
+}
+
+
+
+//
+// clear the read and write counts, the cells are unchanged
+//
+void hostEEPROMClearCounts(void)
+{
+  memset(hostEEPROM.CellWriteCount, 0, sizeof(hostEEPROM.CellWriteCount));
+  hostEEPROM.WriteCount = 0;
+  hostEEPROM.ReadCount = 0;
+}
+
+
+
+//
+// find the wear of the most written cell in a range
+//  Enter:  firstAddress = address of the first cell
+//          numberOfCells = number of cells to check
+//  Exit:   number of writes to the most written cell returned
+//
+unsigned long hostEEPROMMostCellWrites(int firstAddress, int numberOfCells)
+{
+  unsigned long mostWrites;
+  int address;
+
+  mostWrites = 0;
+  for (address = firstAddress; address < firstAddress + numberOfCells; address++)
+  {
+    if (hostEEPROM.CellWriteCount[address] > mostWrites)
+      mostWrites = hostEEPROM.CellWriteCount[address];
+  }
+  return(mostWrites);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                              The EEPROM library model
+// ---------------------------------------------------------------------------------
+
+uint8_t EEPROMClass::read(int address)
+{
+  hostEEPROM.ReadCount++;
+  return(hostEEPROM.Cells[address % HOST_EEPROM_SIZE]);
+}
+
+
+
+void EEPROMClass::write(int address, uint8_t value)
+{
+  if (hostEEPROM.WritesUntilPowerFails == 0)
+  {
+    hostEEPROM.PowerFailedFlag = true;
+    return;
+  }
+
+  if (hostEEPROM.WritesUntilPowerFails > 0)
+    hostEEPROM.WritesUntilPowerFails--;
+
+  address = address % HOST_EEPROM_SIZE;
+  hostEEPROM.Cells[address] = value;
+  hostEEPROM.CellWriteCount[address]++;
+  hostEEPROM.WriteCount++;
+}
+
+
+
+void EEPROMClass::update(int address, uint8_t value)
+{
+  if (read(address) != value)
+    write(address, value);
+}
+
+
+
+uint16_t EEPROMClass::length(void)
+{
+  return(HOST_EEPROM_SIZE);
+}
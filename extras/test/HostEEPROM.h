@@ -0,0 +1,49 @@
+//      ******************************************************************
+//      *                                                                *
+//      *                   Host model of the EEPROM                     *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The model counts the writes to each cell so the wear caused by the library 
+// can be measured.  It can also lose power after a given number of writes, 
+// every write after that is dropped, to test what's read back after a save 
+// is cut short.
+
+
+#ifndef HostEEPROM_h
+#define HostEEPROM_h
+
+#include <Arduino.h>
+
+
+//
+// size of the EEPROM in an ATmega328
+//
+const int HOST_EEPROM_SIZE = 1024;
+
+
+//
+// the cells and how many times each has been written
+//
+typedef struct _HOST_EEPROM
+{
+  byte Cells[HOST_EEPROM_SIZE];
+  unsigned long CellWriteCount[HOST_EEPROM_SIZE];
+  unsigned long WriteCount;
+  unsigned long ReadCount;
+  long WritesUntilPowerFails;
+  boolean PowerFailedFlag;
+} HOST_EEPROM;
+
+extern HOST_EEPROM hostEEPROM;
+
+
+void hostEEPROMErase(void);
+void hostEEPROMFailPowerAfter(long numberOfWrites);
+void hostEEPROMRestorePower(void);
+void hostEEPROMClearCounts(void);
+unsigned long hostEEPROMMostCellWrites(int firstAddress, int numberOfCells);
+
+#endif
@@ -0,0 +1,55 @@
+//      ******************************************************************
+//      *                                                                *
+//      *                 Checks used by the host tests                  *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Each test is a program that checks its results with CHECK(), then returns 
+// hostTestResult() from main() so CTest sees whether it passed.
+
+
+#ifndef HostTest_h
+#define HostTest_h
+
+#include <stdio.h>
+
+
+//
+// number of checks that failed
+//
+static int hostTestFailures = 0;
+
+
+//
+// report a check that failed, with where it is
+//
+#define CHECK(condition)                                                       \
+  do                                                                           \
+  {                                                                            \
+    if (!(condition))                                                          \
+    {                                                                          \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);     \
+      hostTestFailures++;                                                      \
+    }                                                                          \
+  } while (0)
+
+
+//
+// print the result of the test
+//  Exit:   value for main() to return, 0 if every check passed
+//
+static inline int hostTestResult(void)
+{
+  if (hostTestFailures == 0)
+  {
+    printf("passed\n");
+    return(0);
+  }
+
+  printf("%d checks failed\n", hostTestFailures);
+  return(1);
+}
+
+#endif
@@ -0,0 +1,241 @@
+//      ******************************************************************
+//      *                                                                *
+//      *              Model of the PCD8544 LCD controller               *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+
+#include "Pcd8544Model.h"
+
+
+// ---------------------------------------------------------------------------------
+//                                  Public functions
+// ---------------------------------------------------------------------------------
+
+//
+// put the controller in its power on state and clear the counts, the RAM is
+// filled with a pattern so pixels that are never written can be seen
+//
+void Pcd8544Model::reset(void)
+{
+  memset(ram, 0xa5, sizeof(ram));
+  addressX = 0;
+  addressY = 0;
+  powerDownFlag = true;
+  verticalAddressingFlag = false;
+  extendedInstructionsFlag = false;
+  displayMode = 0;
+  operatingVoltage = 0;
+  biasSystem = 0;
+  temperatureCoefficient = 0;
+
+  commandCount = 0;
+  dataByteCount = 0;
+  addressCommandCount = 0;
+  redundantAddressCommandCount = 0;
+  undefinedCommandCount = 0;
+}
+
+
+
+//
+// give one byte to the controller
+//  Enter:  dataOrCommand = HIGH for a data byte, LOW for a command (the level
+//            of the D/C pin)
+//          lcdByte = the byte
+//
+void Pcd8544Model::writeByte(byte dataOrCommand, byte lcdByte)
+{
+  if (dataOrCommand == HIGH)
+    writeData(lcdByte);
+  else
+    writeCommand(lcdByte);
+}
+
+
+
+//
+// get one pixel from the display RAM
+//  Enter:  X = pixel column (0 - 83)
+//          Y = pixel row (0 - 47)
+//  Exit:   true returned if the pixel is black
+//
+boolean Pcd8544Model::getPixel(int X, int Y)
+{
+  return((ram[Y >> 3][X] & (1 << (Y & 0x07))) != 0);
+}
+
+
+
+//
+// compare the display RAM with a frame buffer drawn by the library
+//  Enter:  frameBuffer -> LCD_FRAME_BUFFER_SIZE bytes, one line after another
+//  Exit:   true returned if every pixel is the same
+//
+boolean Pcd8544Model::samePixelsAs(const byte *frameBuffer)
+{
+  return(memcmp(ram, frameBuffer, sizeof(ram)) == 0);
+}
+
+
+
+//
+// write the display RAM as a plain PBM image, the same format as
+// lcdWriteFrameBufferAsPBM()
+//  Enter:  file = file to write to
+//
+void Pcd8544Model::writePBM(FILE *file)
+{
+  int X;
+  int Y;
+
+  fprintf(file, "P1\n%d %d\n", PCD8544_WIDTH_IN_PIXELS, PCD8544_HEIGHT_IN_PIXELS);
+  for (Y = 0; Y < PCD8544_HEIGHT_IN_PIXELS; Y++)
+  {
+    for (X = 0; X < PCD8544_WIDTH_IN_PIXELS; X++)
+      fputc(getPixel(X, Y) ? '1' : '0', file);
+    fputc('\n', file);
+  }
+}
+
+
+
+//
+// save the display RAM as a PBM image file
+//  Enter:  fileName -> name of the file to create
+//  Exit:   true returned on success
+//
+boolean Pcd8544Model::savePBM(const char *fileName)
+{
+  FILE *file;
+
+  file = fopen(fileName, "w");
+  if (file == NULL)
+    return(false);
+
+  writePBM(file);
+  fclose(file);
+  return(true);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                 Private functions
+// ---------------------------------------------------------------------------------
+
+//
+// execute a command, the basic and extended instruction sets share opcodes so
+// the H bit from the last function set selects between them
+//  Enter:  command = the command byte
+//
+void Pcd8544Model::writeCommand(byte command)
+{
+  commandCount++;
+
+  //
+  // commands in both instruction sets
+  //
+  if (command == 0x00)                            // NOP
+    return;
+
+  if ((command & 0xf8) == 0x20)                   // function set
+  {
+    powerDownFlag = (command & 0x04) != 0;
+    verticalAddressingFlag = (command & 0x02) != 0;
+    extendedInstructionsFlag = (command & 0x01) != 0;
+    return;
+  }
+
+  //
+  // extended instruction set
+  //
+  if (extendedInstructionsFlag)
+  {
+    if (command & 0x80)                           // set Vop
+      operatingVoltage = command & 0x7f;
+    else if ((command & 0xf8) == 0x10)            // bias system
+      biasSystem = command & 0x07;
+    else if ((command & 0xfc) == 0x04)            // temperature control
+      temperatureCoefficient = command & 0x03;
+    else
+      undefinedCommandCount++;
+    return;
+  }
+
+  //
+  // basic instruction set, addresses beyond the RAM aren't defined by the
+  // datasheet, the model leaves the address counter unchanged
+  //
+  if (command & 0x80)                             // set X address
+  {
+    addressCommandCount++;
+    if ((command & 0x7f) >= PCD8544_WIDTH_IN_PIXELS)
+    {
+      undefinedCommandCount++;
+      return;
+    }
+    if ((command & 0x7f) == addressX)
+      redundantAddressCommandCount++;
+    addressX = command & 0x7f;
+    return;
+  }
+
+  if ((command & 0xf8) == 0x40)                   // set Y address
+  {
+    addressCommandCount++;
+    if ((command & 0x07) >= PCD8544_HEIGHT_IN_BANKS)
+    {
+      undefinedCommandCount++;
+      return;
+    }
+    if ((command & 0x07) == addressY)
+      redundantAddressCommandCount++;
+    addressY = command & 0x07;
+    return;
+  }
+
+  if ((command & 0xfa) == 0x08)                   // display control
+  {
+    displayMode = command & 0x05;
+    return;
+  }
+
+  undefinedCommandCount++;
+}
+
+
+
+//
+// write a data byte at the address counter, then advance the counter
+//  Enter:  data = the byte, a column of 8 pixels with the LSB at the top
+//
+void Pcd8544Model::writeData(byte data)
+{
+  dataByteCount++;
+  ram[addressY][addressX] = data;
+
+  if (verticalAddressingFlag)
+  {
+    addressY++;
+    if (addressY >= PCD8544_HEIGHT_IN_BANKS)
+    {
+      addressY = 0;
+      addressX++;
+      if (addressX >= PCD8544_WIDTH_IN_PIXELS)
+        addressX = 0;
+    }
+  }
+  else
+  {
+    addressX++;
+    if (addressX >= PCD8544_WIDTH_IN_PIXELS)
+    {
+      addressX = 0;
+      addressY++;
+      if (addressY >= PCD8544_HEIGHT_IN_BANKS)
+        addressY = 0;
+    }
+  }
+}
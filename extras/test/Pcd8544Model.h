@@ -0,0 +1,69 @@
+//      ******************************************************************
+//      *                                                                *
+//      *              Model of the PCD8544 LCD controller               *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The model interprets the same command and data bytes as the Nokia 5110's 
+// PCD8544: the function set, display control, X & Y address, and the 
+// extended commands (Vop, bias and temperature coefficient).  Data bytes are 
+// written to the 84 x 48 pixel RAM at the address counter, which advances the 
+// same way the controller's does, horizontally or vertically, wrapping at the 
+// last column and from the last bank back to the first.
+
+
+#ifndef Pcd8544Model_h
+#define Pcd8544Model_h
+
+#include <Arduino.h>
+
+
+//
+// size of the controller's display RAM
+//
+const byte PCD8544_WIDTH_IN_PIXELS = 84;
+const byte PCD8544_HEIGHT_IN_BANKS = 6;
+const byte PCD8544_HEIGHT_IN_PIXELS = 48;
+
+
+class Pcd8544Model
+{
+  public:
+    void reset(void);
+    void writeByte(byte dataOrCommand, byte lcdByte);
+    boolean getPixel(int X, int Y);
+    boolean samePixelsAs(const byte *frameBuffer);
+    void writePBM(FILE *file);
+    boolean savePBM(const char *fileName);
+
+    //
+    // the controller's registers
+    //
+    byte ram[PCD8544_HEIGHT_IN_BANKS][PCD8544_WIDTH_IN_PIXELS];
+    byte addressX;
+    byte addressY;
+    boolean powerDownFlag;
+    boolean verticalAddressingFlag;
+    boolean extendedInstructionsFlag;
+    byte displayMode;
+    byte operatingVoltage;
+    byte biasSystem;
+    byte temperatureCoefficient;
+
+    //
+    // what has been sent to the controller
+    //
+    long commandCount;
+    long dataByteCount;
+    long addressCommandCount;
+    long redundantAddressCommandCount;
+    long undefinedCommandCount;
+
+  private:
+    void writeCommand(byte command);
+    void writeData(byte data);
+};
+
+#endif
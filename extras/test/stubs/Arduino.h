@@ -0,0 +1,210 @@
+//      ******************************************************************
+//      *                                                                *
+//      *        Host model of the parts of the Arduino core used        *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// This replaces Arduino.h when the library is built on a PC for testing.  
+// Pins, port registers, the ADC and the clock are modeled by HostArduino.cpp.  
+// The AVR registers are always declared, they are only used when the library 
+// is built with __AVR__ defined to test its port register code.
+
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+
+//
+// pin values and modes
+//
+const uint8_t LOW = 0;
+const uint8_t HIGH = 1;
+const uint8_t INPUT = 0;
+const uint8_t OUTPUT = 1;
+
+
+//
+// analog pin numbers and the SPI pins of an Uno
+//
+const uint8_t A0 = 14;
+const uint8_t A1 = 15;
+const uint8_t A2 = 16;
+const uint8_t A3 = 17;
+const uint8_t A4 = 18;
+const uint8_t A5 = 19;
+const uint8_t A6 = 20;
+const uint8_t A7 = 21;
+const uint8_t MOSI = 11;
+const uint8_t SCK = 13;
+
+#define F_CPU 16000000L
+
+
+//
+// strings in flash are ordinary strings on the host
+//
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+#define PSTR(s) (s)
+
+
+//
+// digital and analog IO
+//
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+
+
+//
+// time, the clock only moves when a test advances it
+//
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+
+
+//
+// number to string conversions from the AVR C library
+//
+char *itoa(int value, char *s, int radix);
+char *ltoa(long value, char *s, int radix);
+char *ultoa(unsigned long value, char *s, int radix);
+char *dtostrf(double value, signed char width, unsigned char precision, char *s);
+
+
+// ---------------------------------------------------------------------------------
+//                             AVR register models
+// ---------------------------------------------------------------------------------
+
+//
+// the status register, only the global interrupt enable bit is modeled
+//
+extern volatile uint8_t SREG;
+const uint8_t SREG_I = 7;
+
+void cli(void);
+void sei(void);
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+
+//
+// an output port register, each write is counted and the pins it changes are 
+// passed to the pin model
+//
+class HostPortRegister
+{
+  public:
+    HostPortRegister(void);
+    HostPortRegister &operator=(uint8_t newValue);
+    HostPortRegister &operator|=(uint8_t bits);
+    HostPortRegister &operator&=(uint8_t bits);
+    operator uint8_t() const;
+
+    uint8_t portNumber;
+    uint8_t value;
+};
+
+#define ARDUINO_USER_INTERFACE_PORT_REGISTER HostPortRegister
+
+const uint8_t PB = 2;
+const uint8_t PC = 3;
+const uint8_t PD = 4;
+
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+HostPortRegister *portOutputRegister(uint8_t port);
+
+
+//
+// the ADC control register, setting ADSC starts a conversion of the channel 
+// selected then, which finishes when the register is next read
+//
+class HostADCControlRegister
+{
+  public:
+    HostADCControlRegister &operator=(uint8_t newValue);
+    HostADCControlRegister &operator|=(uint8_t bits);
+    HostADCControlRegister &operator&=(uint8_t bits);
+    operator uint8_t();
+    void finishConversion(void);
+
+    uint8_t value;
+};
+
+extern HostADCControlRegister ADCSRA;
+extern volatile uint8_t ADMUX;
+extern volatile uint16_t ADC;
+
+const uint8_t ADEN = 7;
+const uint8_t ADSC = 6;
+const uint8_t ADIF = 4;
+
+
+//
+// timer 0, used by the Arduino core for millis()
+//
+extern volatile uint8_t OCR0A;
+extern volatile uint8_t TIMSK0;
+const uint8_t OCIE0A = 1;
+
+#define _BV(bitNumber) (1 << (bitNumber))
+#define bit_is_set(sfr, bitNumber) ((sfr) & _BV(bitNumber))
+#define bit_is_clear(sfr, bitNumber) (!((sfr) & _BV(bitNumber)))
+
+
+// ---------------------------------------------------------------------------------
+//                                  Serial output
+// ---------------------------------------------------------------------------------
+
+//
+// a stream that text is printed to
+//
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+
+    size_t print(const char *s);
+    size_t print(const __FlashStringHelper *s);
+    size_t print(char c);
+    size_t print(int n);
+    size_t print(unsigned int n);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t println(void);
+    size_t println(const char *s);
+    size_t println(const __FlashStringHelper *s);
+    size_t println(int n);
+    size_t println(unsigned int n);
+    size_t println(long n);
+    size_t println(unsigned long n);
+};
+
+
+//
+// the serial port writes to stdout
+//
+class HardwareSerial : public Print
+{
+  public:
+    void begin(long baudRate);
+    size_t write(uint8_t c);
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,23 @@
+//
+// host model of the EEPROM library, backed by the EEPROM model in 
+// HostEEPROM.h that counts the writes to each cell
+//
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <Arduino.h>
+
+
+class EEPROMClass
+{
+  public:
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value);
+    uint16_t length(void);
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
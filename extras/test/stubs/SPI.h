@@ -0,0 +1,36 @@
+//
+// host model of the SPI library, bytes transferred while the LCD is selected 
+// are given to the PCD8544 model
+//
+
+#ifndef SPI_h
+#define SPI_h
+
+#include <Arduino.h>
+
+const uint8_t MSBFIRST = 1;
+const uint8_t SPI_MODE0 = 0;
+
+
+class SPISettings
+{
+  public:
+    SPISettings(void) {}
+    SPISettings(uint32_t clockRate, uint8_t bitOrder, uint8_t dataMode) 
+      {(void) clockRate; (void) bitOrder; (void) dataMode;}
+};
+
+
+class SPIClass
+{
+  public:
+    void begin(void);
+    void end(void);
+    void beginTransaction(SPISettings settings);
+    void endTransaction(void);
+    uint8_t transfer(uint8_t data);
+};
+
+extern SPIClass SPI;
+
+#endif
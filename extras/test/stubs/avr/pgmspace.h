@@ -0,0 +1,34 @@
+//
+// host model of avr/pgmspace.h, program memory is ordinary memory on the host
+//
+
+#ifndef pgmspace_h
+#define pgmspace_h
+
+#include <string.h>
+#include <stdint.h>
+
+#define PROGMEM
+
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) hostPgmReadWord(address)
+#define pgm_read_dword(address) (*(const unsigned long *)(address))
+#define pgm_read_ptr(address) (*(void * const *)(address))
+
+//
+// a word is read with memcpy() since the host's unsigned int is 4 bytes, 
+// reading its low 2 bytes through a uint16_t pointer breaks strict aliasing
+//
+static inline uint16_t hostPgmReadWord(const void *address)
+{
+  uint16_t value;
+
+  memcpy(&value, address, sizeof(value));
+  return(value);
+}
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+
+#endif
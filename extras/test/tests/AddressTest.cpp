@@ -0,0 +1,186 @@
+//      ******************************************************************
+//      *                                                                *
+//      *      Test the library's copy of the LCD's address counter      *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The library skips the X and Y address commands when the LCD's address
+// counter is already where the cursor is being moved.  Its copy of the counter
+// must wrap like the controller's, from the last column to the next bank and
+// from the last bank to the first, and must be forgotten after any other
+// command.  The PCD8544 model counts address commands that don't change the
+// address, there should be none.
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to, only the callback transport is used
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+
+
+// ---------------------------------------------------------------------------------
+//                                    The tests
+// ---------------------------------------------------------------------------------
+
+//
+// draw a screen that moves the cursor around
+//  Enter:  ui = user interface to draw with
+//
+void drawScreen(ArduinoUserInterface &ui)
+{
+  ui.lcdClearDisplay();
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString((char *) "Address");
+  ui.lcdSetCursorXY(42, 0);
+  ui.lcdPrintString((char *) "test");
+  ui.lcdDrawRowOfPixels(0, 83, 1, 0x81);
+  ui.lcdSetCursorXY(0, 2);
+  ui.lcdPrintStringReverse((char *) "Next line");
+  ui.lcdDrawRowOfPixels(20, 83, 5, 0x3c);
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString((char *) "A");
+  ui.drawButtonBar((char *) "Set", (char *) "Back");
+}
+
+
+
+//
+// check the screen is the same as drawing it in a frame buffer, and no address
+// command was sent that the LCD didn't need
+//
+void testNoRedundantCommands(void)
+{
+  byte frameBuffer[LCD_FRAME_BUFFER_SIZE];
+  long redundantBefore;
+
+  hostReset();
+  ArduinoUserInterface frameBufferUI;
+  frameBufferUI.lcdSetTransportCallback(hostLCDTransport);
+  frameBufferUI.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+  frameBufferUI.lcdUseFrameBuffer(frameBuffer);
+  drawScreen(frameBufferUI);
+
+  hostReset();
+  ArduinoUserInterface ui;
+  ui.lcdSetTransportCallback(hostLCDTransport);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+
+  //
+  // the address isn't known until the cursor is first set, so both commands 
+  // are sent then even if the LCD is already there
+  //
+  ui.lcdSetCursorXY(0, 0);
+  redundantBefore = hostLcd.redundantAddressCommandCount;
+  drawScreen(ui);
+
+  CHECK(hostLcd.samePixelsAs(frameBuffer));
+  CHECK(hostLcd.redundantAddressCommandCount == redundantBefore);
+  CHECK(hostLcd.undefinedCommandCount == 0);
+}
+
+
+
+//
+// check the copy of the address wraps the same as the controller's
+//
+void testWrap(void)
+{
+  long commandsBefore;
+  long redundantBefore;
+
+  hostReset();
+  ArduinoUserInterface ui;
+  ui.lcdSetTransportCallback(hostLCDTransport);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+
+  //
+  // the whole display wraps back to the top left, so clearing it again sends
+  // only data
+  //
+  ui.lcdClearDisplay();
+  commandsBefore = hostLcd.commandCount;
+  redundantBefore = hostLcd.redundantAddressCommandCount;
+  ui.lcdClearDisplay();
+  CHECK(hostLcd.commandCount == commandsBefore);
+
+  //
+  // column 83 wraps to column 0 of the next bank
+  //
+  ui.lcdDrawRowOfPixels(0, 83, 2, 0xff);
+  commandsBefore = hostLcd.commandCount;
+  ui.lcdSetCursorXY(0, 3);
+  CHECK(hostLcd.commandCount == commandsBefore);
+  CHECK((hostLcd.addressX == 0) && (hostLcd.addressY == 3));
+
+  //
+  // bank 5 wraps to bank 0
+  //
+  ui.lcdDrawRowOfPixels(0, 83, 5, 0xff);
+  commandsBefore = hostLcd.commandCount;
+  ui.lcdSetCursorXY(0, 0);
+  CHECK(hostLcd.commandCount == commandsBefore);
+  CHECK((hostLcd.addressX == 0) && (hostLcd.addressY == 0));
+
+  //
+  // moving only the column sends only the X command
+  //
+  commandsBefore = hostLcd.commandCount;
+  ui.lcdSetCursorXY(30, 0);
+  CHECK(hostLcd.commandCount == commandsBefore + 1);
+  CHECK(hostLcd.redundantAddressCommandCount == redundantBefore);
+}
+
+
+
+//
+// check the address is forgotten after a command that isn't an address
+//
+void testForgottenAfterCommand(void)
+{
+  long commandsBefore;
+
+  hostReset();
+  ArduinoUserInterface ui;
+  ui.lcdSetTransportCallback(hostLCDTransport);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+
+  ui.lcdSetCursorXY(10, 2);
+  ui.lcdSetContrast(0x40);
+  CHECK(hostLcd.operatingVoltage == 0x40);
+
+  //
+  // both address commands must be sent again, even to the same position
+  //
+  commandsBefore = hostLcd.commandCount;
+  ui.lcdSetCursorXY(10, 2);
+  CHECK(hostLcd.commandCount == commandsBefore + 2);
+  CHECK((hostLcd.addressX == 10) && (hostLcd.addressY == 2));
+
+  //
+  // then the address is known again
+  //
+  commandsBefore = hostLcd.commandCount;
+  ui.lcdSetCursorXY(10, 2);
+  CHECK(hostLcd.commandCount == commandsBefore);
+}
+
+
+
+int main(void)
+{
+  testNoRedundantCommands();
+  testWrap();
+  testForgottenAfterCommand();
+  return(hostTestResult());
+}
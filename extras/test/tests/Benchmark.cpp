@@ -0,0 +1,233 @@
+//      ******************************************************************
+//      *                                                                *
+//      *           Measure the wire cost of the library functions       *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Each library function is called with the LCD bit banged on the pins, and
+// what it sends is read from the bus counts: pin toggles, pin writes (through
+// digitalWrite() or the port registers, depending on the build), commands,
+// data bytes, and the estimated time on a 16 MHz AVR.  The longest single
+// call to tick() while the buttons are pressed is also reported.  Built as
+// BenchmarkDigitalWrite and BenchmarkPortRegisters, comparing the two gives
+// the speed up of writing the port registers directly.
+//
+// If a directory is given on the command line, the screen after each function
+// is saved there as a PBM image.
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+
+
+//
+// ADC readings of the buttons on the Arduino UI Shield
+//
+const int BUTTON_NONE_VALUE = 1023;
+const int BUTTON_DOWN_VALUE = 674;
+const int BUTTON_UP_VALUE = 487;
+const int BUTTON_BACK_VALUE = 319;
+const int BUTTON_SELECT_VALUE = 0;
+
+
+ArduinoUserInterface ui;
+int sliderValue;
+unsigned long longestTickMicros;
+
+
+void menuCommandNothing(void);
+void sliderCallback(byte event, int value);
+
+
+extern const MENU_ITEM_P mainMenu[];
+
+MENU_TABLE_P(mainMenu,
+  menuItem_P(MENU_ITEM_TYPE_MAIN_MENU_HEADER,  "",           NULL,                NULL),
+  menuItem_P(MENU_ITEM_TYPE_COMMAND,           "Start",      menuCommandNothing,  NULL),
+  menuItem_P(MENU_ITEM_TYPE_COMMAND,           "Stop",       menuCommandNothing,  NULL),
+  menuItem_P(MENU_ITEM_TYPE_COMMAND,           "Settings",   menuCommandNothing,  NULL),
+  menuItem_P(MENU_ITEM_TYPE_COMMAND,           "Calibrate",  menuCommandNothing,  NULL),
+  menuItem_P(MENU_ITEM_TYPE_COMMAND,           "About",      menuCommandNothing,  NULL),
+  menuItem_P(MENU_ITEM_TYPE_END_OF_MENU,       "",           NULL,                NULL));
+
+
+// ---------------------------------------------------------------------------------
+//                              The functions measured
+// ---------------------------------------------------------------------------------
+
+//
+// call tick(), recording the longest time any one call has taken
+//
+void timedTick(void)
+{
+  unsigned long startMicros;
+  unsigned long tickMicros;
+
+  startMicros = hostEstimatedMicros(&hostBusCounts);
+  ui.tick();
+  tickMicros = hostEstimatedMicros(&hostBusCounts) - startMicros;
+
+  if (tickMicros > longestTickMicros)
+    longestTickMicros = tickMicros;
+}
+
+
+void menuCommandNothing(void)
+{
+}
+
+
+
+void sliderCallback(byte event, int value)
+{
+  if (event == SLIDER_DISPLAY_VALUE_CHANGED)
+    sliderValue = value;
+}
+
+
+
+//
+// press and release a button, running the library until the press is handled
+//  Enter:  buttonValue = ADC reading of the button
+//
+void pressButton(int buttonValue)
+{
+  int i;
+
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, buttonValue);
+  for (i = 0; i < 10; i++)
+  {
+    hostAdvanceMillis(10);
+    timedTick();
+  }
+
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_NONE_VALUE);
+  for (i = 0; i < 10; i++)
+  {
+    hostAdvanceMillis(10);
+    timedTick();
+  }
+}
+
+
+
+void measureClearDisplay(void)      {ui.lcdClearDisplay();}
+void measureSetCursor(void)         {ui.lcdSetCursorXY(20, 3);}
+void measurePrintString(void)       {ui.lcdSetCursorXY(0, 0); ui.lcdPrintString((char *) "The quick fox");}
+void measurePrintReverse(void)      {ui.lcdSetCursorXY(0, 1); ui.lcdPrintStringReverse((char *) "The quick fox");}
+void measurePrintf(void)            {ui.lcdSetCursorXY(0, 2); ui.lcdPrintf(F("Temp %5.1d C"), 215);}
+void measurePrintInt(void)          {ui.lcdSetCursorXY(0, 3); ui.lcdPrintIntRightJustified(-1234, 6);}
+void measurePrintLarge(void)        {ui.lcdSetCursorXY(0, 2); ui.lcdPrintStringLarge((char *) "12.5", 2);}
+void measureDrawRow(void)           {ui.lcdDrawRowOfPixels(0, 83, 4, 0x55);}
+void measureClearDisplaySpace(void) {ui.clearDisplaySpace();}
+void measureButtonBar(void)         {ui.drawButtonBar((char *) "Set", (char *) "Back");}
+void measureBeginMenu(void)         {ui.beginMenu(mainMenu);}
+void measureMenuDown(void)          {pressButton(BUTTON_DOWN_VALUE);}
+void measureMenuUp(void)            {pressButton(BUTTON_UP_VALUE);}
+void measureMenuSelect(void)        {pressButton(BUTTON_SELECT_VALUE);}
+void measureBeginSlider(void)       {ui.beginSlider(0, 100, 1, 50, (char *) "Level", sliderCallback);}
+void measureSliderUp(void)          {pressButton(BUTTON_UP_VALUE);}
+void measureSliderBack(void)        {pressButton(BUTTON_BACK_VALUE);}
+
+
+//
+// the functions in the order they're measured
+//
+typedef struct _MEASUREMENT
+{
+  const char *Name;
+  void (*Function)(void);
+} MEASUREMENT;
+
+const MEASUREMENT measurements[] = {
+  {"lcdClearDisplay",        measureClearDisplay},
+  {"lcdSetCursorXY",         measureSetCursor},
+  {"lcdPrintString",         measurePrintString},
+  {"lcdPrintStringReverse",  measurePrintReverse},
+  {"lcdPrintf",              measurePrintf},
+  {"lcdPrintIntRight...",    measurePrintInt},
+  {"lcdPrintStringLarge",    measurePrintLarge},
+  {"lcdDrawRowOfPixels",     measureDrawRow},
+  {"clearDisplaySpace",      measureClearDisplaySpace},
+  {"drawButtonBar",          measureButtonBar},
+  {"beginMenu",              measureBeginMenu},
+  {"menu down button",       measureMenuDown},
+  {"menu up button",         measureMenuUp},
+  {"menu select button",     measureMenuSelect},
+  {"beginSlider",            measureBeginSlider},
+  {"slider up button",       measureSliderUp},
+  {"slider back button",     measureSliderBack}};
+
+
+// ---------------------------------------------------------------------------------
+//                                Measure and report
+// ---------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  const MEASUREMENT *measurement;
+  HOST_BUS_COUNTS counts;
+  unsigned long clearDisplayMicros;
+  long clearDisplayBytes;
+  char fileName[256];
+  unsigned int i;
+
+  hostReset();
+  hostConnectLCD(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN);
+
+#if defined(__AVR__)
+  printf("Pins written through the port registers\n\n");
+#else
+  printf("Pins written with digitalWrite()\n\n");
+#endif
+  printf("%-22s %8s %8s %6s %6s %8s\n", "function", "toggles", "writes", "cmds", "data", "est. uS");
+
+  clearDisplayMicros = 0;
+  clearDisplayBytes = 0;
+  for (i = 0; i < sizeof(measurements) / sizeof(measurements[0]); i++)
+  {
+    measurement = &measurements[i];
+
+    hostClearBusCounts();
+    measurement->Function();
+    counts = hostBusCounts;
+
+    printf("%-22s %8ld %8ld %6ld %6ld %8lu\n", measurement->Name, counts.PinToggles,
+      counts.DigitalWrites + counts.PortWrites, counts.CommandBytes, counts.DataBytes,
+      hostEstimatedMicros(&counts));
+
+    if (i == 0)
+    {
+      clearDisplayMicros = hostEstimatedMicros(&counts);
+      clearDisplayBytes = counts.CommandBytes + counts.DataBytes;
+    }
+
+    if (argc > 1)
+    {
+      snprintf(fileName, sizeof(fileName), "%s/%02u.pbm", argv[1], i);
+      hostLcd.savePBM(fileName);
+    }
+  }
+
+  printf("\nlcdClearDisplay sends %lu bytes per second\n",
+    (unsigned long) ((clearDisplayBytes * 1000000.0) / clearDisplayMicros));
+  printf("the longest call to tick() took %lu uS\n", longestTickMicros);
+
+  CHECK(hostLcd.undefinedCommandCount == 0);
+  CHECK(sliderValue == 51);
+  return(hostTestResult());
+}
@@ -0,0 +1,130 @@
+//      ******************************************************************
+//      *                                                                *
+//      *      Test that runs of LCD data are sent as a single burst     *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The LCD is bit banged on the modeled pins and the transitions are counted.
+// A run of data bytes must select the LCD and set the D/C pin once, rather
+// than for each byte, so every select beyond one per command is one burst.
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+
+
+//
+// most transitions a byte can take: the clock up and down for each bit, and
+// the data in pin changing for each bit
+//
+const long MAX_TOGGLES_PER_BYTE = 8 * 2 + 8;
+
+
+//
+// most transitions a select can take: chip enable down and up, and the D/C pin
+//
+const long MAX_TOGGLES_PER_SELECT = 3;
+
+
+ArduinoUserInterface ui;
+
+
+// ---------------------------------------------------------------------------------
+//                                    The tests
+// ---------------------------------------------------------------------------------
+
+//
+// check what crossed the bus for a function that sends data bytes
+//  Enter:  name -> name of the function, for the report
+//          counts -> bus counts after the function was called
+//          expectedDataBytes = number of data bytes it should send
+//          expectedBursts = number of times it should select the LCD for data
+//
+void checkBursts(const char *name, const HOST_BUS_COUNTS *counts, long expectedDataBytes,
+  long expectedBursts)
+{
+  long togglesSaved;
+
+  CHECK(counts->DataBytes == expectedDataBytes);
+  CHECK(counts->ChipSelects == counts->CommandBytes + expectedBursts);
+  CHECK(counts->PinToggles <=
+    (counts->CommandBytes + counts->DataBytes) * MAX_TOGGLES_PER_BYTE +
+    counts->ChipSelects * MAX_TOGGLES_PER_SELECT);
+
+  //
+  // selecting the LCD for each data byte would toggle chip enable twice more
+  // for every byte after the first in a burst
+  //
+  togglesSaved = (counts->DataBytes - expectedBursts) * 2;
+  printf("%-20s %6ld toggles, %4ld selects, %6ld toggles saved by bursts\n",
+    name, counts->PinToggles, counts->ChipSelects, togglesSaved);
+}
+
+
+
+void testBursts(void)
+{
+  HOST_BUS_COUNTS counts;
+
+  hostReset();
+  hostConnectLCD(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_BIT_BANG);
+
+  //
+  // the whole display is one fill
+  //
+  hostClearBusCounts();
+  ui.lcdClearDisplay();
+  counts = hostBusCounts;
+  checkBursts("lcdClearDisplay", &counts, LCD_FRAME_BUFFER_SIZE, 1);
+
+  //
+  // a row of pixels is one fill
+  //
+  hostClearBusCounts();
+  ui.lcdDrawRowOfPixels(0, 83, 3, 0x55);
+  counts = hostBusCounts;
+  checkBursts("lcdDrawRowOfPixels", &counts, 84, 1);
+
+  //
+  // each character is one burst, including its blank column
+  //
+  ui.lcdSetCursorXY(0, 1);
+  hostClearBusCounts();
+  ui.lcdPrintString((char *) "ABCDE");
+  counts = hostBusCounts;
+  checkBursts("lcdPrintString", &counts, counts.DataBytes, 5);
+  CHECK(counts.CommandBytes == 0);
+
+  //
+  // clearing the display space is one fill
+  //
+  hostClearBusCounts();
+  ui.clearDisplaySpace();
+  counts = hostBusCounts;
+  checkBursts("clearDisplaySpace", &counts, LCD_WIDTH_IN_PIXELS * (LCD_HEIGHT_IN_LINES - 1), 1);
+
+  CHECK(hostGetPin(LCD_CHIP_ENABLE_PIN) == HIGH);
+  CHECK(hostLcd.undefinedCommandCount == 0);
+}
+
+
+
+int main(void)
+{
+  testBursts();
+  return(hostTestResult());
+}
@@ -0,0 +1,262 @@
+//      ******************************************************************
+//      *                                                                *
+//      *          Test sampling the buttons from a timer interrupt      *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Built with __AVR__ defined.  Enabling interrupt sampling must set up the
+// Timer0 compare interrupt and switch to split phase ADC conversions, so the
+// ISR never waits in analogRead().  The timer interrupt is modeled by calling
+// buttonsSampleFromISR() once for each millisecond.  Events the queue has no
+// room for must be counted as dropped.  The modeled ADC keeps converting the
+// channel a conversion was started on, as the AVR does, so reading another
+// pin after a button sample must use analogReadOther().
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to, only the callback transport is used
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+const byte SENSOR_ANALOG_PIN = A5;
+
+
+//
+// ADC readings of the buttons on the Arduino UI Shield
+//
+const int BUTTON_NONE_VALUE = 1023;
+const int BUTTON_DOWN_VALUE = 674;
+const int SENSOR_VALUE = 300;
+
+
+// ---------------------------------------------------------------------------------
+//                                    The tests
+// ---------------------------------------------------------------------------------
+
+//
+// run the timer interrupt for a while
+//  Enter:  ui = user interface sampling the buttons
+//          milliseconds = number of interrupts
+//
+void runTimerInterrupt(ArduinoUserInterface &ui, int milliseconds)
+{
+  int i;
+
+  for (i = 0; i < milliseconds; i++)
+  {
+    hostAdvanceMillis(1);
+    ui.buttonsSampleFromISR();
+  }
+}
+
+
+
+//
+// connect the user interface with no button pressed
+//  Enter:  ui = user interface to connect
+//
+void connect(ArduinoUserInterface &ui)
+{
+  hostReset();
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_NONE_VALUE);
+  ui.lcdSetTransportCallback(hostLCDTransport);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+}
+
+
+
+//
+// check the timer is set up and the ISR doesn't wait for the ADC
+//
+void testInterruptSampling(void)
+{
+  ArduinoUserInterface ui;
+  HOST_BUS_COUNTS counts;
+  const int SAMPLES = 200;
+
+  connect(ui);
+  ui.buttonsEnableInterruptSampling();
+  CHECK((TIMSK0 & _BV(OCIE0A)) != 0);
+  CHECK(OCR0A != 0);
+  CHECK((SREG & _BV(SREG_I)) != 0);
+
+  //
+  // press and release the down button
+  //
+  hostClearBusCounts();
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_DOWN_VALUE);
+  runTimerInterrupt(ui, SAMPLES / 2);
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_NONE_VALUE);
+  runTimerInterrupt(ui, SAMPLES / 2);
+  counts = hostBusCounts;
+
+  printf("%d samples in the ISR: %ld analogRead() calls, %lu uS waiting for the ADC\n",
+    SAMPLES, counts.AnalogReads, hostEstimatedMicros(&counts));
+  CHECK(counts.AnalogReads == 0);
+
+  CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT);
+  CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_RELEASED_EVENT);
+  CHECK(ui.getButtonEvent() == BUTTON_NO_EVENT);
+}
+
+
+
+//
+// check the timer is left alone when the application has its own ISR
+//
+void testApplicationTimer(void)
+{
+  ArduinoUserInterface ui;
+
+  connect(ui);
+  ui.buttonsEnableInterruptSampling(false);
+  CHECK(TIMSK0 == 0);
+  CHECK(OCR0A == 0);
+
+  hostClearBusCounts();
+  runTimerInterrupt(ui, 10);
+  CHECK(hostBusCounts.AnalogReads == 0);
+}
+
+
+
+//
+// check events found while the queue is full are dropped and counted, and 
+// that the queue works again once the application catches up
+//
+void testQueueOverflow(void)
+{
+  ArduinoUserInterface ui;
+  const int PRESSES = BUTTON_EVENT_QUEUE_SIZE;
+  int i;
+
+  connect(ui);
+  ui.buttonsEnableInterruptSampling(false);
+  CHECK(ui.buttonsGetDroppedEventCount() == 0);
+
+  //
+  // press and release the down button without taking the events
+  //
+  for (i = 0; i < PRESSES; i++)
+  {
+    hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_DOWN_VALUE);
+    runTimerInterrupt(ui, 100);
+    hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_NONE_VALUE);
+    runTimerInterrupt(ui, 100);
+  }
+
+  //
+  // the queue holds one less than its size, the events kept are the oldest
+  //
+  for (i = 0; i < BUTTON_EVENT_QUEUE_SIZE - 1; i++)
+  {
+    if ((i % 2) == 0)
+      CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT);
+    else
+      CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_RELEASED_EVENT);
+  }
+  CHECK(ui.getButtonEvent() == BUTTON_NO_EVENT);
+
+  CHECK(ui.buttonsGetDroppedEventCount() == PRESSES * 2 - (BUTTON_EVENT_QUEUE_SIZE - 1));
+  CHECK(ui.buttonsGetDroppedEventCount() == 0);
+
+  //
+  // nothing more is dropped once there is room
+  //
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_DOWN_VALUE);
+  runTimerInterrupt(ui, 100);
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_NONE_VALUE);
+  runTimerInterrupt(ui, 100);
+  CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT);
+  CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_RELEASED_EVENT);
+  CHECK(ui.getButtonEvent() == BUTTON_NO_EVENT);
+  CHECK(ui.buttonsGetDroppedEventCount() == 0);
+}
+
+
+
+//
+// check another analog pin can be read right after the buttons are sampled, 
+// both when polling and from the interrupt
+//  Enter:  interruptSamplingFlg = true to sample from the timer interrupt
+//
+void testAnalogReadOther(boolean interruptSamplingFlg)
+{
+  ArduinoUserInterface ui;
+  int i;
+
+  connect(ui);
+  hostSetAnalogValue(SENSOR_ANALOG_PIN, SENSOR_VALUE);
+  if (interruptSamplingFlg)
+    ui.buttonsEnableInterruptSampling(false);
+  else
+    ui.buttonsUseSplitPhaseADC(true);
+
+  //
+  // press the down button, reading the sensor after every sample
+  //
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_DOWN_VALUE);
+  for (i = 0; i < 100; i++)
+  {
+    hostAdvanceMillis(1);
+    if (interruptSamplingFlg)
+      ui.buttonsSampleFromISR();
+    else
+      CHECK(ui.getButtonEvent() != BUTTON_ID_BACK + BUTTON_PUSHED_EVENT);
+
+    CHECK(ui.analogReadOther(SENSOR_ANALOG_PIN) == SENSOR_VALUE);
+    CHECK((SREG & _BV(SREG_I)) != 0);
+  }
+
+  //
+  // analogRead() gets the result of the button conversion still running
+  //
+  if (interruptSamplingFlg)
+    ui.buttonsSampleFromISR();
+  else
+    ui.getButtonEvent();
+  CHECK(analogRead(SENSOR_ANALOG_PIN) == BUTTON_DOWN_VALUE);
+
+  //
+  // the sensor's voltage (near the back button's) must not be taken for a button
+  //
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, BUTTON_NONE_VALUE);
+  if (interruptSamplingFlg)
+  {
+    runTimerInterrupt(ui, 100);
+    CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT);
+    CHECK(ui.getButtonEvent() == BUTTON_ID_DOWN + BUTTON_RELEASED_EVENT);
+    CHECK(ui.getButtonEvent() == BUTTON_NO_EVENT);
+  }
+  else
+  {
+    for (i = 0; i < 100; i++)
+    {
+      hostAdvanceMillis(1);
+      CHECK(ui.getButtonEvent() != BUTTON_ID_BACK + BUTTON_PUSHED_EVENT);
+      CHECK(ui.analogReadOther(SENSOR_ANALOG_PIN) == SENSOR_VALUE);
+    }
+  }
+}
+
+
+
+int main(void)
+{
+  testInterruptSampling();
+  testApplicationTimer();
+  testQueueOverflow();
+  testAnalogReadOther(false);
+  testAnalogReadOther(true);
+  return(hostTestResult());
+}
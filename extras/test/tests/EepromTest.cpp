@@ -0,0 +1,639 @@
+//      ******************************************************************
+//      *                                                                *
+//      *         Test the configuration writes against the EEPROM       *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The EEPROM model counts the writes to each cell.  Unchanged values must not
+// be written, the journal must combine writes to the same address, and a wear
+// leveled long must spread its writes across its slots.  The model can also
+// lose power part way through a save, after which the value read back must be
+// the one from before the save, for a wear leveled long and for the settings
+// struct.  A damaged copy of the settings must fall back to the other copy,
+// and settings saved by an older version must be migrated.  The journal must
+// not hold a wear leveled long or the settings struct, as their writes must
+// reach the EEPROM in order.  A settings struct that doesn't fit the space
+// reserved for it must never be saved.
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostEEPROM.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to, only the callback transport is used
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+
+
+//
+// where the values are stored in the EEPROM
+//
+const int LONG_ADDRESS = 0;
+const int BYTE_ADDRESS = 10;
+const int WEAR_LEVELED_ADDRESS = 100;
+const byte WEAR_LEVELED_SLOTS = 8;
+
+
+//
+// number of times each value is updated
+//
+const long NUMBER_OF_UPDATES = 1000;
+
+
+//
+// a settings struct saved with a schema
+//
+struct TEST_CONFIG
+{
+  byte Contrast;
+  int Level;
+  long RunCount;
+};
+
+TEST_CONFIG config;
+
+const CONFIG_FIELD testConfigFields[] PROGMEM = {
+  CONFIG_FIELD_ENTRY(TEST_CONFIG, Contrast, 65),
+  CONFIG_FIELD_ENTRY(TEST_CONFIG, Level, 500),
+  CONFIG_FIELD_ENTRY(TEST_CONFIG, RunCount, 100000L)};
+
+const int SCHEMA_ADDRESS = 200;
+const unsigned int SCHEMA_RESERVED_SIZE = 24;
+
+
+//
+// the settings struct as it was in version 1, before RunCount was added
+//
+struct TEST_CONFIG_V1
+{
+  byte Contrast;
+  int Level;
+};
+
+TEST_CONFIG_V1 configV1;
+
+const CONFIG_FIELD testConfigFieldsV1[] PROGMEM = {
+  CONFIG_FIELD_ENTRY(TEST_CONFIG_V1, Contrast, 65),
+  CONFIG_FIELD_ENTRY(TEST_CONFIG_V1, Level, 500)};
+
+
+//
+// what the migrate function was called with
+//
+int migrateCallCount;
+byte migrateSavedVersion;
+long migrateRunCount;
+
+
+// ---------------------------------------------------------------------------------
+//                                    The tests
+// ---------------------------------------------------------------------------------
+
+//
+// convert settings saved by version 1, Level was in tenths and is now in 
+// hundredths
+//  Enter:  savedVersion = version of the block that was loaded
+//          configuration -> the settings struct, new fields have their defaults
+//
+void migrateTestConfig(byte savedVersion, void *configuration)
+{
+  TEST_CONFIG *configToMigrate = (TEST_CONFIG *) configuration;
+
+  migrateCallCount++;
+  migrateSavedVersion = savedVersion;
+  migrateRunCount = configToMigrate->RunCount;
+
+  if (savedVersion == 1)
+    configToMigrate->Level *= 10;
+}
+
+
+
+//
+// set the settings struct to values that are different for each set
+//  Enter:  setNumber = which set of values
+//
+void setConfig(int setNumber)
+{
+  memset(&config, 0, sizeof(config));
+  config.Contrast = 40 + setNumber;
+  config.Level = 1000 + setNumber * 111;
+  config.RunCount = 200000L + setNumber * 12345L;
+}
+
+
+
+//
+// check the settings struct holds one set of values
+//  Enter:  setNumber = which set of values
+//  Exit:   true returned if it does
+//
+boolean configIs(int setNumber)
+{
+  return((config.Contrast == 40 + setNumber) && 
+    (config.Level == 1000 + setNumber * 111) && 
+    (config.RunCount == 200000L + setNumber * 12345L));
+}
+
+
+//
+// start with an erased EEPROM and a new user interface
+//  Enter:  ui = user interface to connect
+//
+void connect(ArduinoUserInterface &ui)
+{
+  hostReset();
+  hostEEPROMErase();
+  hostSetAnalogValue(BUTTONS_ANALOG_PIN, 1023);
+  ui.lcdSetTransportCallback(hostLCDTransport);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+  hostEEPROMClearCounts();
+}
+
+
+
+//
+// check that writing a value that's already there doesn't write the EEPROM
+//
+void testUnchangedValuesNotWritten(void)
+{
+  ArduinoUserInterface ui;
+
+  connect(ui);
+  ui.writeConfigurationLong(LONG_ADDRESS, 123456L);
+  ui.writeConfigurationByte(BYTE_ADDRESS, 42);
+  CHECK(hostEEPROM.WriteCount > 0);
+
+  hostEEPROMClearCounts();
+  ui.writeConfigurationLong(LONG_ADDRESS, 123456L);
+  ui.writeConfigurationByte(BYTE_ADDRESS, 42);
+  CHECK(hostEEPROM.WriteCount == 0);
+  CHECK(ui.readConfigurationLong(LONG_ADDRESS, 0) == 123456L);
+  CHECK(ui.readConfigurationByte(BYTE_ADDRESS, 0) == 42);
+
+  //
+  // changing only the low byte writes only that byte
+  //
+  ui.writeConfigurationLong(LONG_ADDRESS, 123457L);
+  CHECK(hostEEPROM.WriteCount == 1);
+}
+
+
+
+//
+// check the wear of each cell over many updates, with and without the slots
+//
+void testWearLeveling(void)
+{
+  ArduinoUserInterface ui;
+  unsigned long plainWear;
+  unsigned long wearLeveledWear;
+  long i;
+
+  connect(ui);
+
+  for (i = 1; i <= NUMBER_OF_UPDATES; i++)
+    ui.writeConfigurationLong(LONG_ADDRESS, i);
+  plainWear = hostEEPROMMostCellWrites(LONG_ADDRESS, CONFIG_WEAR_LEVELED_SLOT_SIZE);
+
+  for (i = 1; i <= NUMBER_OF_UPDATES; i++)
+    ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, i);
+  wearLeveledWear = hostEEPROMMostCellWrites(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS * CONFIG_WEAR_LEVELED_SLOT_SIZE);
+
+  printf("%ld updates: most writes to one cell %lu plain, %lu wear leveled over %d slots\n",
+    NUMBER_OF_UPDATES, plainWear, wearLeveledWear, WEAR_LEVELED_SLOTS);
+
+  CHECK(plainWear == (unsigned long) NUMBER_OF_UPDATES);
+  CHECK(wearLeveledWear <= (unsigned long) (NUMBER_OF_UPDATES / WEAR_LEVELED_SLOTS + 1));
+  CHECK(ui.readConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, 0) == NUMBER_OF_UPDATES);
+
+  //
+  // nothing outside the slots is written
+  //
+  CHECK(hostEEPROMMostCellWrites(WEAR_LEVELED_ADDRESS + WEAR_LEVELED_SLOTS * CONFIG_WEAR_LEVELED_SLOT_SIZE, 16) == 0);
+}
+
+
+
+//
+// check the journal combines writes, then commits them when asked or when the
+// buttons have been idle
+//
+void testJournal(void)
+{
+  ArduinoUserInterface ui;
+  long i;
+
+  connect(ui);
+  ui.configurationUseWriteJournal(true);
+
+  //
+  // a slider saving its value on every change
+  //
+  for (i = 1; i <= 100; i++)
+    ui.writeConfigurationByte(BYTE_ADDRESS, (byte) i);
+  CHECK(hostEEPROM.WriteCount == 0);
+  CHECK(ui.readConfigurationByte(BYTE_ADDRESS, 0) == 100);
+
+  ui.configurationCommit();
+  CHECK(hostEEPROM.CellWriteCount[BYTE_ADDRESS] == 1);
+  CHECK(hostEEPROM.WriteCount <= 2);
+
+  //
+  // committed once the buttons have been idle long enough
+  //
+  hostEEPROMClearCounts();
+  ui.writeConfigurationLong(LONG_ADDRESS, 5000L);
+  ui.getButtonEvent();
+  CHECK(hostEEPROM.WriteCount == 0);
+
+  hostAdvanceMillis(CONFIG_JOURNAL_IDLE_COMMIT_MILLIS);
+  ui.getButtonEvent();
+  CHECK(hostEEPROM.WriteCount > 0);
+  CHECK(hostEEPROMMostCellWrites(LONG_ADDRESS, 5) == 1);
+
+  ui.configurationUseWriteJournal(false);
+  CHECK(ui.readConfigurationLong(LONG_ADDRESS, 0) == 5000L);
+}
+
+
+
+//
+// cut the power at each point of a wear leveled save, the old value must be
+// read back until the save is complete
+//
+void testTornWrite(void)
+{
+  ArduinoUserInterface ui;
+  const long oldValue = 0x11223344L;
+  const long newValue = 0x55667788L;
+  unsigned long writesForSave;
+  long writesBeforeFailure;
+  long valueRead;
+
+  //
+  // find how many writes the save takes
+  //
+  connect(ui);
+  ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, oldValue);
+  hostEEPROMClearCounts();
+  ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, newValue);
+  writesForSave = hostEEPROM.WriteCount;
+  CHECK(writesForSave == CONFIG_WEAR_LEVELED_SLOT_SIZE);
+
+  for (writesBeforeFailure = 0; writesBeforeFailure <= (long) writesForSave; writesBeforeFailure++)
+  {
+    connect(ui);
+    ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, oldValue);
+
+    hostEEPROMFailPowerAfter(writesBeforeFailure);
+    ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, newValue);
+    hostEEPROMRestorePower();
+
+    //
+    // read back after power up with a new user interface
+    //
+    ArduinoUserInterface restartedUI;
+    valueRead = restartedUI.readConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, 0);
+    if (writesBeforeFailure < (long) writesForSave)
+      CHECK(valueRead == oldValue);
+    else
+      CHECK(valueRead == newValue);
+
+    //
+    // the next save after the failure must work
+    //
+    restartedUI.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, newValue + 1);
+    CHECK(restartedUI.readConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, WEAR_LEVELED_SLOTS, 0) == newValue + 1);
+  }
+}
+
+
+
+//
+// check a wear leveled save isn't held in the journal, it must be in the 
+// EEPROM when the function returns, after the writes that were waiting in the 
+// journal.  Then cut the power at each point of a series of saves made with 
+// the journal enabled, the value read back must always be one that was saved, 
+// never a mix of two
+//
+void testTornWriteWithJournal(void)
+{
+  ArduinoUserInterface ui;
+  const long values[] = {0x11111111L, 0x22222222L, 0x33333333L, 0x44444444L, 
+    0x55555555L, 0x66666666L, 0x77777777L};
+  const byte NUMBER_OF_VALUES = sizeof(values) / sizeof(values[0]);
+  const byte SLOTS = 2;
+  unsigned long writesForSaves;
+  long writesBeforeFailure;
+  long valueRead;
+  byte i;
+  boolean savedFlg;
+
+  connect(ui);
+  ui.configurationUseWriteJournal(true);
+  ui.writeConfigurationByte(BYTE_ADDRESS, 42);
+  CHECK(hostEEPROM.WriteCount == 0);
+  ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, SLOTS, values[0]);
+
+  ArduinoUserInterface poweredUpUI;
+  CHECK(poweredUpUI.readConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, SLOTS, 0) == values[0]);
+  CHECK(poweredUpUI.readConfigurationByte(BYTE_ADDRESS, 0) == 42);
+
+  //
+  // save the values, with another setting in the journal, and find how many 
+  // writes that takes
+  //
+  connect(ui);
+  ui.configurationUseWriteJournal(true);
+  for (i = 0; i < NUMBER_OF_VALUES; i++)
+  {
+    ui.writeConfigurationByte(BYTE_ADDRESS, i);
+    ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, SLOTS, values[i]);
+  }
+  ui.configurationCommit();
+  writesForSaves = hostEEPROM.WriteCount;
+  CHECK(ui.readConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, SLOTS, 0) == values[NUMBER_OF_VALUES - 1]);
+
+  for (writesBeforeFailure = 0; writesBeforeFailure <= (long) writesForSaves; writesBeforeFailure++)
+  {
+    connect(ui);
+    ui.configurationUseWriteJournal(true);
+
+    hostEEPROMFailPowerAfter(writesBeforeFailure);
+    for (i = 0; i < NUMBER_OF_VALUES; i++)
+    {
+      ui.writeConfigurationByte(BYTE_ADDRESS, i);
+      ui.writeConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, SLOTS, values[i]);
+    }
+    ui.configurationCommit();
+    hostEEPROMRestorePower();
+
+    ArduinoUserInterface restartedUI;
+    valueRead = restartedUI.readConfigurationLongWearLeveled(WEAR_LEVELED_ADDRESS, SLOTS, 0);
+
+    savedFlg = (valueRead == 0);
+    for (i = 0; i < NUMBER_OF_VALUES; i++)
+    {
+      if (valueRead == values[i])
+        savedFlg = true;
+    }
+    CHECK(savedFlg);
+  }
+}
+
+
+
+//
+// check saving the settings struct isn't held in the journal either
+//
+void testSaveConfigurationWithJournal(void)
+{
+  ArduinoUserInterface ui;
+  CONFIG_SCHEMA_DEFINE(testSchema, SCHEMA_ADDRESS, 24, 1, config, testConfigFields, NULL);
+
+  connect(ui);
+  ui.configurationUseWriteJournal(true);
+  ui.loadConfiguration(&testSchema);
+  ui.writeConfigurationByte(BYTE_ADDRESS, 42);
+
+  config.Level = 321;
+  ui.saveConfiguration();
+
+  ArduinoUserInterface poweredUpUI;
+  memset(&config, 0, sizeof(config));
+  CHECK(poweredUpUI.loadConfiguration(&testSchema));
+  CHECK(config.Level == 321);
+  CHECK(config.Contrast == 65);
+  CHECK(poweredUpUI.readConfigurationByte(BYTE_ADDRESS, 0) == 42);
+}
+
+
+
+//
+// check a struct bigger than its reserved space is rejected without writing 
+// the EEPROM, the schema is built by hand as CONFIG_SCHEMA_DEFINE() wouldn't 
+// compile
+//
+void testSchemaTooBig(void)
+{
+  ArduinoUserInterface ui;
+  CONFIG_SCHEMA tooBigSchema = {
+    SCHEMA_ADDRESS, sizeof(config) - 1, 1, &config, sizeof(config),
+    testConfigFields, sizeof(testConfigFields) / sizeof(testConfigFields[0]), NULL};
+
+  connect(ui);
+  memset(&config, 0x5a, sizeof(config));
+
+  CHECK(!ui.loadConfiguration(&tooBigSchema));
+  CHECK(config.Contrast == 65);
+  CHECK(config.Level == 500);
+  CHECK(config.RunCount == 100000L);
+
+  config.Level = 600;
+  ui.saveConfiguration();
+  CHECK(hostEEPROM.WriteCount == 0);
+}
+
+
+
+//
+// cut the power at each write of saveConfiguration(), the settings from the 
+// save before must be loaded until the save is complete.  Both copies have 
+// been saved before, so the save writes over an older block
+//
+void testTornSaveConfiguration(void)
+{
+  ArduinoUserInterface ui;
+  CONFIG_SCHEMA_DEFINE(testSchema, SCHEMA_ADDRESS, SCHEMA_RESERVED_SIZE, 1, config, testConfigFields, NULL);
+  unsigned long writesForSave;
+  long writesBeforeFailure;
+
+  //
+  // find how many writes the save takes
+  //
+  connect(ui);
+  ui.loadConfiguration(&testSchema);
+  setConfig(1);
+  ui.saveConfiguration();
+  setConfig(2);
+  ui.saveConfiguration();
+  hostEEPROMClearCounts();
+  setConfig(3);
+  ui.saveConfiguration();
+  writesForSave = hostEEPROM.WriteCount;
+  CHECK(writesForSave > 0);
+
+  for (writesBeforeFailure = 0; writesBeforeFailure <= (long) writesForSave; writesBeforeFailure++)
+  {
+    connect(ui);
+    ui.loadConfiguration(&testSchema);
+    setConfig(1);
+    ui.saveConfiguration();
+    setConfig(2);
+    ui.saveConfiguration();
+
+    hostEEPROMFailPowerAfter(writesBeforeFailure);
+    setConfig(3);
+    ui.saveConfiguration();
+    hostEEPROMRestorePower();
+
+    //
+    // load after power up with a new user interface
+    //
+    ArduinoUserInterface restartedUI;
+    memset(&config, 0, sizeof(config));
+    CHECK(restartedUI.loadConfiguration(&testSchema));
+    if (writesBeforeFailure < (long) writesForSave)
+      CHECK(configIs(2));
+    else
+      CHECK(configIs(3));
+
+    //
+    // the next save after the failure must work
+    //
+    setConfig(4);
+    restartedUI.saveConfiguration();
+
+    ArduinoUserInterface restartedAgainUI;
+    memset(&config, 0, sizeof(config));
+    CHECK(restartedAgainUI.loadConfiguration(&testSchema));
+    CHECK(configIs(4));
+  }
+}
+
+
+
+//
+// damage a byte of each copy of the block, the other copy must be loaded, 
+// and the defaults used once both are damaged
+//
+void testDamagedCopy(void)
+{
+  ArduinoUserInterface ui;
+  CONFIG_SCHEMA_DEFINE(testSchema, SCHEMA_ADDRESS, SCHEMA_RESERVED_SIZE, 1, config, testConfigFields, NULL);
+  const int COPY_SIZE = CONFIG_BLOCK_HEADER_SIZE + SCHEMA_RESERVED_SIZE + CONFIG_BLOCK_CRC_SIZE;
+  const int LEVEL_OFFSET = CONFIG_BLOCK_HEADER_SIZE + offsetof(TEST_CONFIG, Level);
+  int newestCopyAddress;
+  int olderCopyAddress;
+
+  //
+  // the first save goes to copy 0, the second to copy 1
+  //
+  connect(ui);
+  ui.loadConfiguration(&testSchema);
+  setConfig(1);
+  ui.saveConfiguration();
+  setConfig(2);
+  ui.saveConfiguration();
+  olderCopyAddress = SCHEMA_ADDRESS;
+  newestCopyAddress = SCHEMA_ADDRESS + COPY_SIZE;
+
+  //
+  // damage the older copy, the newest is still loaded
+  //
+  hostEEPROM.Cells[olderCopyAddress + LEVEL_OFFSET] ^= 0x04;
+  memset(&config, 0, sizeof(config));
+  CHECK(ui.loadConfiguration(&testSchema));
+  CHECK(configIs(2));
+
+  //
+  // damage the newest copy instead, the older one is loaded
+  //
+  hostEEPROM.Cells[olderCopyAddress + LEVEL_OFFSET] ^= 0x04;
+  hostEEPROM.Cells[newestCopyAddress + LEVEL_OFFSET] ^= 0x04;
+  memset(&config, 0, sizeof(config));
+  CHECK(ui.loadConfiguration(&testSchema));
+  CHECK(configIs(1));
+
+  //
+  // a save then goes over the damaged copy
+  //
+  setConfig(3);
+  ui.saveConfiguration();
+  memset(&config, 0, sizeof(config));
+  CHECK(ui.loadConfiguration(&testSchema));
+  CHECK(configIs(3));
+
+  //
+  // with both copies damaged the defaults are used
+  //
+  hostEEPROM.Cells[olderCopyAddress + LEVEL_OFFSET] ^= 0x04;
+  hostEEPROM.Cells[newestCopyAddress + LEVEL_OFFSET] ^= 0x04;
+  memset(&config, 0, sizeof(config));
+  CHECK(!ui.loadConfiguration(&testSchema));
+  CHECK(config.Contrast == 65);
+  CHECK(config.Level == 500);
+  CHECK(config.RunCount == 100000L);
+}
+
+
+
+//
+// load a block saved by version 1 with version 2, which added a field.  The 
+// migrate function must be called once, after the new field has its default, 
+// and the block must then be saved in the new format
+//
+void testVersionUpgrade(void)
+{
+  ArduinoUserInterface ui;
+  CONFIG_SCHEMA_DEFINE(schemaV1, SCHEMA_ADDRESS, SCHEMA_RESERVED_SIZE, 1, configV1, testConfigFieldsV1, NULL);
+  CONFIG_SCHEMA_DEFINE(schemaV2, SCHEMA_ADDRESS, SCHEMA_RESERVED_SIZE, 2, config, testConfigFields, migrateTestConfig);
+
+  connect(ui);
+  ui.loadConfiguration(&schemaV1);
+  configV1.Contrast = 70;
+  configV1.Level = 42;
+  ui.saveConfiguration();
+
+  //
+  // power up with the new version of the application
+  //
+  ArduinoUserInterface upgradedUI;
+  migrateCallCount = 0;
+  memset(&config, 0, sizeof(config));
+  CHECK(upgradedUI.loadConfiguration(&schemaV2));
+  CHECK(migrateCallCount == 1);
+  CHECK(migrateSavedVersion == 1);
+  CHECK(migrateRunCount == 100000L);
+  CHECK(config.Contrast == 70);
+  CHECK(config.Level == 420);
+  CHECK(config.RunCount == 100000L);
+
+  //
+  // the block was saved as version 2, so it isn't migrated again
+  //
+  ArduinoUserInterface restartedUI;
+  migrateCallCount = 0;
+  memset(&config, 0, sizeof(config));
+  CHECK(restartedUI.loadConfiguration(&schemaV2));
+  CHECK(migrateCallCount == 0);
+  CHECK(config.Level == 420);
+  CHECK(config.RunCount == 100000L);
+}
+
+
+
+int main(void)
+{
+  testUnchangedValuesNotWritten();
+  testWearLeveling();
+  testJournal();
+  testTornWrite();
+  testTornWriteWithJournal();
+  testSaveConfigurationWithJournal();
+  testSchemaTooBig();
+  testTornSaveConfiguration();
+  testDamagedCopy();
+  testVersionUpgrade();
+  return(hostTestResult());
+}
@@ -0,0 +1,139 @@
+//      ******************************************************************
+//      *                                                                *
+//      *        Test the LCD pins written through the port registers    *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Built with __AVR__ defined, so the library bit bangs the LCD by setting and
+// clearing bits in the modeled port registers.  Each of those is a
+// read-modify-write of the whole port, so every one must be made with
+// interrupts disabled, and the interrupt flag must be put back the way the
+// caller had it.  The pixels must match the callback transport, and the
+// estimated time must be well below what digitalWrite() would take.
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to, the clock and data in pins share port C with
+// the buttons
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+
+
+// ---------------------------------------------------------------------------------
+//                                    The tests
+// ---------------------------------------------------------------------------------
+
+//
+// draw a screen using most of the drawing functions
+//  Enter:  ui = user interface to draw with
+//
+void drawScreen(ArduinoUserInterface &ui)
+{
+  ui.lcdClearDisplay();
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString((char *) "Port writes");
+  ui.lcdSetCursorXY(4, 2);
+  ui.lcdPrintStringReverse((char *) "Reverse");
+  ui.lcdDrawRowOfPixels(10, 83, 3, 0x55);
+  ui.drawButtonBar((char *) "Set", (char *) "Back");
+}
+
+
+
+//
+// check every port write is made with interrupts disabled, and that the
+// interrupt flag is restored
+//
+void testPortWritesAreProtected(void)
+{
+  byte callbackScreen[LCD_FRAME_BUFFER_SIZE];
+  HOST_BUS_COUNTS counts;
+
+  //
+  // draw the screen with the callback transport to know what it should be
+  //
+  hostReset();
+  ArduinoUserInterface callbackUI;
+  callbackUI.lcdSetTransportCallback(hostLCDTransport);
+  callbackUI.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+  drawScreen(callbackUI);
+  memcpy(callbackScreen, hostLcd.ram, sizeof(callbackScreen));
+
+  //
+  // draw it again bit banged through the port registers
+  //
+  hostReset();
+  hostConnectLCD(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN);
+  ArduinoUserInterface ui;
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_BIT_BANG);
+
+  hostClearBusCounts();
+  drawScreen(ui);
+  counts = hostBusCounts;
+
+  CHECK(hostLcd.samePixelsAs(callbackScreen));
+  CHECK(counts.PortWrites > 0);
+  CHECK(counts.DigitalWrites == 0);
+  CHECK(counts.UnprotectedPortWrites == 0);
+  CHECK(counts.InterruptGuards > 0);
+  CHECK((SREG & _BV(SREG_I)) != 0);
+  CHECK(hostGetPin(LCD_CHIP_ENABLE_PIN) == HIGH);
+
+  //
+  // guarding the writes must cost little next to digitalWrite()
+  //
+  CHECK(counts.EstimatedCycles * 4 < (unsigned long) counts.PortWrites * HOST_DIGITAL_WRITE_CYCLES);
+
+  //
+  // a caller that has already disabled interrupts must find them still disabled
+  //
+  noInterrupts();
+  ui.lcdSetCursorXY(0, 4);
+  ui.lcdPrintString((char *) "cli");
+  CHECK((SREG & _BV(SREG_I)) == 0);
+  interrupts();
+}
+
+
+
+//
+// report the speed of clearing the display through the port registers
+//
+void reportClearDisplaySpeed(void)
+{
+  HOST_BUS_COUNTS counts;
+
+  hostReset();
+  hostConnectLCD(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN);
+  ArduinoUserInterface ui;
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_BIT_BANG);
+
+  hostClearBusCounts();
+  ui.lcdClearDisplay();
+  counts = hostBusCounts;
+
+  printf("lcdClearDisplay: %ld port writes, %ld interrupt guards, %lu uS, %lu bytes per second\n",
+    counts.PortWrites, counts.InterruptGuards, hostEstimatedMicros(&counts),
+    (unsigned long) (((counts.CommandBytes + counts.DataBytes) * 1000000.0) / hostEstimatedMicros(&counts)));
+  CHECK(counts.UnprotectedPortWrites == 0);
+}
+
+
+
+int main(void)
+{
+  testPortWritesAreProtected();
+  reportClearDisplaySpeed();
+  return(hostTestResult());
+}
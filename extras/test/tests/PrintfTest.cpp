@@ -0,0 +1,193 @@
+//      ******************************************************************
+//      *                                                                *
+//      *              Test the fields printed by lcdPrintf()            *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// Each field is printed with lcdPrintf(), then the same text is printed with
+// lcdPrintString() and the pixels compared.  With the 5x8 font every
+// character, including a space, is the width of a digit, so a padded field
+// must look the same as its text padded with spaces.
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to, only the callback transport is used
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+
+
+//
+// a string stored in flash for the %S fields
+//
+const char flashString[] PROGMEM = "abc";
+
+
+ArduinoUserInterface ui;
+
+
+// ---------------------------------------------------------------------------------
+//                                    The tests
+// ---------------------------------------------------------------------------------
+
+//
+// clear the display and move the cursor to the top left, ready to print a field
+//
+void startField(void)
+{
+  ui.lcdClearDisplay();
+  ui.lcdSetCursorXY(0, 0);
+}
+
+
+
+//
+// check what lcdPrintf() printed since startField() against a string
+//  Enter:  expected -> the text lcdPrintf() should have printed
+//  Exit:   true returned if the pixels are the same
+//
+boolean printedAs(const char *expected)
+{
+  byte printedScreen[LCD_FRAME_BUFFER_SIZE];
+  boolean sameFlg;
+
+  memcpy(printedScreen, hostLcd.ram, sizeof(printedScreen));
+
+  startField();
+  ui.lcdPrintString((char *) expected);
+  sameFlg = hostLcd.samePixelsAs(printedScreen);
+
+  if (!sameFlg)
+    printf("lcdPrintf() didn't print \"%s\"\n", expected);
+  return(sameFlg);
+}
+
+
+
+//
+// check the width of a field and the flags that justify and pad it
+//
+void testWidthAndFlags(void)
+{
+  startField();
+  ui.lcdPrintf(F("%5d|"), 42);
+  CHECK(printedAs("   42|"));
+
+  startField();
+  ui.lcdPrintf(F("%-5d|"), 42);
+  CHECK(printedAs("42   |"));
+
+  startField();
+  ui.lcdPrintf(F("%05d|"), 42);
+  CHECK(printedAs("00042|"));
+
+  startField();
+  ui.lcdPrintf(F("%05d|"), -42);
+  CHECK(printedAs("-0042|"));
+
+  //
+  // as with printf(), left justifying overrides padding with zeros
+  //
+  startField();
+  ui.lcdPrintf(F("%-05d|"), 42);
+  CHECK(printedAs("42   |"));
+
+  startField();
+  ui.lcdPrintf(F("%0-5d|"), 42);
+  CHECK(printedAs("42   |"));
+
+  //
+  // a number wider than its field isn't cut off
+  //
+  startField();
+  ui.lcdPrintf(F("%2d|"), 12345);
+  CHECK(printedAs("12345|"));
+
+  startField();
+  ui.lcdPrintf(F("%u %lu %ld"), 65535U, 4000000000UL, -2000000000L);
+  CHECK(printedAs("65535 4000000000 -2000000000"));
+}
+
+
+
+//
+// check integers printed as fixed point values
+//
+void testDecimals(void)
+{
+  startField();
+  ui.lcdPrintf(F("%.2d"), 150);
+  CHECK(printedAs("1.50"));
+
+  startField();
+  ui.lcdPrintf(F("%.2d"), 5);
+  CHECK(printedAs("0.05"));
+
+  startField();
+  ui.lcdPrintf(F("%.1d"), -5);
+  CHECK(printedAs("-0.5"));
+
+  startField();
+  ui.lcdPrintf(F("Temp %5.1d C"), 215);
+  CHECK(printedAs("Temp  21.5 C"));
+
+  startField();
+  ui.lcdPrintf(F("%06.2d|"), -150);
+  CHECK(printedAs("-01.50|"));
+
+  startField();
+  ui.lcdPrintf(F("%-6.1d|"), 215);
+  CHECK(printedAs("21.5  |"));
+}
+
+
+
+//
+// check strings in RAM and in flash, characters and a %
+//
+void testStrings(void)
+{
+  startField();
+  ui.lcdPrintf(F("%s %c %d%%"), "Pump", 'A', 50);
+  CHECK(printedAs("Pump A 50%"));
+
+  startField();
+  ui.lcdPrintf(F("%S"), flashString);
+  CHECK(printedAs("abc"));
+
+  startField();
+  ui.lcdPrintf(F("%6S|"), flashString);
+  CHECK(printedAs("   abc|"));
+
+  startField();
+  ui.lcdPrintf(F("%-6S|"), flashString);
+  CHECK(printedAs("abc   |"));
+
+  startField();
+  ui.lcdPrintf(F("%-6s|%4s"), "ab", "xy");
+  CHECK(printedAs("ab    |  xy"));
+}
+
+
+
+int main(void)
+{
+  hostReset();
+  ui.lcdSetTransportCallback(hostLCDTransport);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+
+  testWidthAndFlags();
+  testDecimals();
+  testStrings();
+  return(hostTestResult());
+}
@@ -0,0 +1,227 @@
+//      ******************************************************************
+//      *                                                                *
+//      *        Test the LCD transports against the PCD8544 model       *
+//      *                                                                *
+//      *            S. Reifel & Co.                10/16/2026           *
+//      *                                                                *
+//      ******************************************************************
+
+// The same screen is drawn through the callback transport, bit banged on the
+// pins, sent with hardware SPI, and drawn into a frame buffer.  Every way must
+// leave the same pixels in the LCD model.  The model's own addressing is
+// checked first, since the other tests depend on it.
+
+
+#include <ArduinoUserInterface.h>
+#include "HostArduino.h"
+#include "HostTest.h"
+
+
+//
+// pins the LCD is connected to
+//
+const byte LCD_CLOCK_PIN = A0;
+const byte LCD_DATA_IN_PIN = A1;
+const byte LCD_DATA_CONTROL_PIN = A2;
+const byte LCD_CHIP_ENABLE_PIN = 4;
+const byte BUTTONS_ANALOG_PIN = A3;
+
+
+//
+// a stream that keeps what's printed to it
+//
+class StringPrint : public Print
+{
+  public:
+    size_t write(uint8_t c) {text[length++] = c; text[length] = 0; return(1);}
+    char text[4096];
+    int length = 0;
+};
+
+
+// ---------------------------------------------------------------------------------
+//                                    The tests
+// ---------------------------------------------------------------------------------
+
+//
+// draw a screen using most of the drawing functions
+//  Enter:  ui = user interface to draw with
+//
+void drawScreen(ArduinoUserInterface &ui)
+{
+  ui.lcdClearDisplay();
+  ui.lcdSetCursorXY(0, 0);
+  ui.lcdPrintString((char *) "Transport");
+  ui.lcdSetCursorXY(4, 1);
+  ui.lcdPrintStringReverse((char *) "Reverse");
+  ui.lcdSetCursorXY(0, 2);
+  ui.lcdPrintf(F("%5.1d C %-4s|"), 215, "ab");
+  ui.lcdDrawRowOfPixels(10, 83, 3, 0x55);
+  ui.lcdSetCursorXY(60, 4);
+  ui.lcdPrintInt(-42);
+  ui.drawButtonBar((char *) "Set", (char *) "Back");
+}
+
+
+
+//
+// check that the model's address counter advances and wraps like the
+// controller's, horizontally and vertically
+//
+void testModelAddressing(void)
+{
+  int i;
+
+  hostReset();
+
+  //
+  // horizontal addressing wraps from the last column to the next bank, and
+  // from the last bank back to the first
+  //
+  hostLcd.writeByte(LOW, 0x20);
+  hostLcd.writeByte(LOW, 0x80 | 83);
+  hostLcd.writeByte(LOW, 0x40 | 2);
+  hostLcd.writeByte(HIGH, 0x11);
+  CHECK((hostLcd.addressX == 0) && (hostLcd.addressY == 3));
+  CHECK(hostLcd.ram[2][83] == 0x11);
+
+  hostLcd.writeByte(LOW, 0x80 | 83);
+  hostLcd.writeByte(LOW, 0x40 | 5);
+  hostLcd.writeByte(HIGH, 0x22);
+  CHECK((hostLcd.addressX == 0) && (hostLcd.addressY == 0));
+
+  for (i = 0; i < PCD8544_WIDTH_IN_PIXELS * PCD8544_HEIGHT_IN_BANKS; i++)
+    hostLcd.writeByte(HIGH, 0x00);
+  CHECK((hostLcd.addressX == 0) && (hostLcd.addressY == 0));
+
+  //
+  // vertical addressing moves down the banks, then to the next column
+  //
+  hostLcd.writeByte(LOW, 0x22);
+  hostLcd.writeByte(LOW, 0x80 | 10);
+  hostLcd.writeByte(LOW, 0x40 | 5);
+  hostLcd.writeByte(HIGH, 0x33);
+  CHECK((hostLcd.addressX == 11) && (hostLcd.addressY == 0));
+  CHECK(hostLcd.ram[5][10] == 0x33);
+
+  //
+  // the extended instruction set shares the X address opcode with Vop
+  //
+  hostLcd.writeByte(LOW, 0x21);
+  hostLcd.writeByte(LOW, 0xc0);
+  CHECK(hostLcd.operatingVoltage == 0x40);
+  CHECK(hostLcd.addressX == 11);
+  CHECK(hostLcd.undefinedCommandCount == 0);
+}
+
+
+
+//
+// draw the screen through each transport and check they all match
+//
+void testTransports(void)
+{
+  byte callbackScreen[LCD_FRAME_BUFFER_SIZE];
+  long callbackDataBytes;
+  byte frameBuffer[LCD_FRAME_BUFFER_SIZE];
+  long dataBytesBeforeDrawing;
+
+  //
+  // bytes given to a callback, no pins are used
+  //
+  hostReset();
+  ArduinoUserInterface callbackUI;
+  callbackUI.lcdSetTransportCallback(hostLCDTransport);
+  callbackUI.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+  drawScreen(callbackUI);
+  memcpy(callbackScreen, hostLcd.ram, sizeof(callbackScreen));
+  callbackDataBytes = hostLcd.dataByteCount;
+  CHECK(hostBusCounts.PinToggles == 0);
+  CHECK(hostLcd.undefinedCommandCount == 0);
+  CHECK(hostLcd.powerDownFlag == false);
+  CHECK(hostLcd.displayMode == 0x04);
+
+  //
+  // bits toggled on the pins
+  //
+  hostReset();
+  hostConnectLCD(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN);
+  ArduinoUserInterface bitBangUI;
+  bitBangUI.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_BIT_BANG);
+  drawScreen(bitBangUI);
+  CHECK(hostLcd.samePixelsAs(callbackScreen));
+  CHECK(hostLcd.dataByteCount == callbackDataBytes);
+  CHECK(hostBusCounts.PinToggles > 0);
+  CHECK(hostGetPin(LCD_CHIP_ENABLE_PIN) == HIGH);
+
+  //
+  // bytes sent with hardware SPI
+  //
+  hostReset();
+  hostConnectLCD(SCK, MOSI, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN);
+  ArduinoUserInterface spiUI;
+  spiUI.connectToPins(SCK, MOSI, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_HARDWARE_SPI);
+  drawScreen(spiUI);
+  CHECK(hostLcd.samePixelsAs(callbackScreen));
+  CHECK(hostBusCounts.SPITransfers == hostBusCounts.CommandBytes + hostBusCounts.DataBytes);
+
+  //
+  // drawn into a frame buffer, nothing reaches the LCD until it's flushed
+  //
+  hostReset();
+  ArduinoUserInterface frameBufferUI;
+  frameBufferUI.lcdSetTransportCallback(hostLCDTransport);
+  frameBufferUI.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+  frameBufferUI.lcdUseFrameBuffer(frameBuffer);
+  dataBytesBeforeDrawing = hostLcd.dataByteCount;
+  drawScreen(frameBufferUI);
+  CHECK(hostLcd.dataByteCount == dataBytesBeforeDrawing);
+  CHECK(memcmp(frameBuffer, callbackScreen, sizeof(frameBuffer)) == 0);
+
+  frameBufferUI.lcdFlush();
+  CHECK(hostLcd.samePixelsAs(callbackScreen));
+}
+
+
+
+//
+// check the frame buffer's PBM image is the same as the model's
+//
+void testPBM(void)
+{
+  byte frameBuffer[LCD_FRAME_BUFFER_SIZE];
+  StringPrint libraryImage;
+  char modelImage[4096];
+  FILE *file;
+  size_t length;
+
+  hostReset();
+  ArduinoUserInterface ui;
+  ui.lcdSetTransportCallback(hostLCDTransport);
+  ui.connectToPins(LCD_CLOCK_PIN, LCD_DATA_IN_PIN, LCD_DATA_CONTROL_PIN, LCD_CHIP_ENABLE_PIN, BUTTONS_ANALOG_PIN, LCD_TRANSPORT_CALLBACK);
+  ui.lcdUseFrameBuffer(frameBuffer);
+  drawScreen(ui);
+  ui.lcdFlush();
+
+  ui.lcdWriteFrameBufferAsPBM(libraryImage);
+
+  file = tmpfile();
+  hostLcd.writePBM(file);
+  rewind(file);
+  length = fread(modelImage, 1, sizeof(modelImage) - 1, file);
+  modelImage[length] = 0;
+  fclose(file);
+
+  CHECK(strcmp(libraryImage.text, modelImage) == 0);
+  CHECK(strncmp(modelImage, "P1\n84 48\n", 9) == 0);
+}
+
+
+
+int main(void)
+{
+  testModelAddressing();
+  testTransports();
+  testPBM();
+  return(hostTestResult());
+}
@@ -113,10 +113,45 @@
 // ---------------------------------------------------------------------------------
 
 #include <avr/pgmspace.h>
+#include <stdarg.h>
 #include <EEPROM.h>
+#include <SPI.h>
 #include "ArduinoUserInterface.h"
 
 
+//
+// values for: engineState
+//
+const byte ENGINE_IDLE         = 0;
+const byte ENGINE_MENU         = 1;
+const byte ENGINE_SLIDER       = 2;
+const byte ENGINE_FLOAT_SLIDER = 3;
+const byte ENGINE_DECIMAL_SLIDER = 4;
+
+
+//
+// measure a drawing operation from here to the end of the enclosing function, 
+// operations called by another operation are counted as part of the outer one
+//
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+class LcdInstrumentScope
+{
+  public:
+    LcdInstrumentScope(ArduinoUserInterface *_ui, byte operation) : ui(_ui) { ui->lcdInstrumentBegin(operation); }
+    ~LcdInstrumentScope(void) { ui->lcdInstrumentEnd(); }
+
+  private:
+    ArduinoUserInterface *ui;
+};
+
+#define LCD_INSTRUMENT_OPERATION(operation) LcdInstrumentScope lcdInstrumentScope(this, operation)
+#define LCD_INSTRUMENT_COUNT(counter) lcdInstrumentRecord.counter++
+#else
+#define LCD_INSTRUMENT_OPERATION(operation)
+#define LCD_INSTRUMENT_COUNT(counter)
+#endif
+
+
 
 // ---------------------------------------------------------------------------------
 //                                     Setup functions 
@@ -127,6 +162,33 @@
 //
 ArduinoUserInterface::ArduinoUserInterface(void)
 {
+  lcdFrameBuffer = NULL;
+  lcdTransportCallback = NULL;
+  lcdFont = &lcdFont5x8;
+  engineState = ENGINE_IDLE;
+  engineButtonEvent = NULL;
+  engineMenuRedrawPending = false;
+  currentMenuTable = NULL;
+  currentMenuTable_P = NULL;
+  currentVirtualMenu = NULL;
+  currentSettingsMenu = NULL;
+  virtualMenuItemIdx = 0;
+  currentMenuItemIdx = 1;
+  currentMenuTopLineItemIdx = 1;
+  menuNavigationDepth = 0;
+  menuNavigationBase = 0;
+  configJournalEnabled = false;
+  configJournalCount = 0;
+  configReadCallback = NULL;
+  configWriteCallback = NULL;
+  configSchema = NULL;
+  sliderEditingSetting = false;
+
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+  lcdInstrumentDepth = 0;
+  lcdInstrumentTraceHead = 0;
+  lcdInstrumentTraceCount = 0;
+#endif
 }
 
 
@@ -138,10 +200,15 @@ ArduinoUserInterface::ArduinoUserInterface(void)
 //          _lcdDataControlPin = digital pin that connects to LCD's control pin (DC)
 //          _lcdChipEnablePin = digital pin that connects to the LCD's chip enable pin (CE)
 //          _buttonAnalogPin = analog pin that connects to the buttons
+//          _lcdTransport = LCD_TRANSPORT_BIT_BANG (default) to toggle the CLK & DIN  
+//            pins in software, or LCD_TRANSPORT_HARDWARE_SPI to use the SPI hardware,  
+//            in which case CLK & DIN must be wired to the board's SCK & MOSI pins,
+//            or LCD_TRANSPORT_CALLBACK to give each byte to the function set with
+//            lcdSetTransportCallback() rather than using the pins
 //
 void ArduinoUserInterface::connectToPins(byte _lcdClockPin, byte _lcdDataInPin, 
                               byte _lcdDataControlPin, byte _lcdChipEnablePin,
-                              byte _buttonAnalogPin)
+                              byte _buttonAnalogPin, byte _lcdTransport)
 {
   //
   // assign IO pin numbers
@@ -151,6 +218,7 @@ void ArduinoUserInterface::connectToPins(byte _lcdClockPin, byte _lcdDataInPin,
   lcdDataControlPin = _lcdDataControlPin;
   lcdChipEnablePin = _lcdChipEnablePin;
   buttonAnalogPin = _buttonAnalogPin;
+  lcdTransport = _lcdTransport;
   
 
   //
@@ -162,10 +230,80 @@ void ArduinoUserInterface::connectToPins(byte _lcdClockPin, byte _lcdDataInPin,
 }
 
 
+// ---------------------------------------------------------------------------------
+//                             Non-blocking user interface  
+// ---------------------------------------------------------------------------------
+
+//
+// run the menu or slider started with beginMenu(), beginSlider(),   
+// beginFloatSlider() or beginDecimalSlider(), this function does not block, it 
+// should be called each time through the application's loop().  At most one 
+// button event is processed per call, and at most one full screen is drawn: 
+// the menu is redrawn on the call after a menu command, not in the same call.  
+// What this doesn't bound is the menu command itself, which runs in the call 
+// that sees Select.  A command that calls a blocking function, such as 
+// displayAndExecuteMenu() on a settings menu or displaySlider(), doesn't 
+// return until the user leaves it, use the "begin" functions from commands to 
+// keep each call short.
+//
+void ArduinoUserInterface::tick(void)
+{
+  byte buttonEvent;
+
+  //
+  // don't take button events away from the application if nothing is running
+  //
+  if (engineState == ENGINE_IDLE)
+    return;
+
+  //
+  // if returning to a menu from a slider, redraw the menu
+  //
+  if ((engineState == ENGINE_MENU) && engineMenuRedrawPending)
+  {
+    redrawCurrentMenu();
+    return;
+  }
+
+  //
+  // check for a new button event, then send it to what is running.  The 
+  // handler is set by the function that started it, so the code for a slider 
+  // the application never uses (such as the float slider) isn't linked in
+  //
+  buttonEvent = getButtonEvent();
+  if (buttonEvent == BUTTON_NO_EVENT)
+    return;
+
+  (this->*engineButtonEvent)(buttonEvent);
+}
+
+
+
+//
+// check if a menu or slider started with a "begin" function is still running
+//  Exit:   true returned while running, false once the user has left it
+//
+boolean ArduinoUserInterface::isActive(void)
+{
+  return(engineState != ENGINE_IDLE);
+}
+
+
 // ---------------------------------------------------------------------------------
 //                                     Menu display  
 // ---------------------------------------------------------------------------------
 
+//
+// menus with more items than fit on the screen get a scroll bar on the right, 
+// holding Up or Down moves further each MENU_ACCELERATE_REPEAT_COUNT auto 
+// repeats, up to a page of items at a time
+//
+const byte MENU_SCROLL_BAR_WIDTH = 2;
+const byte MENU_SCROLL_BAR_HEIGHT = MAX_MENU_ITEMS_TO_DISPLAY * 8;
+const byte MENU_SCROLL_BAR_MIN_THUMB_HEIGHT = 3;
+const byte MENU_ACCELERATE_REPEAT_COUNT = 8;
+
+
 //
 // display the top leven menu, wait for button presses and execute commands 
 // connected to the menu
@@ -173,128 +311,276 @@ void ArduinoUserInterface::connectToPins(byte _lcdClockPin, byte _lcdDataInPin,
 //
 void ArduinoUserInterface::displayAndExecuteMenu(MENU_ITEM *menu)
 {
-  byte buttonEvent;
-  byte newMenuItemIdx;
-  byte menuItemType;
-  MENU_ITEM *parentMenu;
+  displayAndExecuteMenuTable(menu, NULL, NULL, NULL);
+}
+
+
+
+//
+// display the top level menu from a table stored in flash, wait for button 
+// presses and execute commands connected to the menu
+//  Enter:  menu -> the menu to display, built with MENU_TABLE_P()
+//
+void ArduinoUserInterface::displayAndExecuteMenu(const MENU_ITEM_P *menu)
+{
+  displayAndExecuteMenuTable(NULL, menu, NULL, NULL);
+}
+
+
+
+//
+// display a virtual menu, wait for button presses and execute commands 
+// connected to the menu
+//  Enter:  menu -> the virtual menu to display
+//
+void ArduinoUserInterface::displayAndExecuteMenu(VIRTUAL_MENU *menu)
+{
+  displayAndExecuteMenuTable(NULL, NULL, menu, NULL);
+}
+
+
+
+//
+// display a settings menu, wait for button presses and edit the settings 
+// selected until the user presses Back
+//  Enter:  menu -> the settings menu to display
+//
+void ArduinoUserInterface::displayAndExecuteMenu(SETTINGS_MENU *menu)
+{
+  displayAndExecuteMenuTable(NULL, NULL, NULL, menu);
+}
+
+
+
+//
+// display a menu stored in RAM, flash, a virtual menu or a settings menu, and 
+// execute it until the user leaves it
+//  Enter:  menu -> the menu to display if it's in RAM, else NULL
+//          menu_P -> the menu to display if it's in flash, else NULL
+//          virtualMenu -> the menu to display if it's virtual, else NULL
+//          settingsMenu -> the menu to display if it's a settings menu, else NULL
+//
+void ArduinoUserInterface::displayAndExecuteMenuTable(MENU_ITEM *menu, 
+  const MENU_ITEM_P *menu_P, VIRTUAL_MENU *virtualMenu, SETTINGS_MENU *settingsMenu)
+{
+  byte savedEngineState;
+  void (ArduinoUserInterface::*savedEngineButtonEvent)(byte buttonEvent);
+  MENU_NAVIGATION_LEVEL savedMenuLevel;
+  byte savedMenuNavigationDepth;
+  byte savedMenuNavigationBase;
   
   //
-  // display the top lever menu, selecting the first item in the menu
+  // remember what was running in case this menu was called from a command
   //
-  selectAndDrawMenu(menu);
-  
+  savedEngineState = engineState;
+  savedEngineButtonEvent = engineButtonEvent;
+  saveMenuNavigationLevel(&savedMenuLevel);
+  savedMenuNavigationDepth = menuNavigationDepth;
+  savedMenuNavigationBase = menuNavigationBase;
+
   //
-  // check for and execute button pushes and menu commands
+  // display the top level menu, then check for and execute button pushes and 
+  // menu commands until the user leaves the menu
   //
-  while(true)
+  if (settingsMenu != NULL)
+    beginMenu(settingsMenu);
+  else if (virtualMenu != NULL)
+    beginMenu(virtualMenu);
+  else if (menu_P != NULL)
+    beginMenu(menu_P);
+  else
+    beginMenu(menu);
+
+  while(engineState != ENGINE_IDLE)
+    tick();
+
+  engineState = savedEngineState;
+  engineButtonEvent = savedEngineButtonEvent;
+  restoreMenuNavigationLevel(&savedMenuLevel);
+  menuNavigationDepth = savedMenuNavigationDepth;
+  menuNavigationBase = savedMenuNavigationBase;
+}
+
+
+
+//
+// display the top level menu without waiting for the user, the application's 
+// loop() must then call tick() to process the button presses
+//  Enter:  menu -> the menu to display
+//
+void ArduinoUserInterface::beginMenu(MENU_ITEM *menu)
+{
+  startMenuNavigation();
+  selectAndDrawMenu(menu);
+}
+
+
+
+//
+// display the top level menu from a table stored in flash without waiting for 
+// the user, the application's loop() must then call tick()
+//  Enter:  menu -> the menu to display, built with MENU_TABLE_P()
+//
+void ArduinoUserInterface::beginMenu(const MENU_ITEM_P *menu)
+{
+  startMenuNavigation();
+  selectAndDrawMenu(menu);
+}
+
+
+
+//
+// display a virtual menu without waiting for the user, the application's 
+// loop() must then call tick()
+//  Enter:  menu -> the virtual menu to display
+//
+void ArduinoUserInterface::beginMenu(VIRTUAL_MENU *menu)
+{
+  startMenuNavigation();
+  selectAndDrawMenu(menu);
+}
+
+
+
+//
+// display a settings menu without waiting for the user, the application's 
+// loop() must then call tick()
+//  Enter:  menu -> the settings menu to display
+//
+void ArduinoUserInterface::beginMenu(SETTINGS_MENU *menu)
+{
+  startMenuNavigation();
+  selectAndDrawMenu(menu);
+}
+
+
+
+//
+// start the menu engine with an empty navigation stack, when a menu is started 
+// from a command the levels of the menus above it are left alone
+//
+void ArduinoUserInterface::startMenuNavigation(void)
+{
+  if (engineState == ENGINE_IDLE)
+    menuNavigationDepth = 0;
+
+  menuNavigationBase = menuNavigationDepth;
+  engineState = ENGINE_MENU;
+  engineButtonEvent = &ArduinoUserInterface::menuButtonEvent;
+}
+
+
+
+//
+// process one button event for the menu
+//  Enter:  buttonEvent = the event from getButtonEvent()
+//
+void ArduinoUserInterface::menuButtonEvent(byte buttonEvent)
+{
+  int newMenuItemIdx;
+  byte menuItemType;
+  
+  switch(buttonEvent)
   {
     //
-    // check for a new button event
+    // check if the "down" button has been pressed
     //
-    buttonEvent = getButtonEvent();
-    switch(buttonEvent)
+    case BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT:
+      menuRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_DOWN + BUTTON_REPEAT_EVENT:
     {
       //
-      // check if the "down" button has been pressed
+      // move the selected menu entry down, further the longer the button is 
+      // held, stopping at the end of the table
       //
-      case BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT:
-      case BUTTON_ID_DOWN + BUTTON_REPEAT_EVENT:
-      {
-        //
-        // move the selected menu entry down one, if not already at the end of 
-        // the table
-        //
-        newMenuItemIdx = currentMenuItemIdx + 1;
-        if (currentMenuTable[newMenuItemIdx].MenuItemType == MENU_ITEM_TYPE_END_OF_MENU)
-          break;
-        currentMenuItemIdx = newMenuItemIdx;
-        
-        //
-        // check if new menu item is off the end of the screen
-        //
-        if(currentMenuItemIdx - currentMenuTopLineItemIdx >= MAX_MENU_ITEMS_TO_DISPLAY)
-          currentMenuTopLineItemIdx++;
-        
-        //
-        // redraw the menu
-        //
-        drawMenu();
+      menuRepeatCount++;
+      newMenuItemIdx = currentMenuItemIdx + getMenuScrollStride();
+      if (newMenuItemIdx > currentMenuItemCount)
+        newMenuItemIdx = currentMenuItemCount;
+
+      if (newMenuItemIdx <= currentMenuItemIdx)
         break;
-      }
+      
+      moveMenuSelection(newMenuItemIdx);
+      break;
+    }
 
+    //
+    // check if the "up" button has been pressed
+    //
+    case BUTTON_ID_UP + BUTTON_PUSHED_EVENT:
+      menuRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_UP + BUTTON_REPEAT_EVENT:
+    {
       //
-      // check if the "up" button has been pressed
+      // move the selected menu entry up, further the longer the button is 
+      // held, stopping at the beginning of the table
       //
-      case BUTTON_ID_UP + BUTTON_PUSHED_EVENT:
-      case BUTTON_ID_UP + BUTTON_REPEAT_EVENT:
-      {
-        //
-        // move the selected menu entry up one, if not already at the beginning 
-        // of the table
-        //
-        newMenuItemIdx = currentMenuItemIdx - 1;
-        if (newMenuItemIdx == 0)
-          break;
-        currentMenuItemIdx = newMenuItemIdx;
-        
-        //
-        // check if new menu item is off the beginning of the screen
-        //
-        if(currentMenuItemIdx - currentMenuTopLineItemIdx < 0)
-          currentMenuTopLineItemIdx--;
-          
-        //
-        // redraw the menu
-        //
-        drawMenu();
+      menuRepeatCount++;
+      newMenuItemIdx = currentMenuItemIdx - getMenuScrollStride();
+      if (newMenuItemIdx < 1)
+        newMenuItemIdx = 1;
+
+      if (newMenuItemIdx == currentMenuItemIdx)
         break;
-      }
 
+      moveMenuSelection(newMenuItemIdx);
+      break;
+    }
+
+    //
+    // check if the "select" button has been pressed
+    //
+    case BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT:
+    {
+      executeMenuItem();
+      break;
+    }
+
+
+    //
+    // check if the "back" button has been pressed
+    //
+    case BUTTON_ID_BACK + BUTTON_PUSHED_EVENT:
+    {
+      //
+      // get the type of the currently displayed menu
+      //
+      menuItemType = getMenuItemType(0);
+      
       //
-      // check if the "select" button has been pressed
+      // check if this is a sub menu, if so go back to its parent showing the 
+      // same item selected as when the sub menu was entered.  If that wasn't 
+      // recorded (the stack was full), use the parent linked to the header
       //
-      case BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT:
+      if (menuItemType == MENU_ITEM_TYPE_SUB_MENU_HEADER)
       {
-        executeMenuItem();
+        if (menuNavigationDepth > menuNavigationBase)
+        {
+          menuNavigationDepth--;
+          restoreMenuNavigationLevel(&menuNavigationStack[menuNavigationDepth]);
+          redrawCurrentMenu();
+        }
+        else if (menuItemHasLinkedMenu(0))
+          selectAndDrawLinkedMenu(0);
         break;
       }
-
-
+      
       //
-      // check if the "back" button has been pressed
+      // check if this is the main menu, if so optionally return from this 
+      // subroutine call
       //
-      case BUTTON_ID_BACK + BUTTON_PUSHED_EVENT:
+      if (menuItemType == MENU_ITEM_TYPE_MAIN_MENU_HEADER)
       {
         //
-        // get the type of the currently displayed menu
-        //
-        menuItemType = currentMenuTable[0].MenuItemType;
-        
-        //
-        // check if this is a sub menu, if so go back to its parent
-        //
-        if (menuItemType == MENU_ITEM_TYPE_SUB_MENU_HEADER)
-        {
-          parentMenu = currentMenuTable[0].MenuItemSubMenu;
-          selectAndDrawMenu(parentMenu);
-          break;
-        }
-        
-        //
-        // check if this is the main menu, if so optionally return from this 
-        // subroutine call
+        // if no menu is attached to the main menu, then just return to the 
+        // caller of this function
         //
-        if (menuItemType == MENU_ITEM_TYPE_MAIN_MENU_HEADER)
-        {
-          //
-          // if no menu is attached to the main menu, then just return to the 
-          // caller of this function
-          //
-          parentMenu = currentMenuTable[0].MenuItemSubMenu;
-          if (parentMenu == NULL)
-            return;
-          break;
-        }
+        if (!menuItemHasLinkedMenu(0))
+          engineState = ENGINE_IDLE;
+        break;
       }
     }
   }
@@ -308,76 +594,393 @@ void ArduinoUserInterface::displayAndExecuteMenu(MENU_ITEM *menu)
 //
 void ArduinoUserInterface::selectAndDrawMenu(MENU_ITEM *menu)
 { 
-  //
-  // remember this menu and select the first item in the menu
-  //
   currentMenuTable = menu;
-  currentMenuItemIdx = 1;
-  currentMenuTopLineItemIdx = 1;
+  currentMenuTable_P = NULL;
+  currentVirtualMenu = NULL;
+  currentSettingsMenu = NULL;
+  selectAndDrawCurrentMenu();
+}
 
-  //
-  // clear the display space and move the cursor to the top line
-  //
-  clearDisplaySpace();
-  
-  //
-  // draw all lines of the menu, showing one of the items as selected
-  //
-  drawMenu();
 
-  //
-  // draw the button bar, don't include the back button if this is the main menu
-  // and it links back to itself
-  //
-  if ((currentMenuTable[0].MenuItemType == MENU_ITEM_TYPE_MAIN_MENU_HEADER) &&
-    (currentMenuTable[0].MenuItemSubMenu != NULL))
-  {
-    drawButtonBar("Select", "");
-  }
-  else
-  {
-    drawButtonBar("Select", "Back");
-  }
+
+//
+// select and display a menu or submenu stored in flash
+//  Enter:  menu -> the menu to display
+//
+void ArduinoUserInterface::selectAndDrawMenu(const MENU_ITEM_P *menu)
+{ 
+  currentMenuTable = NULL;
+  currentMenuTable_P = menu;
+  currentVirtualMenu = NULL;
+  currentSettingsMenu = NULL;
+  selectAndDrawCurrentMenu();
 }
 
 
 
 //
-// select and display a menu or submenu
-//  Enter:  currentMenuTable -> the menu to display
-//          currentMenuItemIdx = index in that menu of the line to select
+// select and display a virtual menu
+//  Enter:  menu -> the menu to display
 //
-void ArduinoUserInterface::drawMenu(void)
+void ArduinoUserInterface::selectAndDrawMenu(VIRTUAL_MENU *menu)
 { 
-  byte menuIdx;
-  byte menuLine;
+  currentMenuTable = NULL;
+  currentMenuTable_P = NULL;
+  currentVirtualMenu = menu;
+  currentSettingsMenu = NULL;
+  selectAndDrawCurrentMenu();
+}
 
-  //
-  // draw each of the menu items
-  //
-  menuIdx = currentMenuTopLineItemIdx;
-  for(menuLine = 0; menuLine < MAX_MENU_ITEMS_TO_DISPLAY; menuLine++)
-  {
-    if(currentMenuTable[menuIdx].MenuItemType == MENU_ITEM_TYPE_END_OF_MENU)
-      break;
-    
-    drawMenuItem(menuIdx, menuLine);
-    menuIdx++;
-  }
+
+
+//
+// select and display a settings menu
+//  Enter:  menu -> the menu to display
+//
+void ArduinoUserInterface::selectAndDrawMenu(SETTINGS_MENU *menu)
+{ 
+  currentMenuTable = NULL;
+  currentMenuTable_P = NULL;
+  currentVirtualMenu = NULL;
+  currentSettingsMenu = menu;
+  selectAndDrawCurrentMenu();
 }
 
 
 
 //
-// draw one entry of a menu, show it in reverse video if it is selected
-//  Enter:  menuIdx = the index into the currently selected menu to draw
-//          menuLine = line number on the LCD to draw the item, 0 = top line
+// select the menu that an item links to: the sub menu of a "sub menu" item, or 
+// the parent of a menu's header
+//  Enter:  menuIdx = index into the currently selected menu of the item
 //
-void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
+void ArduinoUserInterface::selectAndDrawLinkedMenu(int menuIdx)
+{
+  //
+  // a menu stored in flash only links to other menus stored in flash, the items 
+  // of virtual menus link to menus in RAM
+  //
+  if (currentVirtualMenu != NULL)
+    selectAndDrawMenu(getVirtualMenuItem(menuIdx)->MenuItemSubMenu);
+  else if (currentMenuTable_P != NULL)
+    selectAndDrawMenu((const MENU_ITEM_P *) pgm_read_ptr(&currentMenuTable_P[menuIdx].MenuItemSubMenu));
+  else
+    selectAndDrawMenu(currentMenuTable[menuIdx].MenuItemSubMenu);
+}
+
+
+
+//
+// display the currently selected menu, with its first item selected
+//  Enter:  currentMenuTable or currentMenuTable_P -> the menu to display
+//
+void ArduinoUserInterface::selectAndDrawCurrentMenu(void)
+{ 
+  currentMenuItemIdx = 1;
+  currentMenuTopLineItemIdx = 1;
+  redrawCurrentMenu();
+}
+
+
+
+//
+// redraw the whole screen of the currently selected menu, keeping the same 
+// item selected and the same scroll position
+//  Enter:  currentMenuTable or currentMenuTable_P -> the menu to display
+//          currentMenuItemIdx = index in that menu of the line to select
+//          currentMenuTopLineItemIdx = index of the item on the top line
+//
+void ArduinoUserInterface::redrawCurrentMenu(void)
+{ 
+  byte cacheSlot;
+
+  engineMenuRedrawPending = false;
+
+  //
+  // get the items of a virtual menu again in case the application changed them, 
+  // then count the items in case there are now fewer than the one selected
+  //
+  virtualMenuItemIdx = 0;
+  currentMenuItemCount = countMenuItems();
+
+  if ((currentMenuItemIdx > currentMenuItemCount) && (currentMenuItemCount > 0))
+  {
+    currentMenuItemIdx = currentMenuItemCount;
+    if (currentMenuTopLineItemIdx > currentMenuItemIdx)
+      currentMenuTopLineItemIdx = currentMenuItemIdx;
+  }
+
+  //
+  // leave room for the scroll bar if the menu doesn't fit on the screen
+  //
+  if (currentMenuItemCount > MAX_MENU_ITEMS_TO_DISPLAY)
+    menuLineWidthInPixels = LCD_WIDTH_IN_PIXELS - MENU_SCROLL_BAR_WIDTH;
+  else
+    menuLineWidthInPixels = LCD_WIDTH_IN_PIXELS;
+
+  //
+  // forget the text of toggles from the last time a menu was drawn, the item 
+  // index 0 is the menu header so it never matches a toggle
+  //
+  for (cacheSlot = 0; cacheSlot < MAX_MENU_ITEMS_TO_DISPLAY; cacheSlot++)
+    menuToggleTextCacheItemIdx[cacheSlot] = 0;
+
+  //
+  // clear the display space and move the cursor to the top line
+  //
+  clearDisplaySpace();
+  
+  //
+  // draw all lines of the menu, showing one of the items as selected
+  //
+  drawMenu();
+  drawMenuScrollBar(0);
+
+  //
+  // draw the button bar, don't include the back button if this is the main menu
+  // and it links back to itself
+  //
+  if ((getMenuItemType(0) == MENU_ITEM_TYPE_MAIN_MENU_HEADER) && menuItemHasLinkedMenu(0))
+  {
+    drawButtonBar("Select", "");
+  }
+  else
+  {
+    drawButtonBar("Select", "Back");
+  }
+}
+
+
+
+//
+// select and display a menu or submenu
+//  Enter:  currentMenuTable -> the menu to display
+//          currentMenuItemIdx = index in that menu of the line to select
+//
+void ArduinoUserInterface::drawMenu(void)
+{ 
+  int menuIdx;
+  byte menuLine;
+
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_DRAW_MENU);
+
+  //
+  // draw each of the menu items
+  //
+  menuIdx = currentMenuTopLineItemIdx;
+  for(menuLine = 0; menuLine < MAX_MENU_ITEMS_TO_DISPLAY; menuLine++)
+  {
+    if(menuIdx > currentMenuItemCount)
+      break;
+    
+    drawMenuItem(menuIdx, menuLine);
+    menuIdx++;
+  }
+}
+
+
+
+//
+// select a different item in the currently displayed menu, scrolling if needed
+// and redrawing as little as possible
+//  Enter:  newMenuItemIdx = index of the menu item to select
+//
+void ArduinoUserInterface::moveMenuSelection(int newMenuItemIdx)
+{
+  int oldMenuItemIdx;
+  int oldMenuTopLineItemIdx;
+
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_MOVE_MENU_SELECTION);
+
+  oldMenuItemIdx = currentMenuItemIdx;
+  oldMenuTopLineItemIdx = currentMenuTopLineItemIdx;
+  currentMenuItemIdx = newMenuItemIdx;
+
+  //
+  // check if new menu item is off the beginning or end of the screen
+  //
+  if (currentMenuItemIdx < currentMenuTopLineItemIdx)
+    currentMenuTopLineItemIdx = currentMenuItemIdx;
+
+  if (currentMenuItemIdx - currentMenuTopLineItemIdx >= MAX_MENU_ITEMS_TO_DISPLAY)
+    currentMenuTopLineItemIdx = currentMenuItemIdx - MAX_MENU_ITEMS_TO_DISPLAY + 1;
+
+  //
+  // if the menu scrolled, every line shows a different item so redraw them all
+  //
+  if (currentMenuTopLineItemIdx != oldMenuTopLineItemIdx)
+  {
+    drawMenu();
+    drawMenuScrollBar(oldMenuTopLineItemIdx);
+    return;
+  }
+
+  //
+  // otherwise only the lines that were and now are selected need redrawing
+  //
+  drawMenuItem(oldMenuItemIdx, oldMenuItemIdx - currentMenuTopLineItemIdx);
+  drawMenuItem(currentMenuItemIdx, currentMenuItemIdx - currentMenuTopLineItemIdx);
+}
+
+
+
+//
+// get how many items Up or Down moves the selection, this grows while the button 
+// is held until a whole page is skipped with each auto repeat
+//  Enter:  menuRepeatCount = number of events since the button was pressed
+//  Exit:   number of items to move returned
+//
+int ArduinoUserInterface::getMenuScrollStride(void)
+{
+  unsigned int stride;
+
+  stride = (menuRepeatCount / MENU_ACCELERATE_REPEAT_COUNT) + 1;
+  if (stride > MAX_MENU_ITEMS_TO_DISPLAY)
+    stride = MAX_MENU_ITEMS_TO_DISPLAY;
+
+  return(stride);
+}
+
+
+
+//
+// draw the scroll bar of a menu that has more items than fit on the screen, 
+// only the lines of the bar that change are redrawn
+//  Enter:  previousTopLineItemIdx = index of the item that was on the top line 
+//            when the bar was last drawn, 0 to draw the whole bar
+//
+void ArduinoUserInterface::drawMenuScrollBar(int previousTopLineItemIdx)
+{
+  byte menuLine;
+  byte columnOfPixels;
+
+  if (currentMenuItemCount <= MAX_MENU_ITEMS_TO_DISPLAY)
+    return;
+
+  for(menuLine = 0; menuLine < MAX_MENU_ITEMS_TO_DISPLAY; menuLine++)
+  {
+    columnOfPixels = getMenuScrollBarColumn(menuLine, currentMenuTopLineItemIdx);
+
+    if ((previousTopLineItemIdx != 0) && 
+      (getMenuScrollBarColumn(menuLine, previousTopLineItemIdx) == columnOfPixels))
+      continue;
+
+    lcdSetCursorXY(LCD_LAST_COLUMN_X, menuLine);
+    lcdFillToColumnX(LCD_WIDTH_IN_PIXELS, columnOfPixels);
+  }
+}
+
+
+
+//
+// get the pixels of the scroll bar on one line: a dotted track with a solid 
+// thumb that's sized and placed by the part of the menu showing
+//  Enter:  menuLine = line number on the LCD, 0 = top line
+//          topLineItemIdx = index of the item on the top line
+//  Exit:   column of 8 pixels returned
+//
+byte ArduinoUserInterface::getMenuScrollBarColumn(byte menuLine, int topLineItemIdx)
+{
+  byte thumbHeight;
+  byte thumbTop;
+  byte pixelY;
+  byte bit;
+  byte columnOfPixels;
+
+  thumbHeight = (MENU_SCROLL_BAR_HEIGHT * MAX_MENU_ITEMS_TO_DISPLAY) / currentMenuItemCount;
+  if (thumbHeight < MENU_SCROLL_BAR_MIN_THUMB_HEIGHT)
+    thumbHeight = MENU_SCROLL_BAR_MIN_THUMB_HEIGHT;
+
+  thumbTop = ((long) (topLineItemIdx - 1) * (MENU_SCROLL_BAR_HEIGHT - thumbHeight)) / 
+    (currentMenuItemCount - MAX_MENU_ITEMS_TO_DISPLAY);
+
+  columnOfPixels = 0;
+  for(bit = 0; bit < 8; bit++)
+  {
+    pixelY = (menuLine * 8) + bit;
+    if (((pixelY >= thumbTop) && (pixelY < thumbTop + thumbHeight)) || (pixelY & 1))
+      columnOfPixels |= 1 << bit;
+  }
+
+  return(columnOfPixels);
+}
+
+
+
+//
+// count the items in the currently selected menu, not including the header 
+// and end of menu entries
+//  Exit:   number of items returned
+//
+int ArduinoUserInterface::countMenuItems(void)
+{
+  int menuIdx;
+
+  if (currentVirtualMenu != NULL)
+    return(currentVirtualMenu->MenuItemCount);
+
+  if (currentSettingsMenu != NULL)
+    return(currentSettingsMenu->NumberOfSettings);
+
+  menuIdx = 1;
+  while(getMenuItemType(menuIdx) != MENU_ITEM_TYPE_END_OF_MENU)
+    menuIdx++;
+
+  return(menuIdx - 1);
+}
+
+
+
+//
+// get the text displayed for a toggle menu item, the toggle's callback is only 
+// executed if its text isn't already known, or the state is being changed
+//  Enter:  menuIdx = the index into the currently selected menu of the toggle
+//          changeStateFlag = true to have the callback change the toggle's state
+//  Exit:   pointer to the toggle's text returned
+//
+char *ArduinoUserInterface::getMenuToggleStateText(int menuIdx, boolean changeStateFlag)
+{
+  byte cacheSlot;
+
+  //
+  // the items visible on the screen are always consecutive, so each one maps to 
+  // a different slot in the cache
+  //
+  cacheSlot = menuIdx % MAX_MENU_ITEMS_TO_DISPLAY;
+  if ((menuToggleTextCacheItemIdx[cacheSlot] == menuIdx) && !changeStateFlag)
+    return(menuToggleTextCache[cacheSlot]);
+
+  //
+  // execute the callback fuction to get the text for the toggle
+  //
+  toggleMenuChangeStateFlag = changeStateFlag;
+  callMenuItemFunction(menuIdx);
+
+  //
+  // save a copy of the text, unless it's too long for the cache
+  //
+  if (strlen(toggleMenuStateText) < MENU_TOGGLE_TEXT_CACHE_SIZE)
+  {
+    strcpy(menuToggleTextCache[cacheSlot], toggleMenuStateText);
+    menuToggleTextCacheItemIdx[cacheSlot] = menuIdx;
+  }
+  else
+    menuToggleTextCacheItemIdx[cacheSlot] = 0;
+
+  return(toggleMenuStateText);
+}
+
+
+
+//
+// draw one entry of a menu, show it in reverse video if it is selected
+//  Enter:  menuIdx = the index into the currently selected menu to draw
+//          menuLine = line number on the LCD to draw the item, 0 = top line
+//
+void ArduinoUserInterface::drawMenuItem(int menuIdx, byte menuLine)
 {
   byte menuItemSelected;
   byte fillCharacter;
-  char *menuItemText;
+  char *toggleStateText;
   byte widthOfToggleMenuStateTextInPixels;
   
   //
@@ -385,11 +988,6 @@ void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
   //
   lcdSetCursorXY(0, menuLine);
 
-  //
-  // get the text displayed on the menu line
-  //
-  menuItemText = currentMenuTable[menuIdx].MenuItemText;
-  
   //
   // determine if this menu item is selected
   //
@@ -407,7 +1005,7 @@ void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
   //
   // determine the menu entry type and draw it
   //
-  switch(currentMenuTable[menuIdx].MenuItemType)
+  switch(getMenuItemType(menuIdx))
   {    
     //
     // display the text for "sub menu" type menu entry
@@ -418,14 +1016,14 @@ void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
       
       if(menuItemSelected)
       {
-        lcdPrintStringReverse(menuItemText);
-        lcdFillToColumnX(LCD_WIDTH_IN_PIXELS - 6, fillCharacter);
+        drawMenuItemText(menuIdx, true);
+        lcdFillToColumnX(menuLineWidthInPixels - lcdCharacterWidthInPixels(0x80), fillCharacter);
         lcdPrintCharacterReverse(0x80);
       }
       else
       {
-        lcdPrintString(menuItemText);
-        lcdFillToColumnX(LCD_WIDTH_IN_PIXELS - 6, fillCharacter);
+        drawMenuItemText(menuIdx, false);
+        lcdFillToColumnX(menuLineWidthInPixels - lcdCharacterWidthInPixels(0x80), fillCharacter);
         lcdPrintCharacter(0x80);
       }
       break;
@@ -439,11 +1037,11 @@ void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
       lcdFillToColumnX(3, fillCharacter);
       
       if(menuItemSelected)
-        lcdPrintStringReverse(menuItemText);
+        drawMenuItemText(menuIdx, true);
       else
-        lcdPrintString(menuItemText);
+        drawMenuItemText(menuIdx, false);
 
-      lcdFillToEndOfLine(fillCharacter);
+      lcdFillToColumnX(menuLineWidthInPixels, fillCharacter);
       break;
     }
 
@@ -453,11 +1051,10 @@ void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
     case MENU_ITEM_TYPE_TOGGLE:
     {
       //
-      // execute the callback fuction to get the text for the toggle
+      // get the text for the toggle
       //
-      toggleMenuChangeStateFlag = false;
-      (currentMenuTable[menuIdx].MenuItemFunction)();
-      widthOfToggleMenuStateTextInPixels = lcdStringWidthInPixels(toggleMenuStateText);
+      toggleStateText = getMenuToggleStateText(menuIdx, false);
+      widthOfToggleMenuStateTextInPixels = lcdStringWidthInPixels(toggleStateText);
 
       //
       // draw the menu item
@@ -466,15 +1063,15 @@ void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
       
       if(menuItemSelected)
       {
-        lcdPrintStringReverse(menuItemText);
-        lcdFillToColumnX(LCD_WIDTH_IN_PIXELS - widthOfToggleMenuStateTextInPixels, fillCharacter);
-        lcdPrintStringReverse(toggleMenuStateText);
+        drawMenuItemText(menuIdx, true);
+        lcdFillToColumnX(menuLineWidthInPixels - widthOfToggleMenuStateTextInPixels, fillCharacter);
+        lcdPrintStringReverse(toggleStateText);
       }
       else
       {
-        lcdPrintString(menuItemText);
-        lcdFillToColumnX(LCD_WIDTH_IN_PIXELS - widthOfToggleMenuStateTextInPixels, fillCharacter);
-        lcdPrintString(toggleMenuStateText);
+        drawMenuItemText(menuIdx, false);
+        lcdFillToColumnX(menuLineWidthInPixels - widthOfToggleMenuStateTextInPixels, fillCharacter);
+        lcdPrintString(toggleStateText);
       }
       break;
     }
@@ -488,20 +1085,27 @@ void ArduinoUserInterface::drawMenuItem(byte menuIdx, byte menuLine)
 //
 void ArduinoUserInterface::executeMenuItem()
 {
-  MENU_ITEM *subMenu;
-
   //
   // determine the type of menu entry, then execute it
   //
-  switch(currentMenuTable[currentMenuItemIdx].MenuItemType)
+  switch(getMenuItemType(currentMenuItemIdx))
   {    
     //
     // switch the menu to the selected sub menu
     //
     case MENU_ITEM_TYPE_SUB_MENU:
     {
-      subMenu = currentMenuTable[currentMenuItemIdx].MenuItemSubMenu;
-      selectAndDrawMenu(subMenu);
+      //
+      // remember the view of this menu so "Back" can return to it, if the stack 
+      // is full the sub menu's header is used to find its parent instead
+      //
+      if (menuNavigationDepth < MAX_MENU_NAVIGATION_DEPTH)
+      {
+        saveMenuNavigationLevel(&menuNavigationStack[menuNavigationDepth]);
+        menuNavigationDepth++;
+      }
+
+      selectAndDrawLinkedMenu(currentMenuItemIdx);
       break;
     }
     
@@ -513,240 +1117,283 @@ void ArduinoUserInterface::executeMenuItem()
       //
       // execute the menu item's function
       //
-      (currentMenuTable[currentMenuItemIdx].MenuItemFunction)();
+      callMenuItemFunction(currentMenuItemIdx);
       
       //
-      // display the menu again
+      // display the menu again with the same item selected, unless the command 
+      // started a slider that is still running, the menu is then redrawn when 
+      // the slider is done.  The redraw is left for the next tick() so the 
+      // command and a full screen aren't both done in one call
       //
-      selectAndDrawMenu(currentMenuTable);
+      if (engineState == ENGINE_MENU)
+        engineMenuRedrawPending = true;
       break;
     }
     
     //
-    // toggle the menu item, then redisplay
+    // toggle the menu item, then redisplay, unless the item opened a slider 
+    // (as the items of a settings menu do)
     //
     case MENU_ITEM_TYPE_TOGGLE:
     {
-      toggleMenuChangeStateFlag = true;
-      (currentMenuTable[currentMenuItemIdx].MenuItemFunction)();
-      drawMenuItem(currentMenuItemIdx, currentMenuItemIdx - currentMenuTopLineItemIdx);
+      getMenuToggleStateText(currentMenuItemIdx, true);
+      if (engineState == ENGINE_MENU)
+        drawMenuItem(currentMenuItemIdx, currentMenuItemIdx - currentMenuTopLineItemIdx);
     }
   }
 }
 
 
-// ---------------------------------------------------------------------------------
-//                                    Slider display  
-// ---------------------------------------------------------------------------------
 
 //
-// the Slider Display
-//	Enter:  minValue = the minimum value for the slider
-//		      maxValue = the max value for the slider
-//		      step = amount added/subtracted to the value with each button press
-//		      initialValue = initial value to display on the slider
-//		      label -> string printed above the slider
-//		      callbackFunc -> the callback function
+// record the view of the currently selected menu: the table, selected item and 
+// scroll position
+//  Enter:  menuLevel -> storage for the view
 //
-void ArduinoUserInterface::displaySlider(int minValue, int maxValue, int step, 
-                int initialValue, char *label, void (*callbackFunc)(byte, int))
+void ArduinoUserInterface::saveMenuNavigationLevel(MENU_NAVIGATION_LEVEL *menuLevel)
 {
-  byte buttonEvent;
-  int stepSize;
-  
-  //
-  // remember the slider values
-  //
-  sliderDisplayMinValue = minValue;
-  sliderDisplayMaxValue = maxValue;
-  sliderDisplayValue = initialValue;
-  sliderDisplayStep = step;
-  sliderDisplayCallbackFunc = callbackFunc;
+  menuLevel->MenuTable = currentMenuTable;
+  menuLevel->MenuTable_P = currentMenuTable_P;
+  menuLevel->VirtualMenu = currentVirtualMenu;
+  menuLevel->SettingsMenu = currentSettingsMenu;
+  menuLevel->MenuItemIdx = currentMenuItemIdx;
+  menuLevel->MenuTopLineItemIdx = currentMenuTopLineItemIdx;
+}
 
 
-  //
-  // clear the display space and move the cursor to the top line
-  //
-  clearDisplaySpace();
-  
-  
-  //
-  // draw the title of the slider, centered
-  //
-  lcdSetCursorXY(LCD_WIDTH_IN_PIXELS/2, 0); 
-  lcdPrintStringCentered(label, 0);
 
-  //
-  // draw all lines of the menu, showing one of the items as selected
-  //
-  drawSlider();
+//
+// select a menu view recorded with saveMenuNavigationLevel(), without drawing it
+//  Enter:  menuLevel -> the view to select
+//
+void ArduinoUserInterface::restoreMenuNavigationLevel(MENU_NAVIGATION_LEVEL *menuLevel)
+{
+  currentMenuTable = menuLevel->MenuTable;
+  currentMenuTable_P = menuLevel->MenuTable_P;
+  currentVirtualMenu = menuLevel->VirtualMenu;
+  currentSettingsMenu = menuLevel->SettingsMenu;
+  currentMenuItemIdx = menuLevel->MenuItemIdx;
+  currentMenuTopLineItemIdx = menuLevel->MenuTopLineItemIdx;
+}
 
-  //
-  // draw the button bar
-  //
-  drawButtonBar("Set", "Cancel");
 
-  //
-  // check for and execute button pushes
-  //
-  while(true)
-  {
-    int newSliderValue;
-    
-    //
-    // check for a new button event
-    //
-    buttonEvent = getButtonEvent();
-    switch(buttonEvent)
-    {
-      //
-      // check if the "down" button has been pressed
-      //
-      case BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT:
-        sliderDisplayRepeatCount = 0;
-      case BUTTON_ID_DOWN + BUTTON_REPEAT_EVENT:
-      {
-        sliderDisplayRepeatCount++;
-        stepSize = sliderDisplayStep * ((sliderDisplayRepeatCount / 16) + 1);
-        newSliderValue = sliderDisplayValue - stepSize;
- 
-        if (newSliderValue < sliderDisplayMinValue)
-          newSliderValue = sliderDisplayMinValue;
-          
-        if (newSliderValue == sliderDisplayValue)
-          break;
- 
-        sliderDisplayValue = newSliderValue; 
-        (*sliderDisplayCallbackFunc)(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayValue);
-        drawSlider();
-        break;
-      }
 
-      //
-      // check if the "up" button has been pressed
-      //
-      case BUTTON_ID_UP + BUTTON_PUSHED_EVENT:
-        sliderDisplayRepeatCount = 0;
-      case BUTTON_ID_UP + BUTTON_REPEAT_EVENT:
-      {
-        sliderDisplayRepeatCount++;
-        stepSize = sliderDisplayStep * ((sliderDisplayRepeatCount / 16) + 1);
-        newSliderValue = sliderDisplayValue + stepSize;
- 
-        if (newSliderValue > sliderDisplayMaxValue)
-          newSliderValue = sliderDisplayMaxValue;
-          
-        if (newSliderValue == sliderDisplayValue)
-          break;
- 
-        sliderDisplayValue = newSliderValue; 
-        (*sliderDisplayCallbackFunc)(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayValue);
-        drawSlider();
-        break;
-      }
+//
+// get an item of the currently selected virtual menu from the application, only 
+// one item is kept so the memory used doesn't depend on the number of items
+//  Enter:  menuIdx = index into the virtual menu of the item (1 = first item)
+//  Exit:   pointer to the item returned
+//
+MENU_ITEM *ArduinoUserInterface::getVirtualMenuItem(int menuIdx)
+{
+  if (menuIdx != virtualMenuItemIdx)
+  {
+    (currentVirtualMenu->GetMenuItem)(menuIdx - 1, &virtualMenuItem);
+    virtualMenuItemIdx = menuIdx;
+  }
 
-      //
-      // check if the "set" button has been pressed
-      //
-      case BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT:
-      {
-        (*sliderDisplayCallbackFunc)(SLIDER_DISPLAY_VALUE_SET, sliderDisplayValue);
-        return;
-      }
+  return(&virtualMenuItem);
+}
 
 
-      //
-      // check if the "cancel" button has been pressed
-      //
-      case BUTTON_ID_BACK + BUTTON_PUSHED_EVENT:
-      {
-        (*sliderDisplayCallbackFunc)(SLIDER_DISPLAY_CANCELED, 0);
-        return;
-      }
-    }
+
+//
+// get the type of an item in the currently selected menu
+//  Enter:  menuIdx = index into the currently selected menu of the item
+//  Exit:   MENU_ITEM_TYPE_COMMAND, MENU_ITEM_TYPE_SUB_MENU... returned
+//
+byte ArduinoUserInterface::getMenuItemType(int menuIdx)
+{
+  if (currentVirtualMenu != NULL)
+  {
+    if (menuIdx == 0)
+      return(currentVirtualMenu->MenuHeaderType);
+    if (menuIdx > currentVirtualMenu->MenuItemCount)
+      return(MENU_ITEM_TYPE_END_OF_MENU);
+    return(getVirtualMenuItem(menuIdx)->MenuItemType);
+  }
+
+  //
+  // every setting is drawn like a toggle so its value is shown, the header 
+  // acts like a main menu header that doesn't link to a parent
+  //
+  if (currentSettingsMenu != NULL)
+  {
+    if (menuIdx == 0)
+      return(MENU_ITEM_TYPE_MAIN_MENU_HEADER);
+    if (menuIdx > currentSettingsMenu->NumberOfSettings)
+      return(MENU_ITEM_TYPE_END_OF_MENU);
+    return(MENU_ITEM_TYPE_TOGGLE);
   }
+
+  if (currentMenuTable_P != NULL)
+    return(pgm_read_byte(&currentMenuTable_P[menuIdx].MenuItemType));
+  else
+    return(currentMenuTable[menuIdx].MenuItemType);
 }
 
 
-const byte SLIDER_FRAME_LINE_NUMBER = 2;
-const byte SLIDER_FRAME_LEFT_X = 0;
-const byte SLIDER_FRAME_RIGHT_X = LCD_LAST_COLUMN_X;
-const byte SLIDER_NEEDLE_PADDING_FROM_FRAME = 3;
-const byte SLIDER_NEEDLE_LEFT = SLIDER_FRAME_LEFT_X + SLIDER_NEEDLE_PADDING_FROM_FRAME;
-const long SLIDER_NEEDLE_WIDTH = (SLIDER_FRAME_RIGHT_X - SLIDER_FRAME_LEFT_X) - (2 * SLIDER_NEEDLE_PADDING_FROM_FRAME);
 
 //
-// draw the slider
+// execute the function of an item in the currently selected menu
+//  Enter:  menuIdx = index into the currently selected menu of the item
 //
-void ArduinoUserInterface::drawSlider(void)
+void ArduinoUserInterface::callMenuItemFunction(int menuIdx)
 {
-  byte needleLength;
-//  char stringBuffer[7];
-  
-  //
-  // draw the left side of the frame
-  //
-  lcdDrawRowOfPixels(SLIDER_FRAME_LEFT_X, SLIDER_FRAME_LEFT_X, SLIDER_FRAME_LINE_NUMBER, 0x7f);
-  
-  //
-  // draw right side of frame up to the beginning of the needle
-  //
-  lcdDrawRowOfPixels(SLIDER_FRAME_LEFT_X+1, SLIDER_NEEDLE_LEFT-1, SLIDER_FRAME_LINE_NUMBER, 0x41);
-  
-  //
-  // draw the needle
-  //
-  needleLength = (byte) ((((long)sliderDisplayValue - (long)sliderDisplayMinValue) * SLIDER_NEEDLE_WIDTH) / 
-    (long)(sliderDisplayMaxValue - (sliderDisplayMinValue)));
+  void (*menuItemFunction)();
+
+  if (currentSettingsMenu != NULL)
+  {
+    menuItemNumber = menuIdx - 1;
+    settingsMenuItemFunction(menuIdx - 1);
+    return;
+  }
+
+  if (currentVirtualMenu != NULL)
+    menuItemFunction = getVirtualMenuItem(menuIdx)->MenuItemFunction;
+  else if (currentMenuTable_P != NULL)
+    menuItemFunction = (void (*)()) pgm_read_ptr(&currentMenuTable_P[menuIdx].MenuItemFunction);
+  else
+    menuItemFunction = currentMenuTable[menuIdx].MenuItemFunction;
 
-  lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT, SLIDER_NEEDLE_LEFT + needleLength, SLIDER_FRAME_LINE_NUMBER, 0x5D);
-  
   //
-  // draw the frame after needle
+  // tell the function which item it's running for, 0 = the first item
   //
-  lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT + needleLength + 1, SLIDER_FRAME_RIGHT_X - 1, SLIDER_FRAME_LINE_NUMBER, 0x41);
+  menuItemNumber = menuIdx - 1;
+  (menuItemFunction)();
+}
 
+
+
+//
+// check if an item in the currently selected menu links to another menu
+//  Enter:  menuIdx = index into the currently selected menu of the item
+//  Exit:   true returned if the item's link isn't NULL
+//
+boolean ArduinoUserInterface::menuItemHasLinkedMenu(int menuIdx)
+{
   //
-  // draw the right side of the frame
+  // the header of a virtual menu doesn't link to a parent
   //
-  lcdDrawRowOfPixels(SLIDER_FRAME_RIGHT_X, SLIDER_FRAME_RIGHT_X, SLIDER_FRAME_LINE_NUMBER, 0x7f);
-  
+  if (currentVirtualMenu != NULL)
+  {
+    if (menuIdx == 0)
+      return(false);
+    return(getVirtualMenuItem(menuIdx)->MenuItemSubMenu != NULL);
+  }
+
+  if (currentSettingsMenu != NULL)
+    return(false);
+
+  if (currentMenuTable_P != NULL)
+    return(pgm_read_ptr(&currentMenuTable_P[menuIdx].MenuItemSubMenu) != NULL);
+  else
+    return(currentMenuTable[menuIdx].MenuItemSubMenu != NULL);
+}
+
+
+
+//
+// print the text of an item in the currently selected menu at the cursor
+//  Enter:  menuIdx = index into the currently selected menu of the item
+//          reverseFlag = true to print in reverse video
+//
+void ArduinoUserInterface::drawMenuItemText(int menuIdx, boolean reverseFlag)
+{
+  char *menuItemText;
+
+  if (currentSettingsMenu != NULL)
+  {
+    if (reverseFlag)
+      lcdPrintStringReverse_P(currentSettingsMenu->Settings[menuIdx - 1].Label);
+    else
+      lcdPrintString_P(currentSettingsMenu->Settings[menuIdx - 1].Label);
+    return;
+  }
+
+  if (currentMenuTable_P != NULL)
+  {
+    if (reverseFlag)
+      lcdPrintStringReverse_P(currentMenuTable_P[menuIdx].MenuItemText);
+    else
+      lcdPrintString_P(currentMenuTable_P[menuIdx].MenuItemText);
+    return;
+  }
+
+  if (currentVirtualMenu != NULL)
+    menuItemText = getVirtualMenuItem(menuIdx)->MenuItemText;
+  else
+    menuItemText = currentMenuTable[menuIdx].MenuItemText;
+
+  if (reverseFlag)
+    lcdPrintStringReverse(menuItemText);
+  else
+    lcdPrintString(menuItemText);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                    Slider display  
+// ---------------------------------------------------------------------------------
+
+const byte SLIDER_FRAME_LINE_NUMBER = 2;
+const byte SLIDER_FRAME_LEFT_X = 0;
+const byte SLIDER_FRAME_RIGHT_X = LCD_LAST_COLUMN_X;
+const byte SLIDER_NEEDLE_PADDING_FROM_FRAME = 3;
+const byte SLIDER_NEEDLE_LEFT = SLIDER_FRAME_LEFT_X + SLIDER_NEEDLE_PADDING_FROM_FRAME;
+const long SLIDER_NEEDLE_WIDTH = (SLIDER_FRAME_RIGHT_X - SLIDER_FRAME_LEFT_X) - (2 * SLIDER_NEEDLE_PADDING_FROM_FRAME);
+const byte SLIDER_NEEDLE_NOT_DRAWN = 0xff;
+const unsigned long SLIDER_DECIMAL_MAX_RANGE = 0xffffffffUL / (SLIDER_NEEDLE_WIDTH + 1);
+
+
+//
+// the Slider Display
+//	Enter:  minValue = the minimum value for the slider
+//		      maxValue = the max value for the slider
+//		      step = amount added/subtracted to the value with each button press
+//		      initialValue = initial value to display on the slider
+//		      label -> string printed above the slider
+//		      callbackFunc -> the callback function
+//
+void ArduinoUserInterface::displaySlider(int minValue, int maxValue, int step, 
+                int initialValue, char *label, void (*callbackFunc)(byte, int))
+{
   //
-  // draw the numberic value under the slider
+  // display the slider, then check for and execute button pushes until the 
+  // user presses Set or Cancel
   //
-  lcdSetCursorXY(LCD_WIDTH_IN_PIXELS/2, SLIDER_FRAME_LINE_NUMBER+1);
-  lcdPrintIntCentered(sliderDisplayValue, 6);
+  beginSlider(minValue, maxValue, step, initialValue, label, callbackFunc);
+  while(engineState == ENGINE_SLIDER)
+    tick();
 }
 
 
 
 //
-// the Float Slider Display
-//  Enter:  minValue = the minimum value for the slider
-//	        maxValue = the max value for the slider
-//	        step = amount added/subtracted to the value with each button press
-//	        initialValue = initial value to display on the slider
-//	        label -> string printed above the slider
-//          digitsRightOfDecimal = number of digits right of the decimal point 
-//            that are displayed
-//	        callbackFunc -> the callback function
+// display the Slider without waiting for the user, the application's loop() 
+// must then call tick() to process the button presses
+//	Enter:  same as displaySlider()
 //
-void ArduinoUserInterface::displayFloatSlider(float minValue, float maxValue, 
-            float step, float initialValue, char *label, byte digitsRightOfDecimal, 
-            void (*callbackFunc)(byte, float))
+void ArduinoUserInterface::beginSlider(int minValue, int maxValue, int step, 
+                int initialValue, char *label, void (*callbackFunc)(byte, int))
 {
-  byte buttonEvent;
-  float stepSize;
-
   //
   // remember the slider values
   //
-  sliderDisplayFloatMinValue = minValue;
-  sliderDisplayFloatMaxValue = maxValue;
-  sliderDisplayFloatValue = initialValue;
-  sliderDisplayFloatStep = step;
-  sliderDisplayDigitsRightOfDecimal = digitsRightOfDecimal;
-  sliderDisplayFloatCallbackFunc = callbackFunc;
+  sliderDisplayMinValue = minValue;
+  sliderDisplayMaxValue = maxValue;
+  sliderDisplayValue = initialValue;
+  sliderDisplayStep = step;
+  sliderDisplayCallbackFunc = callbackFunc;
+  sliderEditingSetting = false;
+  sliderDisplayNeedleLength = SLIDER_NEEDLE_NOT_DRAWN;
+
+  //
+  // remember what to go back to when the slider is done
+  //
+  engineStateAfterSlider = engineState;
+  engineState = ENGINE_SLIDER;
+  engineButtonEvent = &ArduinoUserInterface::sliderButtonEvent;
 
 
   //
@@ -764,90 +1411,94 @@ void ArduinoUserInterface::displayFloatSlider(float minValue, float maxValue,
   //
   // draw all lines of the menu, showing one of the items as selected
   //
-  drawFloatSlider();
+  drawSlider();
 
   //
   // draw the button bar
   //
   drawButtonBar("Set", "Cancel");
+}
 
-  //
-  // check for and execute button pushes
-  //
-  while(true)
+
+
+//
+// process one button event for the Slider
+//  Enter:  buttonEvent = the event from getButtonEvent()
+//
+void ArduinoUserInterface::sliderButtonEvent(byte buttonEvent)
+{
+  int stepSize;
+  int newSliderValue;
+
+  switch(buttonEvent)
   {
-    float newSliderFloatValue;
-    
     //
-    // check for a new button event
+    // check if the "down" button has been pressed
     //
-    buttonEvent = getButtonEvent();
-    switch(buttonEvent)
+    case BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT:
+      sliderDisplayRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_DOWN + BUTTON_REPEAT_EVENT:
     {
-      //
-      // check if the "down" button has been pressed
-      //
-      case BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT:
-        sliderDisplayRepeatCount = 0;
-      case BUTTON_ID_DOWN + BUTTON_REPEAT_EVENT:
-      {
-        sliderDisplayRepeatCount++;
-        stepSize = sliderDisplayFloatStep * ((sliderDisplayRepeatCount / 16) + 1);
-        newSliderFloatValue = sliderDisplayFloatValue - stepSize;
- 
-        if (newSliderFloatValue < sliderDisplayFloatMinValue)
-          newSliderFloatValue = sliderDisplayFloatMinValue;
-          
-        if (newSliderFloatValue == sliderDisplayFloatValue)
-          break;
- 
-        sliderDisplayFloatValue = newSliderFloatValue; 
-        (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayFloatValue);
-        drawFloatSlider();
+      sliderDisplayRepeatCount++;
+      stepSize = sliderDisplayStep * ((sliderDisplayRepeatCount / 16) + 1);
+      newSliderValue = sliderDisplayValue - stepSize;
+
+      if (newSliderValue < sliderDisplayMinValue)
+        newSliderValue = sliderDisplayMinValue;
+        
+      if (newSliderValue == sliderDisplayValue)
         break;
-      }
 
-      //
-      // check if the "up" button has been pressed
-      //
-      case BUTTON_ID_UP + BUTTON_PUSHED_EVENT:
-        sliderDisplayRepeatCount = 0;
-      case BUTTON_ID_UP + BUTTON_REPEAT_EVENT:
-      {
-        sliderDisplayRepeatCount++;
-        stepSize = sliderDisplayFloatStep * ((sliderDisplayRepeatCount / 16) + 1);
-        newSliderFloatValue = sliderDisplayFloatValue + stepSize;
- 
-        if (newSliderFloatValue > sliderDisplayFloatMaxValue)
-          newSliderFloatValue = sliderDisplayFloatMaxValue;
-          
-        if (newSliderFloatValue == sliderDisplayFloatValue)
-          break;
- 
-        sliderDisplayFloatValue = newSliderFloatValue; 
-        (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayFloatValue);
-        drawFloatSlider();
+      sliderDisplayValue = newSliderValue; 
+      sliderCallback(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayValue);
+      drawSlider();
+      break;
+    }
+
+    //
+    // check if the "up" button has been pressed
+    //
+    case BUTTON_ID_UP + BUTTON_PUSHED_EVENT:
+      sliderDisplayRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_UP + BUTTON_REPEAT_EVENT:
+    {
+      sliderDisplayRepeatCount++;
+      stepSize = sliderDisplayStep * ((sliderDisplayRepeatCount / 16) + 1);
+      newSliderValue = sliderDisplayValue + stepSize;
+
+      if (newSliderValue > sliderDisplayMaxValue)
+        newSliderValue = sliderDisplayMaxValue;
+        
+      if (newSliderValue == sliderDisplayValue)
         break;
-      }
 
-      //
-      // check if the "set" button has been pressed
-      //
-      case BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT:
-      {
-        (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_VALUE_SET, sliderDisplayFloatValue);
-        return;
-      }
+      sliderDisplayValue = newSliderValue; 
+      sliderCallback(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayValue);
+      drawSlider();
+      break;
+    }
 
+    //
+    // check if the "set" button has been pressed
+    //
+    case BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT:
+    {
+      endSlider();
+      sliderCallback(SLIDER_DISPLAY_VALUE_SET, sliderDisplayValue);
+      break;
+    }
 
-      //
-      // check if the "cancel" button has been pressed
-      //
-      case BUTTON_ID_BACK + BUTTON_PUSHED_EVENT:
-      {
-        (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_CANCELED, 0.0);
-        return;
-      }
+
+    //
+    // check if the "cancel" button has been pressed
+    //
+    case BUTTON_ID_BACK + BUTTON_PUSHED_EVENT:
+    {
+      endSlider();
+      sliderCallback(SLIDER_DISPLAY_CANCELED, 0);
+      break;
     }
   }
 }
@@ -855,1273 +1506,3965 @@ void ArduinoUserInterface::displayFloatSlider(float minValue, float maxValue,
 
 
 //
-// draw the slider
+// finish with a slider, returning to what was running when it was started
 //
-void ArduinoUserInterface::drawFloatSlider(void)
+void ArduinoUserInterface::endSlider(void)
 {
-  byte needleLength;
-  char stringBuffer[10];
-  
-  //
-  // draw the left side of the frame
-  //
-  lcdDrawRowOfPixels(SLIDER_FRAME_LEFT_X, SLIDER_FRAME_LEFT_X, SLIDER_FRAME_LINE_NUMBER, 0x7f);
-  
-  //
-  // draw right side of frame up to the beginning of the needle
-  //
-  lcdDrawRowOfPixels(SLIDER_FRAME_LEFT_X+1, SLIDER_NEEDLE_LEFT-1, SLIDER_FRAME_LINE_NUMBER, 0x41);
-  
-  //
-  // draw the needle
-  //
-  needleLength = (byte) ((((sliderDisplayFloatValue - sliderDisplayFloatMinValue) * (float)SLIDER_NEEDLE_WIDTH) / 
-    (sliderDisplayFloatMaxValue - sliderDisplayFloatMinValue)) + 0.5);
-
-  lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT, SLIDER_NEEDLE_LEFT + needleLength, SLIDER_FRAME_LINE_NUMBER, 0x5D);
-  
-  //
-  // draw the frame after needle
-  //
-  lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT + needleLength + 1, SLIDER_FRAME_RIGHT_X - 1, SLIDER_FRAME_LINE_NUMBER, 0x41);
+  engineState = engineStateAfterSlider;
 
   //
-  // draw the right side of the frame
+  // if the slider was started from a menu, the menu needs redrawing
   //
-  lcdDrawRowOfPixels(SLIDER_FRAME_RIGHT_X, SLIDER_FRAME_RIGHT_X, SLIDER_FRAME_LINE_NUMBER, 0x7f);
-  
-  //
-  // draw the numberic value under the slider
-  //
-  lcdSetCursorXY(LCD_WIDTH_IN_PIXELS/2, SLIDER_FRAME_LINE_NUMBER+1);
-  dtostrf(sliderDisplayFloatValue, 1, sliderDisplayDigitsRightOfDecimal, stringBuffer);
-  lcdPrintStringCentered(stringBuffer, 12);
+  if (engineState == ENGINE_MENU)
+  {
+    engineButtonEvent = &ArduinoUserInterface::menuButtonEvent;
+    engineMenuRedrawPending = true;
+  }
 }
 
 
-// ---------------------------------------------------------------------------------
-//                            General display space functions  
-// ---------------------------------------------------------------------------------
 
 //
-// clear the LCD "display space" the 5 lines above the button bar
+// tell the owner of the slider about a change, either the application's 
+// callback or the settings menu that opened the slider
+//  Enter:  operation = SLIDER_DISPLAY_VALUE_CHANGED, SLIDER_DISPLAY_VALUE_SET...
+//          value = value from the slider
 //
-void ArduinoUserInterface::clearDisplaySpace(void)
+void ArduinoUserInterface::sliderCallback(byte operation, int value)
 {
-  int characterColumn;
- 
-  //
-  // write enough blank pixels to clear the display
-  //
-  lcdSetCursorXY(0, 0);          
-  for (characterColumn = 0; characterColumn < LCD_WIDTH_IN_PIXELS * (LCD_HEIGHT_IN_LINES - 1); characterColumn++)
-    lcdWriteData(0x00);
-  
-  //
-  // move cursor to the beginning
-  //
-  lcdSetCursorXY(0, 0);          
+  if (sliderEditingSetting)
+    settingsSliderEvent(operation, value);
+  else
+    (*sliderDisplayCallbackFunc)(operation, value);
 }
 
 
-// ---------------------------------------------------------------------------------
-//                                  ButtonBar functions  
-// ---------------------------------------------------------------------------------
 
 //
-// values for: buttonsState
+// draw the slider
 //
-const byte WAITING_FOR_BUTTON_DOWN_STATE                 = 0;
-const byte CONFIRM_BUTTON_DOWN_STATE                     = 1;
-const byte WAITING_FOR_BUTTON_UP_STATE                   = 2;
-const byte WAITING_FOR_BUTTON_UP_AFTER_AUTO_REPEAT_STATE = 3;
-const byte WAITING_FOR_ALL_BUTTONS_UP_STATE              = 4;
-const byte CONFIRM_ALL_BUTTONS_UP_STATE                  = 5;
+void ArduinoUserInterface::drawSlider(void)
+{
+  byte needleLength;
+  char stringBuffer[7];
+  
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_DRAW_SLIDER);
+
+  //
+  // determine the length of the needle
+  //
+  needleLength = (byte) ((((long)sliderDisplayValue - (long)sliderDisplayMinValue) * SLIDER_NEEDLE_WIDTH) / 
+    (long)(sliderDisplayMaxValue - (sliderDisplayMinValue)));
 
+  //
+  // draw the needle and the numeric value under the slider
+  //
+  itoa(sliderDisplayValue, stringBuffer, 10);
+  drawSliderNeedleAndValue(needleLength, stringBuffer, 6);
+}
 
-//
-// delay periods for dealing with buttons in milliseconds
-//
-const long BUTTON_DEBOUNCE_PERIOD = 30;
-const long BUTTON_AUTO_REPEAT_DELAY = 800;
-const long BUTTON_AUTO_REPEAT_RATE = 130;
 
 
 //
-// size and position constants
+// draw the needle of a slider along with its value, only the parts that  
+// changed since the last time the slider was drawn are sent to the LCD
+//  Enter:  needleLength = length of the needle in pixels
+//          valueText -> the value to display under the slider
+//          padToNumberOfCharacters = width of the value's field in characters
+//          sliderDisplayNeedleLength = the needle length last drawn, or 
+//            SLIDER_NEEDLE_NOT_DRAWN to draw the whole slider
 //
-const byte BUTTON_WIDTH = 39;
-const byte LEFT_BUTTON_CENTER_X = 20;
-const byte RIGHT_BUTTON_CENTER_X = 65;
+void ArduinoUserInterface::drawSliderNeedleAndValue(byte needleLength, 
+                              char *valueText, byte padToNumberOfCharacters)
+{
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_UPDATE_SLIDER);
 
+  if (sliderDisplayNeedleLength == SLIDER_NEEDLE_NOT_DRAWN)
+  {
+    //
+    // draw the left side of the frame
+    //
+    lcdDrawRowOfPixels(SLIDER_FRAME_LEFT_X, SLIDER_FRAME_LEFT_X, SLIDER_FRAME_LINE_NUMBER, 0x7f);
+    
+    //
+    // draw right side of frame up to the beginning of the needle
+    //
+    lcdDrawRowOfPixels(SLIDER_FRAME_LEFT_X+1, SLIDER_NEEDLE_LEFT-1, SLIDER_FRAME_LINE_NUMBER, 0x41);
+    
+    //
+    // draw the needle
+    //
+    lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT, SLIDER_NEEDLE_LEFT + needleLength, SLIDER_FRAME_LINE_NUMBER, 0x5D);
+    
+    //
+    // draw the frame after needle
+    //
+    lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT + needleLength + 1, SLIDER_FRAME_RIGHT_X - 1, SLIDER_FRAME_LINE_NUMBER, 0x41);
+
+    //
+    // draw the right side of the frame
+    //
+    lcdDrawRowOfPixels(SLIDER_FRAME_RIGHT_X, SLIDER_FRAME_RIGHT_X, SLIDER_FRAME_LINE_NUMBER, 0x7f);
+
+    sliderDisplayValueText[0] = 0;
+  }
+
+  //
+  // the needle got longer, only draw the added part
+  //
+  else if (needleLength > sliderDisplayNeedleLength)
+  {
+    lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT + sliderDisplayNeedleLength + 1, 
+      SLIDER_NEEDLE_LEFT + needleLength, SLIDER_FRAME_LINE_NUMBER, 0x5D);
+  }
+
+  //
+  // the needle got shorter, only draw the frame where the needle was
+  //
+  else if (needleLength < sliderDisplayNeedleLength)
+  {
+    lcdDrawRowOfPixels(SLIDER_NEEDLE_LEFT + needleLength + 1, 
+      SLIDER_NEEDLE_LEFT + sliderDisplayNeedleLength, SLIDER_FRAME_LINE_NUMBER, 0x41);
+  }
+
+  sliderDisplayNeedleLength = needleLength;
+
+  //
+  // draw the numeric value under the slider if its text has changed
+  //
+  if (strcmp(valueText, sliderDisplayValueText) != 0)
+  {
+    lcdSetCursorXY(LCD_WIDTH_IN_PIXELS/2, SLIDER_FRAME_LINE_NUMBER+1);
+    lcdPrintStringCentered(valueText, padToNumberOfCharacters);
+    strncpy(sliderDisplayValueText, valueText, sizeof(sliderDisplayValueText) - 1);
+    sliderDisplayValueText[sizeof(sliderDisplayValueText) - 1] = 0;
+  }
+}
 
-// ---------------------------------------------------------------------------------
 
 
 //
-// initialize the buttons
+// the Float Slider Display
+//  Enter:  minValue = the minimum value for the slider
+//	        maxValue = the max value for the slider
+//	        step = amount added/subtracted to the value with each button press
+//	        initialValue = initial value to display on the slider
+//	        label -> string printed above the slider
+//          digitsRightOfDecimal = number of digits right of the decimal point 
+//            that are displayed
+//	        callbackFunc -> the callback function
 //
-void ArduinoUserInterface::buttonsInitialize(void)
+void ArduinoUserInterface::displayFloatSlider(float minValue, float maxValue, 
+            float step, float initialValue, char *label, byte digitsRightOfDecimal, 
+            void (*callbackFunc)(byte, float))
 {
-  buttonState = WAITING_FOR_BUTTON_DOWN_STATE;
+  //
+  // display the slider, then check for and execute button pushes until the 
+  // user presses Set or Cancel
+  //
+  beginFloatSlider(minValue, maxValue, step, initialValue, label, digitsRightOfDecimal, callbackFunc);
+  while(engineState == ENGINE_FLOAT_SLIDER)
+    tick();
 }
 
 
 
 //
-// check for an event from any of the push buttons
-//   Exit:  event value returned (sum of the button ID + the button event)
-//           BUTTON_NO_EVENT returned if no event
+// display the Float Slider without waiting for the user, the application's 
+// loop() must then call tick() to process the button presses
+//  Enter:  same as displayFloatSlider()
 //
-byte ArduinoUserInterface::getButtonEvent(void)
+void ArduinoUserInterface::beginFloatSlider(float minValue, float maxValue, 
+            float step, float initialValue, char *label, byte digitsRightOfDecimal, 
+            void (*callbackFunc)(byte, float))
 {
-  byte currentButtonID;
-  unsigned long currentTime;
-
+  //
+  // remember the slider values
+  //
+  sliderDisplayFloatMinValue = minValue;
+  sliderDisplayFloatMaxValue = maxValue;
+  sliderDisplayFloatValue = initialValue;
+  sliderDisplayFloatStep = step;
+  sliderDisplayDigitsRightOfDecimal = digitsRightOfDecimal;
+  sliderDisplayFloatCallbackFunc = callbackFunc;
+  sliderEditingSetting = false;
+  sliderDisplayNeedleLength = SLIDER_NEEDLE_NOT_DRAWN;
 
   //
-  // check if no button is press now and no button has been pressed for a while
+  // remember what to go back to when the slider is done
   //
-  currentButtonID = readButtonsToGetButtonID();
-  if ((buttonState == WAITING_FOR_BUTTON_DOWN_STATE) && (currentButtonID == BUTTON_ID_NONE))
-    return(BUTTON_NO_EVENT);                       // nothing pressed, return no event
+  engineStateAfterSlider = engineState;
+  engineState = ENGINE_FLOAT_SLIDER;
+  engineButtonEvent = &ArduinoUserInterface::floatSliderButtonEvent;
 
 
   //
-  // something is going on, read the time
+  // clear the display space and move the cursor to the top line
   //
-  currentTime = millis();   
-
+  clearDisplaySpace();
+  
   
   //
-  // check the state that the button was in last
+  // draw the title of the slider, centered
   //
-  switch(buttonState)
-  {
-    //
-    // check if waiting for button to go down
-    //
-    case WAITING_FOR_BUTTON_DOWN_STATE:
-    {
-      //
-      // a button has been pressed, remember it
-      //
-      buttonID = currentButtonID;
-      buttonState = CONFIRM_BUTTON_DOWN_STATE;
-      buttonEventStartTime = currentTime;
-      break;                                          // return no event now
-     } 
+  lcdSetCursorXY(LCD_WIDTH_IN_PIXELS/2, 0); 
+  lcdPrintStringCentered(label, 0);
 
+  //
+  // draw all lines of the menu, showing one of the items as selected
+  //
+  drawFloatSlider();
+
+  //
+  // draw the button bar
+  //
+  drawButtonBar("Set", "Cancel");
+}
 
-    //
-    // we think a button has been press, let's double check
-    //
-    case CONFIRM_BUTTON_DOWN_STATE:
-    {
-      if (currentTime < (buttonEventStartTime + BUTTON_DEBOUNCE_PERIOD))
-        break;                                        // wait until debounce period complete
-  
-      //
-      // make sure the same button is pressed, as was pressed before
-      //
-      if (currentButtonID != buttonID)
-      {
-        buttonState = WAITING_FOR_BUTTON_DOWN_STATE;  // not the same button, start over
-        break;                                        // return no event
-      }
 
-      //
-      // a button has been pressed
-      //
-      buttonEventStartTime = currentTime;             // start auto repeat timer
-      buttonState = WAITING_FOR_BUTTON_UP_STATE;  
-      return(BUTTON_PUSHED_EVENT + buttonID);         // return button "pressed" event
-    }
 
+//
+// process one button event for the Float Slider
+//  Enter:  buttonEvent = the event from getButtonEvent()
+//
+void ArduinoUserInterface::floatSliderButtonEvent(byte buttonEvent)
+{
+  float stepSize;
+  float newSliderFloatValue;
 
+  switch(buttonEvent)
+  {
     //
-    // check if waiting for button to go back up
-    //      
-    case WAITING_FOR_BUTTON_UP_STATE:
+    // check if the "down" button has been pressed
+    //
+    case BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT:
+      sliderDisplayRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_DOWN + BUTTON_REPEAT_EVENT:
     {
-      //
-      // button has been down, check if it is still down
-      //
-      if (currentButtonID != buttonID)
-      {
-        //
-        // nothing pressed now or not the same button pressed, go wait for all buttons up
-        //
-        buttonState = WAITING_FOR_ALL_BUTTONS_UP_STATE;
-        break;                                   // return no event
-      }
-      
-      //
-      // the button is still down, check if time to auto repeat
-      //
-      if (currentTime < (buttonEventStartTime + BUTTON_AUTO_REPEAT_DELAY))
-        break;                                   // no, return no event
-                                           
-      buttonEventStartTime = currentTime;        // yes auto repeat, reset auto repeat timer
-      buttonState = WAITING_FOR_BUTTON_UP_AFTER_AUTO_REPEAT_STATE;
-      return(BUTTON_REPEAT_EVENT + buttonID);    // return button "auto repeat" event
+      sliderDisplayRepeatCount++;
+      stepSize = sliderDisplayFloatStep * ((sliderDisplayRepeatCount / 16) + 1);
+      newSliderFloatValue = sliderDisplayFloatValue - stepSize;
+
+      if (newSliderFloatValue < sliderDisplayFloatMinValue)
+        newSliderFloatValue = sliderDisplayFloatMinValue;
+        
+      if (newSliderFloatValue == sliderDisplayFloatValue)
+        break;
+
+      sliderDisplayFloatValue = newSliderFloatValue; 
+      (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayFloatValue);
+      drawFloatSlider();
+      break;
     }
-     
 
     //
-    // check if waiting for button to repeat
+    // check if the "up" button has been pressed
     //
-    case WAITING_FOR_BUTTON_UP_AFTER_AUTO_REPEAT_STATE:
+    case BUTTON_ID_UP + BUTTON_PUSHED_EVENT:
+      sliderDisplayRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_UP + BUTTON_REPEAT_EVENT:
     {
-      //
-      // button has been down & auto repeat started, check if it is still down
-      //
-      if (currentButtonID != buttonID)
-      {
-        //
-        // nothing pressed now or not the same button pressed, go wait for all buttons up
-        //
-        buttonState = WAITING_FOR_ALL_BUTTONS_UP_STATE;
+      sliderDisplayRepeatCount++;
+      stepSize = sliderDisplayFloatStep * ((sliderDisplayRepeatCount / 16) + 1);
+      newSliderFloatValue = sliderDisplayFloatValue + stepSize;
+
+      if (newSliderFloatValue > sliderDisplayFloatMaxValue)
+        newSliderFloatValue = sliderDisplayFloatMaxValue;
+        
+      if (newSliderFloatValue == sliderDisplayFloatValue)
         break;
-      }
- 
-      //
-      // button is still down, check if time to auto repeat
-      //
-      if (currentTime < (buttonEventStartTime + BUTTON_AUTO_REPEAT_RATE))
-        break;                                        // return no event
-                                           
-      buttonEventStartTime = currentTime;             // yes, auto repeat, reset auto repeat timer
-      return(BUTTON_REPEAT_EVENT + buttonID);         // return button "auto repeat" event
+
+      sliderDisplayFloatValue = newSliderFloatValue; 
+      (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayFloatValue);
+      drawFloatSlider();
+      break;
     }
-    
 
     //
-    // check if all the buttons are up now
+    // check if the "set" button has been pressed
     //
-    case WAITING_FOR_ALL_BUTTONS_UP_STATE:
+    case BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT:
     {
-      //
-      // check if the button is up
-      //
-      if (currentButtonID != BUTTON_ID_NONE)
-        break;                                         // all buttons not up, return no event
-      
-      //
-      // the button is up
-      //
-      buttonState = CONFIRM_ALL_BUTTONS_UP_STATE;
-      buttonEventStartTime = currentTime;
-      break;                                           // return no event now
+      endSlider();
+      (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_VALUE_SET, sliderDisplayFloatValue);
+      break;
     }
 
 
     //
-    // verify all buttons still up
+    // check if the "cancel" button has been pressed
     //
-    case CONFIRM_ALL_BUTTONS_UP_STATE:
+    case BUTTON_ID_BACK + BUTTON_PUSHED_EVENT:
     {
-      if (currentTime < (buttonEventStartTime + BUTTON_DEBOUNCE_PERIOD))
-        break;                                           // delay period not up, return no event
+      endSlider();
+      (*sliderDisplayFloatCallbackFunc)(SLIDER_DISPLAY_CANCELED, 0.0);
+      break;
+    }
+  }
+}
+
+
+
+//
+// draw the float slider
+//
+void ArduinoUserInterface::drawFloatSlider(void)
+{
+  byte needleLength;
+  char stringBuffer[13];
   
-      //
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_DRAW_SLIDER);
+
+  //
+  // determine the length of the needle
+  //
+  needleLength = (byte) ((((sliderDisplayFloatValue - sliderDisplayFloatMinValue) * (float)SLIDER_NEEDLE_WIDTH) / 
+    (sliderDisplayFloatMaxValue - sliderDisplayFloatMinValue)) + 0.5);
+
+  //
+  // draw the needle and the numeric value under the slider
+  //
+  dtostrf(sliderDisplayFloatValue, 1, sliderDisplayDigitsRightOfDecimal, stringBuffer);
+  drawSliderNeedleAndValue(needleLength, stringBuffer, 12);
+}
+
+
+
+//
+// the Decimal Slider Display, a fixed point slider that works like the Float 
+// Slider using only integer math.  Values are given times 10 to the power of 
+// digitsRightOfDecimal, so with 2 digits 150 is displayed as 1.50.  Steps are 
+// exact, so repeated steps don't drift as floats do
+//  Enter:  minValue = the minimum value for the slider
+//	        maxValue = the max value for the slider
+//	        step = amount added/subtracted to the value with each button press
+//	        initialValue = initial value to display on the slider
+//	        label -> string printed above the slider
+//          digitsRightOfDecimal = number of digits right of the decimal point 
+//            (0 - 4)
+//	        callbackFunc -> the callback function
+//
+void ArduinoUserInterface::displayDecimalSlider(long minValue, long maxValue, 
+            long step, long initialValue, char *label, byte digitsRightOfDecimal, 
+            void (*callbackFunc)(byte, long))
+{
+  //
+  // display the slider, then check for and execute button pushes until the 
+  // user presses Set or Cancel
+  //
+  beginDecimalSlider(minValue, maxValue, step, initialValue, label, digitsRightOfDecimal, callbackFunc);
+  while(engineState == ENGINE_DECIMAL_SLIDER)
+    tick();
+}
+
+
+
+//
+// display the Decimal Slider without waiting for the user, the application's 
+// loop() must then call tick() to process the button presses
+//  Enter:  same as displayDecimalSlider()
+//
+void ArduinoUserInterface::beginDecimalSlider(long minValue, long maxValue, 
+            long step, long initialValue, char *label, byte digitsRightOfDecimal, 
+            void (*callbackFunc)(byte, long))
+{
+  //
+  // remember the slider values
+  //
+  sliderDisplayDecimalMinValue = minValue;
+  sliderDisplayDecimalMaxValue = maxValue;
+  sliderDisplayDecimalValue = initialValue;
+  sliderDisplayDecimalStep = step;
+  sliderDisplayDigitsRightOfDecimal = digitsRightOfDecimal;
+  sliderDisplayDecimalCallbackFunc = callbackFunc;
+  sliderEditingSetting = false;
+  sliderDisplayNeedleLength = SLIDER_NEEDLE_NOT_DRAWN;
+
+  //
+  // remember what to go back to when the slider is done
+  //
+  engineStateAfterSlider = engineState;
+  engineState = ENGINE_DECIMAL_SLIDER;
+  engineButtonEvent = &ArduinoUserInterface::decimalSliderButtonEvent;
+
+
+  //
+  // clear the display space and move the cursor to the top line
+  //
+  clearDisplaySpace();
+  
+  
+  //
+  // draw the title of the slider, centered
+  //
+  lcdSetCursorXY(LCD_WIDTH_IN_PIXELS/2, 0); 
+  lcdPrintStringCentered(label, 0);
+
+  //
+  // draw the slider and its value
+  //
+  drawDecimalSlider();
+
+  //
+  // draw the button bar
+  //
+  drawButtonBar("Set", "Cancel");
+}
+
+
+
+//
+// process one button event for the Decimal Slider
+//  Enter:  buttonEvent = the event from getButtonEvent()
+//
+void ArduinoUserInterface::decimalSliderButtonEvent(byte buttonEvent)
+{
+  long stepSize;
+  long newSliderValue;
+
+  switch(buttonEvent)
+  {
+    //
+    // check if the "down" button has been pressed
+    //
+    case BUTTON_ID_DOWN + BUTTON_PUSHED_EVENT:
+      sliderDisplayRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_DOWN + BUTTON_REPEAT_EVENT:
+    {
+      sliderDisplayRepeatCount++;
+      stepSize = sliderDisplayDecimalStep * ((sliderDisplayRepeatCount / 16) + 1);
+      newSliderValue = sliderDisplayDecimalValue - stepSize;
+
+      if (newSliderValue < sliderDisplayDecimalMinValue)
+        newSliderValue = sliderDisplayDecimalMinValue;
+        
+      if (newSliderValue == sliderDisplayDecimalValue)
+        break;
+
+      sliderDisplayDecimalValue = newSliderValue; 
+      decimalSliderCallback(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayDecimalValue);
+      drawDecimalSlider();
+      break;
+    }
+
+    //
+    // check if the "up" button has been pressed
+    //
+    case BUTTON_ID_UP + BUTTON_PUSHED_EVENT:
+      sliderDisplayRepeatCount = 0;
+      // fall through
+    case BUTTON_ID_UP + BUTTON_REPEAT_EVENT:
+    {
+      sliderDisplayRepeatCount++;
+      stepSize = sliderDisplayDecimalStep * ((sliderDisplayRepeatCount / 16) + 1);
+      newSliderValue = sliderDisplayDecimalValue + stepSize;
+
+      if (newSliderValue > sliderDisplayDecimalMaxValue)
+        newSliderValue = sliderDisplayDecimalMaxValue;
+        
+      if (newSliderValue == sliderDisplayDecimalValue)
+        break;
+
+      sliderDisplayDecimalValue = newSliderValue; 
+      decimalSliderCallback(SLIDER_DISPLAY_VALUE_CHANGED, sliderDisplayDecimalValue);
+      drawDecimalSlider();
+      break;
+    }
+
+    //
+    // check if the "set" button has been pressed
+    //
+    case BUTTON_ID_SELECT + BUTTON_PUSHED_EVENT:
+    {
+      endSlider();
+      decimalSliderCallback(SLIDER_DISPLAY_VALUE_SET, sliderDisplayDecimalValue);
+      break;
+    }
+
+
+    //
+    // check if the "cancel" button has been pressed
+    //
+    case BUTTON_ID_BACK + BUTTON_PUSHED_EVENT:
+    {
+      endSlider();
+      decimalSliderCallback(SLIDER_DISPLAY_CANCELED, 0);
+      break;
+    }
+  }
+}
+
+
+
+//
+// tell the owner of the decimal slider about a change, either the 
+// application's callback or the settings menu that opened the slider
+//  Enter:  operation = SLIDER_DISPLAY_VALUE_CHANGED, SLIDER_DISPLAY_VALUE_SET...
+//          value = value from the slider
+//
+void ArduinoUserInterface::decimalSliderCallback(byte operation, long value)
+{
+  if (sliderEditingSetting)
+    settingsSliderEvent(operation, value);
+  else
+    (*sliderDisplayDecimalCallbackFunc)(operation, value);
+}
+
+
+
+//
+// draw the decimal slider, rounding the needle's length the same way as the 
+// float slider
+//
+void ArduinoUserInterface::drawDecimalSlider(void)
+{
+  byte needleLength;
+  unsigned long range;
+  unsigned long offset;
+  char stringBuffer[13];
+  
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_DRAW_SLIDER);
+
+  //
+  // determine the length of the needle, large ranges are scaled down so the 
+  // multiply can't overflow
+  //
+  range = (unsigned long) (sliderDisplayDecimalMaxValue - sliderDisplayDecimalMinValue);
+  offset = (unsigned long) (sliderDisplayDecimalValue - sliderDisplayDecimalMinValue);
+  while(range > SLIDER_DECIMAL_MAX_RANGE)
+  {
+    range = range >> 1;
+    offset = offset >> 1;
+  }
+
+  needleLength = (byte) (((offset * SLIDER_NEEDLE_WIDTH) + (range / 2)) / range);
+
+  //
+  // draw the needle and the numeric value under the slider
+  //
+  formatDecimalValue(sliderDisplayDecimalValue, sliderDisplayDigitsRightOfDecimal, stringBuffer);
+  drawSliderNeedleAndValue(needleLength, stringBuffer, 12);
+}
+
+
+
+//
+// format a fixed point value as text using only integer math, with a decimal 
+// point if it has digits right of the decimal
+//  Enter:  value = the value times 10 to the power of digitsRightOfDecimal
+//          digitsRightOfDecimal = number of digits right of the decimal point
+//          buffer -> storage for the text, 13 bytes
+//
+void ArduinoUserInterface::formatDecimalValue(long value, byte digitsRightOfDecimal, char *buffer)
+{
+  unsigned long magnitude;
+  unsigned long scale;
+  unsigned long fraction;
+  byte i;
+
+  if (value < 0)
+  {
+    *buffer++ = '-';
+    magnitude = -(unsigned long) value;
+  }
+  else
+    magnitude = value;
+
+  scale = 1;
+  for (i = 0; i < digitsRightOfDecimal; i++)
+    scale *= 10;
+
+  //
+  // print the whole part, then the digits right of the decimal point
+  //
+  ultoa(magnitude / scale, buffer, 10);
+  if (digitsRightOfDecimal == 0)
+    return;
+
+  buffer += strlen(buffer);
+  *buffer++ = '.';
+
+  fraction = magnitude % scale;
+  for (i = digitsRightOfDecimal; i > 0; i--)
+  {
+    buffer[i - 1] = '0' + (fraction % 10);
+    fraction = fraction / 10;
+  }
+  buffer[digitsRightOfDecimal] = 0;
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                    Settings menus  
+// ---------------------------------------------------------------------------------
+
+//
+// run an item of the settings menu: get the text showing its value, change a 
+// toggle, or open the setting's slider.  This is called by the menu engine in 
+// place of a toggle's callback
+//  Enter:  settingNumber = index into the settings table (0 = first setting)
+//          toggleMenuChangeStateFlag = true if the item was selected
+//  Exit:   toggleMenuStateText -> text showing the setting's value
+//
+void ArduinoUserInterface::settingsMenuItemFunction(int settingNumber)
+{
+  const SETTING_ITEM *setting;
+  long value;
+
+  settingsValueText[0] = 0;
+  toggleMenuStateText = settingsValueText;
+  if (configSchema == NULL)
+    return;
+
+  //
+  // drawing the item only reads the setting from flash, the whole setting is 
+  // copied to settingsEditItem only when it's selected, since the slider's 
+  // events use it after this returns
+  //
+  setting = &currentSettingsMenu->Settings[settingNumber];
+  value = configGetField(pgm_read_word(&setting->FieldOffset), pgm_read_byte(&setting->FieldSize));
+
+  if (toggleMenuChangeStateFlag)
+  {
+    memcpy_P(&settingsEditItem, setting, sizeof(SETTING_ITEM));
+
+    //
+    // step a toggle to its next value, wrapping back to the first, then save it
+    //
+    if (settingsEditItem.SettingType == SETTING_TYPE_TOGGLE)
+    {
+      value += settingsEditItem.Step;
+      if ((value > settingsEditItem.MaxValue) || (value < settingsEditItem.MinValue))
+        value = settingsEditItem.MinValue;
+
+      configSetField(settingsEditItem.FieldOffset, settingsEditItem.FieldSize, value);
+      saveConfiguration();
+      if (currentSettingsMenu->SettingChanged != NULL)
+        (currentSettingsMenu->SettingChanged)(settingNumber, SLIDER_DISPLAY_VALUE_SET);
+    }
+
+    //
+    // open the slider for a number, the menu is redrawn when it's done
+    //
+    else
+    {
+      settingsEditNumber = settingNumber;
+      settingsOriginalValue = value;
+
+      if (settingsEditItem.SettingType == SETTING_TYPE_DECIMAL)
+        beginDecimalSlider(settingsEditItem.MinValue, settingsEditItem.MaxValue, 
+          settingsEditItem.Step, value, settingsEditItem.Label, 
+          settingsEditItem.DigitsRightOfDecimal, NULL);
+      else
+        beginSlider((int) settingsEditItem.MinValue, (int) settingsEditItem.MaxValue, 
+          (int) settingsEditItem.Step, (int) value, settingsEditItem.Label, NULL);
+
+      sliderEditingSetting = true;
+    }
+  }
+
+  //
+  // return the text for the value, a 0 - 1 toggle is Off / On
+  //
+  if ((pgm_read_byte(&setting->SettingType) == SETTING_TYPE_TOGGLE) && 
+    ((long) pgm_read_dword(&setting->MinValue) == 0) && 
+    ((long) pgm_read_dword(&setting->MaxValue) == 1))
+  {
+    toggleMenuStateText = (value != 0) ? (char *) "On" : (char *) "Off";
+    return;
+  }
+
+  formatDecimalValue(value, pgm_read_byte(&setting->DigitsRightOfDecimal), settingsValueText);
+}
+
+
+
+//
+// process a change from the slider opened by the settings menu, the field is 
+// changed as the slider moves so the application can use the new value right 
+// away, then it's saved when Set is pressed or restored when Cancel is pressed
+//  Enter:  operation = SLIDER_DISPLAY_VALUE_CHANGED, SLIDER_DISPLAY_VALUE_SET...
+//          value = value from the slider, in the form the field holds
+//
+void ArduinoUserInterface::settingsSliderEvent(byte operation, long value)
+{
+  if (operation == SLIDER_DISPLAY_CANCELED)
+    value = settingsOriginalValue;
+
+  configSetField(settingsEditItem.FieldOffset, settingsEditItem.FieldSize, value);
+
+  if (operation == SLIDER_DISPLAY_VALUE_SET)
+    saveConfiguration();
+
+  if (operation != SLIDER_DISPLAY_VALUE_CHANGED)
+    sliderEditingSetting = false;
+
+  if (currentSettingsMenu->SettingChanged != NULL)
+    (currentSettingsMenu->SettingChanged)(settingsEditNumber, operation);
+}
+
+
+
+// ---------------------------------------------------------------------------------
+//                            General display space functions  
+// ---------------------------------------------------------------------------------
+
+//
+// clear the LCD "display space" the 5 lines above the button bar
+//
+void ArduinoUserInterface::clearDisplaySpace(void)
+{
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_CLEAR_DISPLAY_SPACE);
+
+  //
+  // write enough blank pixels to clear the display
+  //
+  lcdSetCursorXY(0, 0);          
+  lcdWriteDataFill(0x00, LCD_WIDTH_IN_PIXELS * (LCD_HEIGHT_IN_LINES - 1));
+  
+  //
+  // move cursor to the beginning
+  //
+  lcdSetCursorXY(0, 0);          
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                  ButtonBar functions  
+// ---------------------------------------------------------------------------------
+
+//
+// values for: buttonsState
+//
+const byte WAITING_FOR_BUTTON_DOWN_STATE                 = 0;
+const byte CONFIRM_BUTTON_DOWN_STATE                     = 1;
+const byte WAITING_FOR_BUTTON_UP_STATE                   = 2;
+const byte WAITING_FOR_BUTTON_UP_AFTER_AUTO_REPEAT_STATE = 3;
+const byte WAITING_FOR_ALL_BUTTONS_UP_STATE              = 4;
+const byte CONFIRM_ALL_BUTTONS_UP_STATE                  = 5;
+
+
+//
+// delay periods for dealing with buttons in milliseconds
+//
+const long BUTTON_DEBOUNCE_PERIOD = 30;
+const long BUTTON_AUTO_REPEAT_DELAY = 800;
+const long BUTTON_AUTO_REPEAT_RATE = 130;
+
+
+//
+// size and position constants
+//
+const byte BUTTON_WIDTH = 39;
+const byte LEFT_BUTTON_CENTER_X = 20;
+const byte RIGHT_BUTTON_CENTER_X = 65;
+
+
+//
+// the resistor ladder on the Arduino UI Shield, and its lookup table
+//
+constexpr BUTTON_LADDER_STEP defaultButtonLadder[] = {
+  {BUTTON_ID_DOWN,   (int) (1024.0 * 0.658) - 40, (int) (1024.0 * 0.658) + 40},
+  {BUTTON_ID_UP,     (int) (1024.0 * 0.476) - 40, (int) (1024.0 * 0.476) + 40},
+  {BUTTON_ID_BACK,   (int) (1024.0 * 0.312) - 40, (int) (1024.0 * 0.312) + 40},
+  {BUTTON_ID_SELECT, 0, 80}
+};
+
+BUTTON_LADDER_LOOKUP_TABLE(defaultButtonLadderTable, defaultButtonLadder);
+
+
+// ---------------------------------------------------------------------------------
+
+
+//
+// initialize the buttons
+//
+void ArduinoUserInterface::buttonsInitialize(void)
+{
+  buttonState = WAITING_FOR_BUTTON_DOWN_STATE;
+  buttonSamplingFromInterrupt = false;
+  buttonEventQueueDroppedCount = 0;
+  buttonADCSplitPhase = false;
+  buttonLadderTable = defaultButtonLadderTable;
+}
+
+
+
+//
+// select the table used to find which button is pressed from the voltage on 
+// the resistor ladder, this is only needed for ladders other than the one on 
+// the Arduino UI Shield
+//  Enter:  ladderLookupTable -> PROGMEM table built with 
+//            BUTTON_LADDER_LOOKUP_TABLE()
+//
+void ArduinoUserInterface::buttonsSetLadderTable(const byte *ladderLookupTable)
+{
+  buttonLadderTable = ladderLookupTable;
+}
+
+
+
+//
+// read the buttons with split phase ADC conversions rather than analogRead(), 
+// analogRead() waits about 110uS for each conversion.  In split phase mode, 
+// reading the buttons starts a conversion and immediately returns the result of 
+// the previous one, so polling the buttons takes only a few microseconds.  The 
+// button ID is one sample late, which the debounce hides.  This is only 
+// supported on AVR, on other processors analogRead() is always used.
+// Note: The ADC prescaler is shared by all analog pins, so the application's 
+// own conversions are also made at the reduced accuracy.  A button conversion 
+// is left running after each poll, and the ADC doesn't switch channels until 
+// it finishes, so analogRead() of another pin would return the button's 
+// voltage.  The application must read its other analog pins with 
+// analogReadOther() instead.
+//  Enter:  enableFlg = true to use split phase conversions, false to return to 
+//            analogRead() and the original ADC prescaler
+//          adcPrescaler = ADC clock prescaler, BUTTON_ADC_PRESCALER_16 to 
+//            BUTTON_ADC_PRESCALER_128
+//
+void ArduinoUserInterface::buttonsUseSplitPhaseADC(boolean enableFlg, byte adcPrescaler)
+{
+#if defined(__AVR__)
+  const byte ADC_PRESCALER_MASK = 0x07;
+
+  //
+  // turning off split phase mode, wait for the conversion in progress to 
+  // finish, then restore the prescaler
+  //
+  if (!enableFlg)
+  {
+    if (buttonADCSplitPhase)
+    {
+      while(bit_is_set(ADCSRA, ADSC))
+        ;
+      ADCSRA = (ADCSRA & ~ADC_PRESCALER_MASK) | buttonADCSavedPrescaler;
+      buttonADCSplitPhase = false;
+    }
+    return;
+  }
+
+  //
+  // let analogRead() select the channel and reference, then remember them so 
+  // each new conversion can check that it's reading the button pin
+  //
+  if (!buttonADCSplitPhase)
+    buttonADCSavedPrescaler = ADCSRA & ADC_PRESCALER_MASK;
+  ADCSRA = (ADCSRA & ~ADC_PRESCALER_MASK) | (adcPrescaler & ADC_PRESCALER_MASK);
+  analogRead(buttonAnalogPin);
+  buttonADCMux = ADMUX;
+
+  //
+  // clear the conversion complete flag, then start the first conversion
+  //
+  buttonADCLastButtonID = BUTTON_ID_NONE;
+  ADCSRA |= _BV(ADIF) | _BV(ADSC);
+  buttonADCSplitPhase = true;
+#else
+  (void) enableFlg;
+  (void) adcPrescaler;
+#endif
+}
+
+
+
+//
+// read an analog pin other than the buttons', the application must use this 
+// rather than analogRead() while the buttons are read with split phase 
+// conversions.  It waits for the button conversion to finish, then converts 
+// the pin twice and returns the second result, the first is thrown away as 
+// the ADC's sample and hold may still be charged from the button pin.  
+// Interrupts are disabled while the ADC is in use so that an ISR sampling the 
+// buttons can't start a conversion part way through, with the button's ADC 
+// prescaler that is about 40uS.  Without split phase conversions this is the 
+// same as analogRead().
+//  Enter:  pin = analog pin to read (A0 - A7)
+//  Exit:   ADC reading of the pin returned (0 - 1023)
+//
+int ArduinoUserInterface::analogReadOther(byte pin)
+{
+#if defined(__AVR__)
+  uint8_t oldSREG;
+  int analogValue;
+
+  if (buttonADCSplitPhase)
+  {
+    oldSREG = SREG;
+    cli();
+    while(bit_is_set(ADCSRA, ADSC))
+      ;
+    analogRead(pin);
+    analogValue = analogRead(pin);
+    SREG = oldSREG;
+    return(analogValue);
+  }
+#endif
+
+  return(analogRead(pin));
+}
+
+
+
+//
+// sample the buttons from a timer interrupt rather than each time 
+// getButtonEvent() is called, this way button presses are not missed while the 
+// application is busy.  The application's timer ISR must call 
+// buttonsSampleFromISR() at a regular rate (every 1 to 10 ms).  On AVR, the 
+// Timer0 compare A interrupt is set up to fire every 1.024 ms, Timer0 is 
+// already running for millis() so its rate isn't changed.  The sketch then 
+// adds BUTTONS_SAMPLE_FROM_TIMER0_ISR(ui) to define the ISR.  The buttons are 
+// read with split phase ADC conversions so the ISR doesn't wait for the ADC, 
+// it takes a few microseconds rather than the 110uS of an analogRead().
+//  Enter:  configureTimerFlg = true to set up the Timer0 compare A interrupt, 
+//            false if the application calls buttonsSampleFromISR() from its 
+//            own timer ISR
+//
+void ArduinoUserInterface::buttonsEnableInterruptSampling(boolean configureTimerFlg)
+{
+#if defined(__AVR__)
+  const byte TIMER0_COMPARE_VALUE = 0xAF;
+  uint8_t oldSREG;
+#endif
+
+  buttonEventQueueHead = 0;
+  buttonEventQueueTail = 0;
+  buttonEventQueueDroppedCount = 0;
+  buttonSamplingFromInterrupt = true;
+
+#if defined(__AVR__)
+  if (!buttonADCSplitPhase)
+    buttonsUseSplitPhaseADC(true);
+
+  //
+  // the compare value can be anything, Timer0 counts through all 256 values 
+  // for each millis() tick, so the interrupt comes between two of them
+  //
+  if (configureTimerFlg)
+  {
+    oldSREG = SREG;
+    cli();
+    OCR0A = TIMER0_COMPARE_VALUE;
+    TIMSK0 |= _BV(OCIE0A);
+    SREG = oldSREG;
+  }
+#else
+  (void) configureTimerFlg;
+#endif
+}
+
+
+
+//
+// sample the buttons, this is called from the application's timer ISR, any 
+// button events found are added to a queue that's read by getButtonEvent()
+//
+void ArduinoUserInterface::buttonsSampleFromISR(void)
+{
+  byte currentButtonID;
+  byte buttonEvent;
+  byte nextQueueHead;
+
+  //
+  // check if no button is press now and no button has been pressed for a while
+  //
+  currentButtonID = readButtonsToGetButtonID();
+  if ((buttonState == WAITING_FOR_BUTTON_DOWN_STATE) && (currentButtonID == BUTTON_ID_NONE))
+    return;
+
+  //
+  // run the debounce / auto repeat state machine
+  //
+  buttonEvent = processButtonSample(currentButtonID, millis());
+  if (buttonEvent == BUTTON_NO_EVENT)
+    return;
+
+  //
+  // add the event to the queue, this ISR is the only one that writes the head 
+  // so no locking is needed.  If the queue is full the event is dropped and 
+  // counted, the count stops at 255
+  //
+  nextQueueHead = (buttonEventQueueHead + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+  if (nextQueueHead == buttonEventQueueTail)
+  {
+    if (buttonEventQueueDroppedCount < 255)
+      buttonEventQueueDroppedCount++;
+    return;
+  }
+
+  buttonEventQueue[buttonEventQueueHead] = buttonEvent;
+  buttonEventQueueHead = nextQueueHead;
+}
+
+
+
+//
+// get the number of button events dropped because the queue was full, when 
+// the buttons are sampled by an interrupt and the application hasn't called 
+// getButtonEvent() often enough.  The queue holds BUTTON_EVENT_QUEUE_SIZE - 1 
+// events.  A dropped release can leave the application thinking a button is 
+// still down.  The count is cleared each time it's read
+//  Exit:   number of events dropped since the last call returned (0 - 255)
+//
+byte ArduinoUserInterface::buttonsGetDroppedEventCount(void)
+{
+  byte droppedCount;
+#if defined(__AVR__)
+  uint8_t oldSREG;
+#endif
+
+  //
+  // the ISR may add to the count between reading and clearing it
+  //
+#if defined(__AVR__)
+  oldSREG = SREG;
+  cli();
+#else
+  noInterrupts();
+#endif
+
+  droppedCount = buttonEventQueueDroppedCount;
+  buttonEventQueueDroppedCount = 0;
+
+#if defined(__AVR__)
+  SREG = oldSREG;
+#else
+  interrupts();
+#endif
+  return(droppedCount);
+}
+
+
+
+//
+// check for an event from any of the push buttons
+//   Exit:  event value returned (sum of the button ID + the button event)
+//           BUTTON_NO_EVENT returned if no event
+//
+byte ArduinoUserInterface::getButtonEvent(void)
+{
+  byte currentButtonID;
+  byte buttonEvent;
+
+
+  //
+  // when drawing into a frame buffer, send any changes to the LCD while the 
+  // application waits for the buttons
+  //
+  lcdFlush();
+
+  //
+  // write configuration values waiting in the journal once things are quiet
+  //
+  configCommitIfIdle();
+
+  //
+  // if the buttons are sampled by an interrupt, take the next event from the 
+  // queue, this function is the only one that writes the tail 
+  //
+  if (buttonSamplingFromInterrupt)
+  {
+    if (buttonEventQueueTail == buttonEventQueueHead)
+      return(BUTTON_NO_EVENT);
+
+    buttonEvent = buttonEventQueue[buttonEventQueueTail];
+    buttonEventQueueTail = (buttonEventQueueTail + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+    return(buttonEvent);
+  }
+
+  //
+  // check if no button is press now and no button has been pressed for a while
+  //
+  currentButtonID = readButtonsToGetButtonID();
+  if ((buttonState == WAITING_FOR_BUTTON_DOWN_STATE) && (currentButtonID == BUTTON_ID_NONE))
+    return(BUTTON_NO_EVENT);                       // nothing pressed, return no event
+
+
+  //
+  // something is going on, read the time and run the state machine
+  //
+  return(processButtonSample(currentButtonID, millis()));
+}
+
+
+
+//
+// run the button debounce / auto repeat state machine with one sample of the 
+// buttons, this does not read any hardware so it can be fed recorded samples 
+//  Enter:  currentButtonID = the button pressed in this sample (BUTTON_ID_NONE 
+//            if no button)
+//          currentTime = time in milliseconds that the sample was taken
+//  Exit:   event value returned (sum of the button ID + the button event)
+//           BUTTON_NO_EVENT returned if no event
+//
+byte ArduinoUserInterface::processButtonSample(byte currentButtonID, unsigned long currentTime)
+{
+  //
+  // check the state that the button was in last
+  //
+  switch(buttonState)
+  {
+    //
+    // check if waiting for button to go down
+    //
+    case WAITING_FOR_BUTTON_DOWN_STATE:
+    {
+      //
+      // a button has been pressed, remember it
+      //
+      buttonID = currentButtonID;
+      buttonState = CONFIRM_BUTTON_DOWN_STATE;
+      buttonEventStartTime = currentTime;
+      break;                                          // return no event now
+     } 
+
+
+    //
+    // we think a button has been press, let's double check
+    //
+    case CONFIRM_BUTTON_DOWN_STATE:
+    {
+      if (currentTime < (buttonEventStartTime + BUTTON_DEBOUNCE_PERIOD))
+        break;                                        // wait until debounce period complete
+  
+      //
+      // make sure the same button is pressed, as was pressed before
+      //
+      if (currentButtonID != buttonID)
+      {
+        buttonState = WAITING_FOR_BUTTON_DOWN_STATE;  // not the same button, start over
+        break;                                        // return no event
+      }
+
+      //
+      // a button has been pressed
+      //
+      buttonEventStartTime = currentTime;             // start auto repeat timer
+      buttonState = WAITING_FOR_BUTTON_UP_STATE;  
+      return(BUTTON_PUSHED_EVENT + buttonID);         // return button "pressed" event
+    }
+
+
+    //
+    // check if waiting for button to go back up
+    //      
+    case WAITING_FOR_BUTTON_UP_STATE:
+    {
+      //
+      // button has been down, check if it is still down
+      //
+      if (currentButtonID != buttonID)
+      {
+        //
+        // nothing pressed now or not the same button pressed, go wait for all buttons up
+        //
+        buttonState = WAITING_FOR_ALL_BUTTONS_UP_STATE;
+        break;                                   // return no event
+      }
+      
+      //
+      // the button is still down, check if time to auto repeat
+      //
+      if (currentTime < (buttonEventStartTime + BUTTON_AUTO_REPEAT_DELAY))
+        break;                                   // no, return no event
+                                           
+      buttonEventStartTime = currentTime;        // yes auto repeat, reset auto repeat timer
+      buttonState = WAITING_FOR_BUTTON_UP_AFTER_AUTO_REPEAT_STATE;
+      return(BUTTON_REPEAT_EVENT + buttonID);    // return button "auto repeat" event
+    }
+     
+
+    //
+    // check if waiting for button to repeat
+    //
+    case WAITING_FOR_BUTTON_UP_AFTER_AUTO_REPEAT_STATE:
+    {
+      //
+      // button has been down & auto repeat started, check if it is still down
+      //
+      if (currentButtonID != buttonID)
+      {
+        //
+        // nothing pressed now or not the same button pressed, go wait for all buttons up
+        //
+        buttonState = WAITING_FOR_ALL_BUTTONS_UP_STATE;
+        break;
+      }
+ 
+      //
+      // button is still down, check if time to auto repeat
+      //
+      if (currentTime < (buttonEventStartTime + BUTTON_AUTO_REPEAT_RATE))
+        break;                                        // return no event
+                                           
+      buttonEventStartTime = currentTime;             // yes, auto repeat, reset auto repeat timer
+      return(BUTTON_REPEAT_EVENT + buttonID);         // return button "auto repeat" event
+    }
+    
+
+    //
+    // check if all the buttons are up now
+    //
+    case WAITING_FOR_ALL_BUTTONS_UP_STATE:
+    {
+      //
+      // check if the button is up
+      //
+      if (currentButtonID != BUTTON_ID_NONE)
+        break;                                         // all buttons not up, return no event
+      
+      //
+      // the button is up
+      //
+      buttonState = CONFIRM_ALL_BUTTONS_UP_STATE;
+      buttonEventStartTime = currentTime;
+      break;                                           // return no event now
+    }
+
+
+    //
+    // verify all buttons still up
+    //
+    case CONFIRM_ALL_BUTTONS_UP_STATE:
+    {
+      if (currentTime < (buttonEventStartTime + BUTTON_DEBOUNCE_PERIOD))
+        break;                                           // delay period not up, return no event
+  
+      //
       // make sure no buttons are pressed
       //
-      if (currentButtonID != BUTTON_ID_NONE)
+      if (currentButtonID != BUTTON_ID_NONE)
+      {
+        buttonState = WAITING_FOR_ALL_BUTTONS_UP_STATE;  // something IS pressed so start over
+        break;                                           // return no event
+      }
+
+      //
+      // button has been released now
+      //
+      buttonState = WAITING_FOR_BUTTON_DOWN_STATE;       // cycle of button events complete
+      return(BUTTON_RELEASED_EVENT + buttonID);          // return button "Up" event
+    }
+  }
+
+  return(BUTTON_NO_EVENT);
+}
+
+
+
+//
+// check if any buttons are pushed and return its button number
+//  Exit: PUSH_BUTTON_DOWN or PUSH_BUTTON_UP
+//          or PUSH_BUTTON_BACK or PUSH_BUTTON_NONE
+//
+byte ArduinoUserInterface::readButtonsToGetButtonID(void)
+{
+  //
+  // in split phase mode, if the last conversion hasn't finished return the 
+  // button found by the one before it
+  //
+#if defined(__AVR__)
+  if (buttonADCSplitPhase)
+  {
+    if (bit_is_clear(ADCSRA, ADIF))
+      return(buttonADCLastButtonID);
+
+    //
+    // use the result only if the application hasn't since converted a 
+    // different pin, then start the next conversion
+    //
+    if (ADMUX == buttonADCMux)
+      buttonADCLastButtonID = getButtonIDFromAnalogValue(ADC);
+    else
+      ADMUX = buttonADCMux;
+
+    ADCSRA |= _BV(ADIF) | _BV(ADSC);
+    return(buttonADCLastButtonID);
+  }
+#endif
+
+  //
+  // read the button voltage with a blocking conversion
+  //
+  return(getButtonIDFromAnalogValue(analogRead(buttonAnalogPin)));
+}
+
+
+
+//
+// determine which button is pressed from the voltage on the resistor ladder, 
+// using one load from the ladder's lookup table
+//  Enter:  buttonAnalogValue = ADC reading of the button pin (0 - 1023)
+//  Exit:   button ID returned, BUTTON_ID_NONE if no button is pressed
+//
+byte ArduinoUserInterface::getButtonIDFromAnalogValue(int buttonAnalogValue)
+{
+  return(pgm_read_byte(&buttonLadderTable[buttonAnalogValue >> BUTTON_LADDER_TABLE_SHIFT]));
+}
+
+
+
+//
+// test if a number is in the given range
+//  Enter:  value = number to test
+//          lowerValue = bottom of range (inclusive)
+//          upperValue = top of range (inclusive)
+//  Exit:   true return if value is in range
+//
+boolean ArduinoUserInterface::intInRange(int value, int lowerValue, int upperValue)
+{
+  if ((value <= upperValue)  && (value >= lowerValue))
+    return(true);
+  else
+    return(false);
+}
+
+
+
+//
+// draw the button bar
+//  Enter:  leftButtonText -> text for left button, empty string will draw no 
+//            button
+//          rightButtonText -> text for right button, empty string will draw no 
+//            button
+//
+void ArduinoUserInterface::drawButtonBar(const char *leftButtonText, const char *rightButtonText)
+{
+  byte leftButtonLeftX = 0;
+  byte leftButtonRightX = leftButtonLeftX + BUTTON_WIDTH;
+  byte rightButtonLeftX = RIGHT_BUTTON_CENTER_X - BUTTON_WIDTH/2;
+  byte rightButtonRightX = rightButtonLeftX + BUTTON_WIDTH - 1;
+  
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_DRAW_BUTTON_BAR);
+
+  //
+  // move cursor to the button bar line
+  //
+  lcdSetCursorXY(leftButtonLeftX, LCD_HEIGHT_IN_LINES - 1);
+
+  //
+  // draw the left button if not blank
+  //
+  if (leftButtonText[0] != 0)
+    lcdPrintCenteredStringReverse(leftButtonText, LEFT_BUTTON_CENTER_X, BUTTON_WIDTH);
+  
+  //
+  // draw white between the buttons
+  //
+  lcdFillToColumnX(rightButtonLeftX - 1, 0);
+
+  //
+  // draw the right button if not blank
+  //
+  if (rightButtonText[0] != 0)
+    lcdPrintCenteredStringReverse(rightButtonText, RIGHT_BUTTON_CENTER_X, BUTTON_WIDTH);
+  else
+    lcdFillToEndOfLine(0);
+
+  //
+  // draw a line above the left button so upper case letters are covered
+  //
+  lcdSetCursorXY(leftButtonLeftX, LCD_HEIGHT_IN_LINES - 2);
+  if (leftButtonText[0] != 0)
+    lcdFillToColumnX(leftButtonRightX, 0x80);
+
+  //
+  // draw white space between buttons on line above
+  //
+  lcdFillToColumnX(rightButtonLeftX-1, 0);
+
+
+  //
+  // draw a line above the left button so upper case letters are covered
+  //
+  if (rightButtonText[0] != 0)
+    lcdFillToColumnX(rightButtonRightX, 0x80);
+  else
+    lcdFillToEndOfLine(0);
+}
+
+
+// ---------------------------------------------------------------------------------
+//                                    LCD functions  
+// ---------------------------------------------------------------------------------
+
+
+//
+// constants for the LCD display
+//
+const int LCD_COMMAND_BYTE = LOW;
+const int LCD_DATA_BYTE = HIGH;
+
+
+//
+// SPI settings when using the hardware SPI transport, the PCD8544 controller 
+// is specified up to 4 MHz
+//
+const long LCD_SPI_CLOCK_RATE = 4000000;
+
+
+//
+// value of lcdAddressX & lcdAddressY when the LCD's address counter isn't known
+//
+const byte LCD_ADDRESS_UNKNOWN = 0xff;
+
+
+//
+// ASCII font, 5 x 8 pixels, this font is stored in program memory rather than RAM
+//
+#define FONT_GLYPH(c0, c1, c2, c3, c4) {c0, c1, c2, c3, c4},
+
+const byte Font[][5] PROGMEM = 
+  {
+#include "ArduinoUserInterfaceFont.h"
+  };
+
+#undef FONT_GLYPH
+
+
+//
+// the same font with every pixel inverted, used to print reverse video text 
+// without inverting each column as it's drawn
+//
+#if ARDUINO_USER_INTERFACE_REVERSE_FONT
+#define FONT_GLYPH(c0, c1, c2, c3, c4) {(byte) ~(c0), (byte) ~(c1), (byte) ~(c2), (byte) ~(c3), (byte) ~(c4)},
+
+const byte FontReverse[][5] PROGMEM = 
+  {
+#include "ArduinoUserInterfaceFont.h"
+  };
+
+#undef FONT_GLYPH
+
+const LCD_FONT lcdFont5x8Reverse = {&FontReverse[0][0], NULL, 5, 0x20, 0x80};
+#endif
+
+
+//
+// proportional font, stored in program memory
+//
+#include "ArduinoUserInterfaceFontProportional.h"
+
+
+//
+// descriptors for the fonts included with the library
+//
+const LCD_FONT lcdFont5x8 = {&Font[0][0], NULL, 5, 0x20, 0x80};
+const LCD_FONT lcdFontProportional = {FontProportionalColumns, FontProportionalOffsets, 5, 0x20, 0x80};
+
+
+// ---------------------------------------------------------------------------------
+
+//
+// initialize the LCD display
+//
+void ArduinoUserInterface::lcdInitialise(void)
+{
+  //
+  // setup the IO pins, there are none when bytes are given to a callback 
+  // function
+  //
+  if (lcdTransport != LCD_TRANSPORT_CALLBACK)
+  {
+    digitalWrite(lcdChipEnablePin, HIGH);
+    pinMode(lcdChipEnablePin, OUTPUT);
+    digitalWrite(lcdChipEnablePin, HIGH);
+
+    pinMode(lcdDataControlPin, OUTPUT);
+
+    if (lcdTransport == LCD_TRANSPORT_HARDWARE_SPI)
+    {
+      SPI.begin();
+    }
+    else
+    {
+      pinMode(lcdDataInPin, OUTPUT);
+      pinMode(lcdClockPin, OUTPUT);
+      digitalWrite(lcdClockPin, LOW);
+    }
+
+#if defined(__AVR__)
+    //
+    // look up the port register and bit mask of each pin now, so bytes can be 
+    // sent by writing the ports directly rather than calling digitalWrite()
+    //
+    lcdClockPort = portOutputRegister(digitalPinToPort(lcdClockPin));
+    lcdClockBitMask = digitalPinToBitMask(lcdClockPin);
+    lcdDataInPort = portOutputRegister(digitalPinToPort(lcdDataInPin));
+    lcdDataInBitMask = digitalPinToBitMask(lcdDataInPin);
+    lcdDataControlPort = portOutputRegister(digitalPinToPort(lcdDataControlPin));
+    lcdDataControlBitMask = digitalPinToBitMask(lcdDataControlPin);
+    lcdChipEnablePort = portOutputRegister(digitalPinToPort(lcdChipEnablePin));
+    lcdChipEnableBitMask = digitalPinToBitMask(lcdChipEnablePin);
+#endif
+  }
+
+  
+  //
+  // configure the display
+  //
+  lcdWriteCommand(0x00);      // NOP
+  lcdWriteCommand(0x21);      // set H bit to program config registers
+  lcdWriteCommand(0xC0);      // set LCD Vop (Contrast) (0x80 - 0xff)
+  lcdWriteCommand(0x06);      // set LCD temp coefficent (0x04 - 0x07)
+  lcdWriteCommand(0x14);      // set LCD bias mode to 1:48 (0x10 - 0x17)
+  lcdWriteCommand(0x20);      // clear H bit to access X & Y registers
+  lcdWriteCommand(0x0C);      // set "normal mode"
+
+  lcdCursorColumnX = 0;       // remember the LCD cursor's current position
+  lcdCursorRowY = 0;  
+  lcdAddressX = LCD_ADDRESS_UNKNOWN;   // the LCD's address counter is not known yet
+  lcdAddressY = LCD_ADDRESS_UNKNOWN;
+}
+
+
+
+//
+// print a signed int at location of the cursor
+//  Enter:  n = signed number to print 
+//
+void ArduinoUserInterface::lcdPrintInt(int n)
+{
+  char stringBuffer[7];
+  byte numberOfDigits;
+  
+  itoa(n, stringBuffer, 10);
+  lcdPrintString(stringBuffer);
+}
+
+
+
+//
+// print a signed int at location of the cursor, left justified, optional white 
+// space will be added after the digits to pad to the given width
+//  Enter:  n = signed number to print 
+//          padToNumberOfDigits = total width of the number (in characters)  
+//            including white space after the digits (0 to 6)
+//
+void ArduinoUserInterface::lcdPrintIntLeftJustified(int n, int padToNumberOfDigits)
+{
+  char stringBuffer[7];
+  
+  //
+  // print the number
+  //
+  itoa(n, stringBuffer, 10);
+  lcdPrintStringLeftJustified(stringBuffer, padToNumberOfDigits);
+}
+
+
+
+//
+// print a signed int at location of the cursor, right justified, optional white 
+// space will be added before the digits to pad to the given width
+//  Enter:  n = signed number to print 
+//          padToNumberOfDigits = total width of the number (in characters)  
+//            including white space after the digits (0 to 6)
+//
+void ArduinoUserInterface::lcdPrintIntRightJustified(int n, int padToNumberOfDigits)
+{
+  char stringBuffer[7];
+  
+  //
+  // conver the number to a string
+  //
+  itoa(n, stringBuffer, 10);
+  lcdPrintStringRightJustified(stringBuffer, padToNumberOfDigits);
+}
+
+
+
+//
+// print a signed int at location of the cursor, center, optional white 
+// space will be added before and after the digits to pad to the given width
+//  Enter:  n = signed number to print 
+//          padToNumberOfDigits = total width of the number (in characters)  
+//            including white space after the digits (0 to 6)
+//
+void ArduinoUserInterface::lcdPrintIntCentered(int n, int padToNumberOfDigits)
+{
+  char stringBuffer[7];
+  
+  //
+  // conver the number to a string
+  //
+  itoa(n, stringBuffer, 10);
+  lcdPrintStringCentered(stringBuffer, padToNumberOfDigits);
+}
+
+
+
+//
+// print a string to the LCD display
+//  Enter:  s -> a null terminated string 
+//
+void ArduinoUserInterface::lcdPrintString(char *s)
+{
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_PRINT_STRING);
+
+  //
+  // loop, writing one character at a time until the end of the string is reached
+  //
+  while (*s)
+  {
+    lcdPrintCharacter(*s++);
+  }
+}
+
+
+
+//
+// print a string at location of the cursor, left justified, optional white 
+// space will be added after the string to pad to the given character width
+//  Enter:  s -> string to print 
+//          padToNumberOfCharacters = total width of printed string (in characters)  
+//            including white space after the string (0 to 13)
+//
+void ArduinoUserInterface::lcdPrintStringLeftJustified(char *s, 
+                            int padToNumberOfCharacters)
+{
+  int paddedColumnX;
+  
+  //
+  // print the string
+  //
+  paddedColumnX = lcdCursorColumnX + (padToNumberOfCharacters * (lcdFont->GlyphWidth + 1));
+  lcdPrintString(s);
+  
+  //
+  // add optional padding after the string, each character of padding is the 
+  // width of a digit
+  //
+  if (paddedColumnX > lcdCursorColumnX)
+    lcdFillToColumnX(paddedColumnX, 0x00);
+}
+
+
+
+//
+// print a string at location of the cursor, right justified, optional white 
+// space will be added before the string to pad to the given width
+//  Enter:  s -> string to print 
+//          padToNumberOfCharacters = total width of printed string (in characters)  
+//            including white space after the string (0 to 13)
+//
+void ArduinoUserInterface::lcdPrintStringRightJustified(char *s, 
+                              int padToNumberOfCharacters)
+{
+  byte stringWidthInPixels;
+  int padToWidthInPixels;
+  int newCursorColumnX;
+  
+  stringWidthInPixels = lcdStringWidthInPixels(s);
+  padToWidthInPixels = padToNumberOfCharacters * (lcdFont->GlyphWidth + 1);
+  
+  if (padToWidthInPixels > stringWidthInPixels)
+  {
+    newCursorColumnX = lcdCursorColumnX - padToWidthInPixels;
+    
+    if (newCursorColumnX < 0)
+      newCursorColumnX = 0;
+      
+    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
+      
+    lcdFillToColumnX(lcdCursorColumnX + (padToWidthInPixels - stringWidthInPixels), 0x00);
+    
+    lcdPrintString(s);
+  }
+  
+  else
+  {
+    newCursorColumnX = lcdCursorColumnX - stringWidthInPixels;
+    
+    if (newCursorColumnX < 0)
+      newCursorColumnX = 0;
+      
+    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
+    
+    lcdPrintString(s);    
+  }
+}
+
+
+
+//
+// print a string at location of the cursor, center, optional white 
+// space will be added before and after the string to pad to the given width
+//  Enter:  s -> string to print 
+//          padToNumberOfCharacters = total width of printed string (in   
+//            characters) including white space after the string (0 to 13)
+//
+void ArduinoUserInterface::lcdPrintStringCentered(char *s, int padToNumberOfCharacters)
+{
+  byte stringWidthInPixels;
+  int padToWidthInPixels;
+  int newCursorColumnX;
+  byte pixelsOfPadding;
+  
+  stringWidthInPixels = lcdStringWidthInPixels(s);
+  padToWidthInPixels = padToNumberOfCharacters * (lcdFont->GlyphWidth + 1);
+  
+  if (padToWidthInPixels > stringWidthInPixels)
+  {
+    newCursorColumnX = lcdCursorColumnX - (padToWidthInPixels / 2);
+    
+    if (newCursorColumnX < 0)
+      newCursorColumnX = 0;
+      
+    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
+    
+    pixelsOfPadding = (padToWidthInPixels - stringWidthInPixels) / 2;
+    lcdFillToColumnX(lcdCursorColumnX + pixelsOfPadding, 0x00);
+    
+    lcdPrintString(s);
+
+    lcdFillToColumnX(newCursorColumnX + padToWidthInPixels, 0x00);
+  }
+  
+  else
+  {
+    newCursorColumnX = lcdCursorColumnX - (stringWidthInPixels / 2);
+    
+    if (newCursorColumnX < 0)
+      newCursorColumnX = 0;
+      
+    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
+    
+    lcdPrintString(s);    
+  }
+}
+
+
+
+//
+// print a string in reverse video to the LCD with centering on the current line
+//  Enter:  s -> a null terminated string 
+//          X = X coord to the center position to print (0 - 83)
+//          padToWidth = desired with of reverse video string, black padding will
+//            be added on each side of the string if needed, set to zero to add no 
+//            padding
+//
+void ArduinoUserInterface::lcdPrintCenteredStringReverse(const char *s, byte X, 
+                               byte padToWidth)
+{
+  int startingX;
+  byte stringWidthInPixels;
+  
+  stringWidthInPixels = lcdStringWidthInPixels(s);
+
+  //
+  // determine padding needed on right and left sides of string
+  //
+  if (padToWidth > stringWidthInPixels)
+  {
+    //
+    // move the cursor to the beginning of the printing
+    //
+    startingX = X - ((padToWidth / 2) + (padToWidth % 2));
+    lcdSetCursorXY(startingX, lcdCursorRowY);  
+    
+    //
+    // add black padding up to the beginning of the string
+    //
+    lcdFillToColumnX(X - (stringWidthInPixels / 2), 0xff);
+
+    //
+    // print the string
+    //
+    lcdPrintStringReverse(s);
+
+    //
+    // add black padding at the end of the string
+    //
+    lcdFillToColumnX(startingX + padToWidth, 0xff);
+  }
+  
+  else
+  {
+    //
+    // move the cursor to the beginning of the printing
+    //
+    lcdSetCursorXY(X - (stringWidthInPixels/2), lcdCursorRowY);  
+
+    //
+    // print the string
+    //
+    lcdPrintStringReverse(s);
+  }
+}
+
+
+
+//
+// print a string to the LCD display in reverse video
+//  Enter:  s -> a null terminated string 
+//
+void ArduinoUserInterface::lcdPrintStringReverse(const char *s)
+{
+  //
+  // loop, writing one character at a time until the end of the string is reached
+  //
+  while (*s)
+  {
+    lcdPrintCharacterReverse(*s++);
+  }
+}
+
+
+
+//
+// print a string stored in flash (PROGMEM) to the LCD display
+//  Enter:  s -> a null terminated string in flash
+//
+void ArduinoUserInterface::lcdPrintString_P(const char *s)
+{
+  char c;
+
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_PRINT_STRING);
+
+  while ((c = pgm_read_byte(s++)) != 0)
+  {
+    lcdPrintCharacter(c);
+  }
+}
+
+
+
+//
+// print a string stored in flash (PROGMEM) to the LCD display in reverse video
+//  Enter:  s -> a null terminated string in flash
+//
+void ArduinoUserInterface::lcdPrintStringReverse_P(const char *s)
+{
+  char c;
+
+  while ((c = pgm_read_byte(s++)) != 0)
+  {
+    lcdPrintCharacterReverse(c);
+  }
+}
+
+
+
+//
+// flags for a field printed by lcdPrintf()
+//
+const byte LCD_PRINTF_LEFT_JUSTIFY = 0x01;
+const byte LCD_PRINTF_CENTER       = 0x02;
+const byte LCD_PRINTF_ZERO_PAD     = 0x04;
+
+
+//
+// powers of 10 used to print the digits of a number without dividing
+//
+const byte LCD_PRINTF_MAX_DIGITS = 10;
+
+const unsigned long lcdPrintfPowersOfTen[LCD_PRINTF_MAX_DIGITS] PROGMEM = {
+  1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 
+  100000000UL, 1000000000UL};
+
+
+//
+// print formatted text at the cursor, the text is drawn as it's formatted 
+// so no buffer is needed.  The format string is stored in flash with F(), for 
+// example:  ui.lcdPrintf(F("Temp %5.1d C"), tenthsOfDegrees);
+//
+// Each field is: % [flags] [width] [.decimals] [l] type
+//    flags:    - left justify,  ^ center,  0 pad a number with zeros (ignored 
+//              with -), numbers and strings are right justified otherwise
+//    width:    width of the field in characters (the width of a digit), the 
+//              field starts at the cursor
+//    decimals: print an integer as a fixed point value with this many digits 
+//              right of the decimal point, 150 with .2 is printed as 1.50
+//    l:        the argument is a long
+//    type:     d = signed int,  u = unsigned int,  c = character,  
+//              s = string in RAM,  S = string in flash (PSTR()),  % = a %
+//
+//  Enter:  format -> format string in flash
+//          ... = values for the fields
+//
+void ArduinoUserInterface::lcdPrintf(const __FlashStringHelper *format, ...)
+{
+  va_list args;
+  const char *formatString;
+  char c;
+  byte fieldFlags;
+  byte fieldWidth;
+  byte digitsRightOfDecimal;
+  boolean longFlag;
+  long value;
+  unsigned long unsignedValue;
+
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_PRINT_STRING);
+
+  va_start(args, format);
+  formatString = (const char *) format;
+
+  while ((c = pgm_read_byte(formatString++)) != 0)
+  {
+    //
+    // print everything outside of a field as is
+    //
+    if (c != '%')
+    {
+      lcdPrintCharacter(c);
+      continue;
+    }
+
+    //
+    // read the field's flags, width, decimals and size
+    //
+    fieldFlags = 0;
+    while (true)
+    {
+      c = pgm_read_byte(formatString++);
+      if (c == '-')
+        fieldFlags |= LCD_PRINTF_LEFT_JUSTIFY;
+      else if (c == '^')
+        fieldFlags |= LCD_PRINTF_CENTER;
+      else if (c == '0')
+        fieldFlags |= LCD_PRINTF_ZERO_PAD;
+      else
+        break;
+    }
+
+    //
+    // as with printf(), left justifying a number pads it with blanks on the 
+    // right, not with zeros
+    //
+    if (fieldFlags & LCD_PRINTF_LEFT_JUSTIFY)
+      fieldFlags &= ~LCD_PRINTF_ZERO_PAD;
+
+    fieldWidth = 0;
+    while ((c >= '0') && (c <= '9'))
+    {
+      fieldWidth = (fieldWidth * 10) + (c - '0');
+      c = pgm_read_byte(formatString++);
+    }
+
+    digitsRightOfDecimal = 0;
+    if (c == '.')
+    {
+      c = pgm_read_byte(formatString++);
+      while ((c >= '0') && (c <= '9'))
+      {
+        digitsRightOfDecimal = (digitsRightOfDecimal * 10) + (c - '0');
+        c = pgm_read_byte(formatString++);
+      }
+      if (digitsRightOfDecimal >= LCD_PRINTF_MAX_DIGITS)
+        digitsRightOfDecimal = LCD_PRINTF_MAX_DIGITS - 1;
+    }
+
+    longFlag = false;
+    if (c == 'l')
+    {
+      longFlag = true;
+      c = pgm_read_byte(formatString++);
+    }
+
+    //
+    // print the field
+    //
+    switch(c)
+    {
+      case 'd':
+      case 'i':
+      {
+        if (longFlag)
+          value = va_arg(args, long);
+        else
+          value = va_arg(args, int);
+
+        if (value < 0)
+          lcdPrintfNumber(-(unsigned long) value, true, digitsRightOfDecimal, fieldWidth, fieldFlags);
+        else
+          lcdPrintfNumber(value, false, digitsRightOfDecimal, fieldWidth, fieldFlags);
+        break;
+      }
+
+      case 'u':
+      {
+        if (longFlag)
+          unsignedValue = va_arg(args, unsigned long);
+        else
+          unsignedValue = va_arg(args, unsigned int);
+
+        lcdPrintfNumber(unsignedValue, false, digitsRightOfDecimal, fieldWidth, fieldFlags);
+        break;
+      }
+
+      case 'c':
+      {
+        lcdPrintCharacter((byte) va_arg(args, int));
+        break;
+      }
+
+      case 's':
+      {
+        lcdPrintfString(va_arg(args, const char *), false, fieldWidth, fieldFlags);
+        break;
+      }
+
+      case 'S':
+      {
+        lcdPrintfString(va_arg(args, const char *), true, fieldWidth, fieldFlags);
+        break;
+      }
+
+      //
+      // stop if the format ends in the middle of a field
+      //
+      case 0:
+      {
+        va_end(args);
+        return;
+      }
+
+      default:
+      {
+        lcdPrintCharacter(c);
+        break;
+      }
+    }
+  }
+
+  va_end(args);
+}
+
+
+
+//
+// print a number field for lcdPrintf(), the digits are found by subtracting 
+// powers of 10 rather than dividing, which is slow on the AVR
+//  Enter:  magnitude = the number to print without its sign
+//          negativeFlag = true to print a minus sign
+//          digitsRightOfDecimal = number of digits right of the decimal point
+//          fieldWidth = width of the field in characters, 0 for no padding
+//          fieldFlags = LCD_PRINTF_LEFT_JUSTIFY, LCD_PRINTF_CENTER...
+//
+void ArduinoUserInterface::lcdPrintfNumber(unsigned long magnitude, boolean negativeFlag, 
+  byte digitsRightOfDecimal, byte fieldWidth, byte fieldFlags)
+{
+  byte numberOfDigits;
+  byte numberOfCharacters;
+  byte numberOfZeros;
+  int contentWidthInPixels;
+  int fieldEndX;
+  unsigned long powerOfTen;
+  char digit;
+
+  //
+  // count the digits, a fixed point value always has a digit left of the 
+  // decimal point
+  //
+  numberOfDigits = 1;
+  while ((numberOfDigits < LCD_PRINTF_MAX_DIGITS) && 
+    (magnitude >= pgm_read_dword(&lcdPrintfPowersOfTen[numberOfDigits])))
+    numberOfDigits++;
+
+  if (numberOfDigits <= digitsRightOfDecimal)
+    numberOfDigits = digitsRightOfDecimal + 1;
+
+  numberOfCharacters = numberOfDigits;
+  if (negativeFlag)
+    numberOfCharacters++;
+  if (digitsRightOfDecimal > 0)
+    numberOfCharacters++;
+
+  //
+  // zero padding fills the field with leading zeros instead of blank space
+  //
+  numberOfZeros = 0;
+  if ((fieldFlags & LCD_PRINTF_ZERO_PAD) && (fieldWidth > numberOfCharacters))
+    numberOfZeros = fieldWidth - numberOfCharacters;
+
+  //
+  // measure the number, then pad the start of the field
+  //
+  contentWidthInPixels = (numberOfDigits + numberOfZeros) * lcdCharacterWidthInPixels('0');
+  if (negativeFlag)
+    contentWidthInPixels += lcdCharacterWidthInPixels('-');
+  if (digitsRightOfDecimal > 0)
+    contentWidthInPixels += lcdCharacterWidthInPixels('.');
+
+  fieldEndX = lcdPrintfBeginField(contentWidthInPixels, fieldWidth, fieldFlags);
+
+  //
+  // print the sign, the zeros, then each digit starting with the most significant
+  //
+  if (negativeFlag)
+    lcdPrintCharacter('-');
+
+  while (numberOfZeros > 0)
+  {
+    lcdPrintCharacter('0');
+    numberOfZeros--;
+  }
+
+  while (numberOfDigits > 0)
+  {
+    if (numberOfDigits == digitsRightOfDecimal)
+      lcdPrintCharacter('.');
+
+    powerOfTen = pgm_read_dword(&lcdPrintfPowersOfTen[numberOfDigits - 1]);
+    digit = '0';
+    while (magnitude >= powerOfTen)
+    {
+      magnitude -= powerOfTen;
+      digit++;
+    }
+
+    lcdPrintCharacter(digit);
+    numberOfDigits--;
+  }
+
+  //
+  // pad the end of the field
+  //
+  if (fieldEndX > lcdCursorColumnX)
+    lcdFillToColumnX(fieldEndX, 0x00);
+}
+
+
+
+//
+// print a string field for lcdPrintf(), the string is read twice, once to 
+// measure it and once to print it
+//  Enter:  s -> the string to print
+//          flashFlag = true if the string is in flash, false if in RAM
+//          fieldWidth = width of the field in characters, 0 for no padding
+//          fieldFlags = LCD_PRINTF_LEFT_JUSTIFY, LCD_PRINTF_CENTER...
+//
+void ArduinoUserInterface::lcdPrintfString(const char *s, boolean flashFlag, 
+  byte fieldWidth, byte fieldFlags)
+{
+  const char *sp;
+  char c;
+  int contentWidthInPixels;
+  int fieldEndX;
+
+  //
+  // measure the string, only needed if it's padded
+  //
+  contentWidthInPixels = 0;
+  if (fieldWidth > 0)
+  {
+    sp = s;
+    while ((c = (flashFlag ? pgm_read_byte(sp) : *sp)) != 0)
+    {
+      contentWidthInPixels += lcdCharacterWidthInPixels(c);
+      sp++;
+    }
+  }
+
+  fieldEndX = lcdPrintfBeginField(contentWidthInPixels, fieldWidth, fieldFlags);
+
+  //
+  // print the string, then pad the end of the field
+  //
+  while ((c = (flashFlag ? pgm_read_byte(s) : *s)) != 0)
+  {
+    lcdPrintCharacter(c);
+    s++;
+  }
+
+  if (fieldEndX > lcdCursorColumnX)
+    lcdFillToColumnX(fieldEndX, 0x00);
+}
+
+
+
+//
+// start a field for lcdPrintf(), blank space is added before the text if the 
+// field is right justified or centered
+//  Enter:  contentWidthInPixels = width of the text printed in the field
+//          fieldWidth = width of the field in characters, 0 for no padding
+//          fieldFlags = LCD_PRINTF_LEFT_JUSTIFY, LCD_PRINTF_CENTER...
+//  Exit:   column where the field ends returned
+//
+int ArduinoUserInterface::lcdPrintfBeginField(int contentWidthInPixels, byte fieldWidth, 
+  byte fieldFlags)
+{
+  int fieldStartX;
+  int paddingInPixels;
+
+  fieldStartX = lcdCursorColumnX;
+  paddingInPixels = (fieldWidth * (lcdFont->GlyphWidth + 1)) - contentWidthInPixels;
+  if (paddingInPixels <= 0)
+    return(fieldStartX);
+
+  if (fieldFlags & LCD_PRINTF_LEFT_JUSTIFY)
+    return(fieldStartX + paddingInPixels + contentWidthInPixels);
+
+  if (fieldFlags & LCD_PRINTF_CENTER)
+    lcdFillToColumnX(fieldStartX + (paddingInPixels / 2), 0x00);
+  else
+    lcdFillToColumnX(fieldStartX + paddingInPixels, 0x00);
+
+  return(fieldStartX + paddingInPixels + contentWidthInPixels);
+}
+
+
+
+//
+// print one ASCII charater to the display
+//  Enter:  c = character to display
+//
+void ArduinoUserInterface::lcdPrintCharacter(byte character)
+{
+  byte glyph[LCD_FONT_MAX_GLYPH_WIDTH + 1];
+  byte glyphWidth;
+  
+  //
+  // get the columns of the character followed by a column of blank pixels, 
+  // then write them to the display together
+  //
+  glyphWidth = lcdGetGlyph(lcdFont, character, glyph);
+  glyph[glyphWidth] = 0x00;
+  lcdWriteDataBurst(glyph, glyphWidth + 1);
+  
+  //
+  // move the cursor forward by one character
+  //
+  lcdCursorColumnX += glyphWidth + 1;
+}
+
+
+
+//
+// print one ASCII charater to the display in reverse video
+//  Enter:  c = character to display
+//
+void ArduinoUserInterface::lcdPrintCharacterReverse(byte character)
+{
+  byte pixelColumn;
+  byte glyph[LCD_FONT_MAX_GLYPH_WIDTH + 1];
+  byte glyphWidth;
+  
+  //
+  // get the columns of the character inverted, followed by a column of black 
+  // pixels, the 5 x 8 font may have a pre-inverted copy
+  //
+#if ARDUINO_USER_INTERFACE_REVERSE_FONT
+  if (lcdFont == &lcdFont5x8)
+    glyphWidth = lcdGetGlyph(&lcdFont5x8Reverse, character, glyph);
+  else
+#endif
+  {
+    glyphWidth = lcdGetGlyph(lcdFont, character, glyph);
+    for (pixelColumn = 0; pixelColumn < glyphWidth; pixelColumn++)
+      glyph[pixelColumn] = ~glyph[pixelColumn];
+  }
+
+  //
+  // write them to the display together
+  //
+  glyph[glyphWidth] = 0xff;
+  lcdWriteDataBurst(glyph, glyphWidth + 1);
+  
+  //
+  // move the cursor forward by one character
+  //
+  lcdCursorColumnX += glyphWidth + 1;
+}
+
+
+
+//
+// get the columns of pixels for one character from a font
+//  Enter:  font -> the font
+//          character = character to get, characters not in the font are 
+//            replaced with a space
+//          glyph -> buffer to copy the columns into (LCD_FONT_MAX_GLYPH_WIDTH 
+//            bytes)
+//  Exit:   width of the glyph in pixels returned (not including the blank 
+//            column that follows it)
+//
+byte ArduinoUserInterface::lcdGetGlyph(const LCD_FONT *font, byte character, byte *glyph)
+{
+  unsigned int glyphOffset;
+  byte glyphWidth;
+
+  //
+  // make sure character is in range of the font table, then get the index
+  //
+  if ((character < font->FirstCharacter) || (character > font->LastCharacter))
+    character = ' ';
+  character -= font->FirstCharacter;
+
+  //
+  // find where the glyph starts and its width, then copy all its columns at once
+  //
+  if (font->GlyphOffsets == NULL)
+  {
+    glyphOffset = character * font->GlyphWidth;
+    glyphWidth = font->GlyphWidth;
+  }
+  else
+  {
+    glyphOffset = pgm_read_word(&font->GlyphOffsets[character]);
+    glyphWidth = pgm_read_word(&font->GlyphOffsets[character + 1]) - glyphOffset;
+  }
+
+  if (glyphWidth > LCD_FONT_MAX_GLYPH_WIDTH)
+    glyphWidth = LCD_FONT_MAX_GLYPH_WIDTH;
+
+  memcpy_P(glyph, &font->GlyphColumns[glyphOffset], glyphWidth);
+  return(glyphWidth);
+}
+
+
+
+//
+// determine the width of one character in pixels, including the blank column 
+// that follows it, this comes from the font's offset table without reading 
+// the glyph
+//  Enter:  character = character to measure
+//  Exit:   width in pixels returned
+//
+byte ArduinoUserInterface::lcdCharacterWidthInPixels(byte character)
+{
+  byte glyphWidth;
+
+  if (lcdFont->GlyphOffsets == NULL)
+    return(lcdFont->GlyphWidth + 1);
+
+  if ((character < lcdFont->FirstCharacter) || (character > lcdFont->LastCharacter))
+    character = ' ';
+  character -= lcdFont->FirstCharacter;
+
+  glyphWidth = pgm_read_word(&lcdFont->GlyphOffsets[character + 1]) - 
+    pgm_read_word(&lcdFont->GlyphOffsets[character]);
+
+  if (glyphWidth > LCD_FONT_MAX_GLYPH_WIDTH)
+    glyphWidth = LCD_FONT_MAX_GLYPH_WIDTH;
+
+  return(glyphWidth + 1);
+}
+
+
+
+//
+// determine the width of a string in pixels
+//
+byte ArduinoUserInterface::lcdStringWidthInPixels(const char *s)
+{
+  byte width;
+
+  width = 0;
+  while (*s)
+    width += lcdCharacterWidthInPixels(*s++);
+
+  return(width);
+}
+
+
+
+//
+// select the font used to print text
+//  Enter:  font -> the font, &lcdFont5x8 (the default), &lcdFontProportional, 
+//            or a font supplied by the application
+//
+void ArduinoUserInterface::lcdSetFont(const LCD_FONT *font)
+{
+  lcdFont = font;
+}
+
+
+
+//
+// print a string with each pixel scaled up, 2 makes text 16 pixels high using 
+// 2 lines of the display, 3 makes it 24 pixels high using 3 lines.  Printing 
+// starts at the cursor, which is the top left corner of the text.
+//  Enter:  s -> a null terminated string 
+//          scale = 1 to LCD_MAX_TEXT_SCALE
+//
+void ArduinoUserInterface::lcdPrintStringLarge(char *s, byte scale)
+{
+  while (*s)
+  {
+    lcdPrintCharacterLarge(*s++, scale);
+  }
+}
+
+
+
+//
+// print a scaled string, only drawing the characters that are different from 
+// the string last printed in the same place.  This is used for values that 
+// are updated often, such as a timer, where usually only the last digits 
+// change.  Once a changed character has a different width, the rest of the 
+// string is redrawn.
+//  Enter:  s -> a null terminated string 
+//          previousString -> the string last printed at the cursor location
+//          scale = 1 to LCD_MAX_TEXT_SCALE
+//
+void ArduinoUserInterface::lcdUpdateStringLarge(char *s, char *previousString, byte scale)
+{
+  int columnX;
+  int previousEndingColumnX;
+  byte lineNumber;
+  byte characterWidth;
+  boolean redrawRemainingFlg;
+  byte bank;
+
+  columnX = lcdCursorColumnX;
+  lineNumber = lcdCursorRowY;
+  previousEndingColumnX = columnX + (lcdStringWidthInPixels(previousString) * scale);
+  if (previousEndingColumnX > LCD_WIDTH_IN_PIXELS)
+    previousEndingColumnX = LCD_WIDTH_IN_PIXELS;
+
+  //
+  // step through the string, skipping over the characters that haven't changed
+  //
+  redrawRemainingFlg = false;
+  while (*s)
+  {
+    characterWidth = lcdCharacterWidthInPixels(*s);
+    if (redrawRemainingFlg || (*s != *previousString))
+    {
+      if ((*previousString == 0) || (characterWidth != lcdCharacterWidthInPixels(*previousString)))
+        redrawRemainingFlg = true;
+
+      lcdSetCursorXY(columnX, lineNumber);
+      lcdPrintCharacterLarge(*s, scale);
+    }
+
+    columnX += characterWidth * scale;
+    s++;
+    if (*previousString)
+      previousString++;
+  }
+
+  //
+  // erase what's left of a longer previous string
+  //
+  if (previousEndingColumnX > columnX)
+  {
+    for (bank = 0; bank < scale; bank++)
+      lcdDrawRowOfPixels(columnX, previousEndingColumnX - 1, lineNumber + bank, 0x00);
+  }
+
+  lcdSetCursorXY(columnX, lineNumber);
+}
+
+
+
+//
+// print one character with each pixel scaled up, the glyph is drawn one line 
+// of the display at a time, then the cursor is moved to the top right of it
+//  Enter:  character = character to display
+//          scale = 1 to LCD_MAX_TEXT_SCALE
+//
+void ArduinoUserInterface::lcdPrintCharacterLarge(byte character, byte scale)
+{
+  byte glyph[LCD_FONT_MAX_GLYPH_WIDTH + 1];
+  unsigned long scaledColumns[LCD_FONT_MAX_GLYPH_WIDTH + 1];
+  byte lineOfPixels[(LCD_FONT_MAX_GLYPH_WIDTH + 1) * LCD_MAX_TEXT_SCALE];
+  byte glyphWidth;
+  byte pixelColumn;
+  byte pixelRow;
+  byte bank;
+  byte repeat;
+  byte byteOfPixels;
+  int pixelCount;
+  int startingColumnX;
+  byte lineNumber;
+
+  if (scale < 1)
+    scale = 1;
+  if (scale > LCD_MAX_TEXT_SCALE)
+    scale = LCD_MAX_TEXT_SCALE;
+
+  startingColumnX = lcdCursorColumnX;
+  lineNumber = lcdCursorRowY;
+
+  //
+  // get the glyph and its blank column, then stretch each column of 8 pixels 
+  // to 8 * scale pixels
+  //
+  glyphWidth = lcdGetGlyph(lcdFont, character, glyph);
+  glyph[glyphWidth] = 0x00;
+  glyphWidth++;
+
+  for (pixelColumn = 0; pixelColumn < glyphWidth; pixelColumn++)
+  {
+    scaledColumns[pixelColumn] = 0;
+    for (pixelRow = 0; pixelRow < 8; pixelRow++)
+    {
+      if (glyph[pixelColumn] & (1 << pixelRow))
+        scaledColumns[pixelColumn] |= ((1UL << scale) - 1) << (pixelRow * scale);
+    }
+  }
+
+  //
+  // clip the glyph at the right edge of the display
+  //
+  pixelCount = glyphWidth * scale;
+  if (startingColumnX + pixelCount > LCD_WIDTH_IN_PIXELS)
+    pixelCount = LCD_WIDTH_IN_PIXELS - startingColumnX;
+
+  //
+  // draw each line, repeating every column scale times
+  //
+  if (pixelCount > 0)
+  {
+    for (bank = 0; bank < scale; bank++)
+    {
+      for (pixelColumn = 0; pixelColumn < glyphWidth; pixelColumn++)
       {
-        buttonState = WAITING_FOR_ALL_BUTTONS_UP_STATE;  // something IS pressed so start over
-        break;                                           // return no event
+        byteOfPixels = scaledColumns[pixelColumn] >> (bank * 8);
+        for (repeat = 0; repeat < scale; repeat++)
+          lineOfPixels[(pixelColumn * scale) + repeat] = byteOfPixels;
       }
 
-      //
-      // button has been released now
-      //
-      buttonState = WAITING_FOR_BUTTON_DOWN_STATE;       // cycle of button events complete
-      return(BUTTON_RELEASED_EVENT + buttonID);          // return button "Up" event
-    }
+      lcdSetCursorXY(startingColumnX, lineNumber + bank);
+      lcdWriteDataBurst(lineOfPixels, pixelCount);
+    }
+  }
+
+  //
+  // move the cursor forward by one character, on the top line
+  //
+  lcdSetCursorXY(startingColumnX + (glyphWidth * scale), lineNumber);
+}
+
+
+
+//
+// clear the LCD display by writing blank pixels
+//
+void ArduinoUserInterface::lcdClearDisplay(void)
+{
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_CLEAR_DISPLAY);
+
+  //
+  // move cursor to the beginning
+  //
+  lcdSetCursorXY(0, 0);          
+
+  //
+  // write enough blank pixels to clear the display
+  //
+  lcdWriteDataFill(0x00, LCD_WIDTH_IN_PIXELS * LCD_HEIGHT_IN_PIXELS / 8);
+  
+  //
+  // move cursor to the beginning
+  //
+  lcdSetCursorXY(0, 0);          
+}
+
+
+
+//
+// fill current line, beginning at the cursor location with a repeating column 
+// of 8 pixels up to the X column
+//          X = fill up to, but not including this column, the cursor will 
+//              then be at this column
+//          byteOfPixels = byte of pixels to repeat
+//
+void ArduinoUserInterface::lcdFillToColumnX(int X, byte byteOfPixels)
+{
+  X--;
+  if(X < 0)
+    return;
+    
+  lcdDrawRowOfPixels(lcdCursorColumnX, X, lcdCursorRowY, byteOfPixels);
+}
+
+
+
+//
+// fill current line, beginning at the cursor location to the end of the line, 
+// with a repeating column of 8 pixels
+//          byteOfPixels = byte of pixels to repeat
+//
+void ArduinoUserInterface::lcdFillToEndOfLine(byte byteOfPixels)
+{
+  lcdDrawRowOfPixels(lcdCursorColumnX, LCD_LAST_COLUMN_X, lcdCursorRowY, byteOfPixels);
+}
+
+
+
+//
+// draw a row of pixels, repeating the same column of 8 pixels across
+//  Enter:  X1 = starting pixel column (0 - 83, 0 = left most column)
+//          X2 = ending pixel column (0 - 83)
+//          lineNumber = character line (0 - 5, 0 = top row)
+//          byteOfPixels = byte of pixels to repeat
+//
+void ArduinoUserInterface::lcdDrawRowOfPixels(int X1, int X2, int lineNumber, 
+                                              byte byteOfPixels)
+{
+  int pixelCount;
+
+  //
+  // move to the first pixel
+  //
+  lcdSetCursorXY(X1, lineNumber);
+
+
+  //
+  // write the pixels
+  //
+  pixelCount = X2 - X1 + 1;
+  if(pixelCount <= 0)
+    return;
+  
+  lcdWriteDataFill(byteOfPixels, pixelCount);
+
+  //
+  // remember the cursor location
+  //
+  lcdCursorColumnX += pixelCount;
+}
+
+
+
+//
+// set the coords where the next character will be written to the LCD display
+//  Enter:  column = pixel column (0 - 83, 0 = left most column)
+//          lineNumber = character line (0 - 5, 0 = top row)
+//
+void ArduinoUserInterface::lcdSetCursorXY(int column, int lineNumber)
+{
+  LCD_INSTRUMENT_COUNT(CursorMoveCount);
+
+  lcdCursorColumnX = column;        // remember the LCD's cursor position
+  lcdCursorRowY = lineNumber; 
+
+  //
+  // when drawing into the frame buffer, only the position in the buffer is set
+  //
+  if (lcdFrameBuffer != NULL)
+  {
+    lcdFrameBufferX = (column < LCD_WIDTH_IN_PIXELS) ? column : LCD_LAST_COLUMN_X;
+    lcdFrameBufferY = (lineNumber < LCD_HEIGHT_IN_LINES) ? lineNumber : LCD_HEIGHT_IN_LINES - 1;
+    return;
+  }
+
+  lcdSetAddress(column, lineNumber);
+}
+
+
+
+//
+// set the LCD screen contrast value 
+//  Enter:  contrastValue = value to set for the screen's contrast (0 - 127)
+//
+void ArduinoUserInterface::lcdSetContrast(int contrastValue)
+{
+  lcdWriteCommand(0x21);                      // set H bit to program config registers
+  lcdWriteCommand(contrastValue | 0x80);      // set LCD Vop (Contrast) (0x80 - 0xff)
+  lcdWriteCommand(0x20);                      // clear H bit to access X & Y registers
+}
+
+
+
+//
+// draw into a frame buffer in RAM rather than directly to the LCD, only the 
+// bytes that change are sent to the LCD when lcdFlush() is called (which is also
+// done each time getButtonEvent() is called)
+//  Enter:  frameBuffer -> array of LCD_FRAME_BUFFER_SIZE bytes supplied by the 
+//            application, or NULL to go back to drawing directly to the LCD
+//
+void ArduinoUserInterface::lcdUseFrameBuffer(byte *frameBuffer)
+{
+  byte lineNumber;
+
+  //
+  // send anything remaining in the old frame buffer before switching
+  //
+  lcdFlush();
+  lcdFrameBuffer = frameBuffer;
+  if (lcdFrameBuffer == NULL)
+    return;
+
+  //
+  // start with a blank buffer, marking every line as changed so the first 
+  // flush makes the LCD match the buffer
+  //
+  memset(lcdFrameBuffer, 0, LCD_FRAME_BUFFER_SIZE);
+  for (lineNumber = 0; lineNumber < LCD_HEIGHT_IN_LINES; lineNumber++)
+  {
+    lcdFrameBufferDirtyFirstX[lineNumber] = 0;
+    lcdFrameBufferDirtyLastX[lineNumber] = LCD_LAST_COLUMN_X;
+  }
+
+  lcdSetCursorXY(lcdCursorColumnX, lcdCursorRowY);
+}
+
+
+
+//
+// send the changed parts of the frame buffer to the LCD, nothing is done if 
+// not drawing into a frame buffer
+//
+void ArduinoUserInterface::lcdFlush(void)
+{
+  byte lineNumber;
+  byte *frameBufferByte;
+  int count;
+
+  if (lcdFrameBuffer == NULL)
+    return;
+
+  LCD_INSTRUMENT_OPERATION(LCD_OPERATION_FLUSH);
+
+  //
+  // send the span of bytes that changed on each line
+  //
+  for (lineNumber = 0; lineNumber < LCD_HEIGHT_IN_LINES; lineNumber++)
+  {
+    if (lcdFrameBufferDirtyFirstX[lineNumber] > lcdFrameBufferDirtyLastX[lineNumber])
+      continue;
+
+    lcdSetAddress(lcdFrameBufferDirtyFirstX[lineNumber], lineNumber);
+
+    frameBufferByte = &lcdFrameBuffer[(lineNumber * LCD_WIDTH_IN_PIXELS) + lcdFrameBufferDirtyFirstX[lineNumber]];
+    count = lcdFrameBufferDirtyLastX[lineNumber] - lcdFrameBufferDirtyFirstX[lineNumber] + 1;
+
+    lcdBeginTransfer(LCD_DATA_BYTE);
+    while (count > 0)
+    {
+      lcdSerialOut(*frameBufferByte++);
+      count--;
+    }
+    lcdEndTransfer();
+    lcdAdvanceAddress(lcdFrameBufferDirtyLastX[lineNumber] - lcdFrameBufferDirtyFirstX[lineNumber] + 1);
+
+    //
+    // mark the line as unchanged
+    //
+    lcdFrameBufferDirtyFirstX[lineNumber] = 0xff;
+    lcdFrameBufferDirtyLastX[lineNumber] = 0;
+  }
+}
+
+
+
+//
+// write an image of the frame buffer as a plain PBM file, this can be used to 
+// capture the screen over the serial port, or to compare what was drawn 
+// against a saved image.  Nothing is written if not drawing into a frame buffer.
+//  Enter:  output = stream to write the image to, such as Serial
+//
+void ArduinoUserInterface::lcdWriteFrameBufferAsPBM(Print &output)
+{
+  byte pixelY;
+  byte pixelX;
+  byte frameBufferByte;
+
+  if (lcdFrameBuffer == NULL)
+    return;
+
+  //
+  // write the header, then one row of pixels per line of text, 1 is a black 
+  // pixel
+  //
+  output.print(F("P1\n84 48\n"));
+  for (pixelY = 0; pixelY < LCD_HEIGHT_IN_PIXELS; pixelY++)
+  {
+    for (pixelX = 0; pixelX < LCD_WIDTH_IN_PIXELS; pixelX++)
+    {
+      frameBufferByte = lcdFrameBuffer[((pixelY >> 3) * LCD_WIDTH_IN_PIXELS) + pixelX];
+      output.write((frameBufferByte & (1 << (pixelY & 0x07))) ? '1' : '0');
+    }
+    output.write('\n');
+  }
+}
+
+
+
+//
+// set the function that bytes are given to when using the 
+// LCD_TRANSPORT_CALLBACK transport, this must be called before connectToPins().  
+// The function can feed an LCD emulator, record the bytes for comparing 
+// against a known good run, or count the bytes sent by each function.
+//  Enter:  transportCallback -> function called with each byte sent to the LCD, 
+//            dataOrCommand is HIGH for data bytes and LOW for commands
+//
+void ArduinoUserInterface::lcdSetTransportCallback(void (*transportCallback)(byte dataOrCommand, byte lcdByte))
+{
+  lcdTransportCallback = transportCallback;
+}
+
+
+
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+//
+// print the most recently measured drawing operations, oldest first, then 
+// empty the trace.  Each line gives the operation, the number of commands, 
+// data bytes and cursor moves sent to the LCD, and the time in microseconds.
+//  Enter:  output = stream to print the trace to, such as Serial
+//
+void ArduinoUserInterface::lcdPrintInstrumentTrace(Print &output)
+{
+  LCD_INSTRUMENT_RECORD *record;
+  byte idx;
+
+  idx = (lcdInstrumentTraceHead - lcdInstrumentTraceCount) & (LCD_INSTRUMENT_TRACE_SIZE - 1);
+  while (lcdInstrumentTraceCount > 0)
+  {
+    record = &lcdInstrumentTrace[idx];
+    switch(record->Operation)
+    {
+      case LCD_OPERATION_DRAW_MENU:           output.print(F("drawMenu")); break;
+      case LCD_OPERATION_MOVE_MENU_SELECTION: output.print(F("moveMenuSelection")); break;
+      case LCD_OPERATION_DRAW_SLIDER:         output.print(F("drawSlider")); break;
+      case LCD_OPERATION_UPDATE_SLIDER:       output.print(F("updateSlider")); break;
+      case LCD_OPERATION_DRAW_BUTTON_BAR:     output.print(F("drawButtonBar")); break;
+      case LCD_OPERATION_CLEAR_DISPLAY_SPACE: output.print(F("clearDisplaySpace")); break;
+      case LCD_OPERATION_CLEAR_DISPLAY:       output.print(F("lcdClearDisplay")); break;
+      case LCD_OPERATION_PRINT_STRING:        output.print(F("lcdPrintString")); break;
+      case LCD_OPERATION_FLUSH:               output.print(F("lcdFlush")); break;
+    }
+
+    output.print(F(": cmds="));
+    output.print(record->CommandCount);
+    output.print(F(" data="));
+    output.print(record->DataByteCount);
+    output.print(F(" moves="));
+    output.print(record->CursorMoveCount);
+    output.print(F(" uS="));
+    output.println(record->ElapsedMicros);
+
+    idx = (idx + 1) & (LCD_INSTRUMENT_TRACE_SIZE - 1);
+    lcdInstrumentTraceCount--;
+  }
+}
+
+
+
+//
+// start measuring a drawing operation, nothing is done if already inside 
+// another operation
+//  Enter:  operation = LCD_OPERATION_DRAW_MENU, LCD_OPERATION_DRAW_SLIDER...
+//
+void ArduinoUserInterface::lcdInstrumentBegin(byte operation)
+{
+  lcdInstrumentDepth++;
+  if (lcdInstrumentDepth != 1)
+    return;
+
+  lcdInstrumentRecord.Operation = operation;
+  lcdInstrumentRecord.CommandCount = 0;
+  lcdInstrumentRecord.DataByteCount = 0;
+  lcdInstrumentRecord.CursorMoveCount = 0;
+  lcdInstrumentRecord.ElapsedMicros = micros();
+}
+
+
+
+//
+// finish measuring a drawing operation, adding it to the trace unless nothing 
+// was sent to the LCD, when the trace is full the oldest record is replaced
+//
+void ArduinoUserInterface::lcdInstrumentEnd(void)
+{
+  lcdInstrumentDepth--;
+  if (lcdInstrumentDepth != 0)
+    return;
+
+  if ((lcdInstrumentRecord.CommandCount == 0) && (lcdInstrumentRecord.DataByteCount == 0) &&
+      (lcdInstrumentRecord.CursorMoveCount == 0))
+    return;
+
+  lcdInstrumentRecord.ElapsedMicros = micros() - lcdInstrumentRecord.ElapsedMicros;
+  lcdInstrumentTrace[lcdInstrumentTraceHead] = lcdInstrumentRecord;
+  lcdInstrumentTraceHead = (lcdInstrumentTraceHead + 1) & (LCD_INSTRUMENT_TRACE_SIZE - 1);
+  if (lcdInstrumentTraceCount < LCD_INSTRUMENT_TRACE_SIZE)
+    lcdInstrumentTraceCount++;
+}
+#endif
+
+
+
+//
+// write one data byte into the frame buffer, advancing the position in the  
+// buffer the same way the LCD advances its address
+//
+void ArduinoUserInterface::lcdFrameBufferWrite(byte data)
+{
+  byte *frameBufferByte;
+
+  //
+  // only bytes that change need to be sent to the LCD
+  //
+  frameBufferByte = &lcdFrameBuffer[(lcdFrameBufferY * LCD_WIDTH_IN_PIXELS) + lcdFrameBufferX];
+  if (*frameBufferByte != data)
+  {
+    *frameBufferByte = data;
+
+    if (lcdFrameBufferX < lcdFrameBufferDirtyFirstX[lcdFrameBufferY])
+      lcdFrameBufferDirtyFirstX[lcdFrameBufferY] = lcdFrameBufferX;
+
+    if (lcdFrameBufferX > lcdFrameBufferDirtyLastX[lcdFrameBufferY])
+      lcdFrameBufferDirtyLastX[lcdFrameBufferY] = lcdFrameBufferX;
   }
 
-  return(BUTTON_NO_EVENT);
+  //
+  // move to the next column, wrapping to the next line, then back to the top
+  //
+  lcdFrameBufferX++;
+  if (lcdFrameBufferX >= LCD_WIDTH_IN_PIXELS)
+  {
+    lcdFrameBufferX = 0;
+    lcdFrameBufferY++;
+    if (lcdFrameBufferY >= LCD_HEIGHT_IN_LINES)
+      lcdFrameBufferY = 0;
+  }
 }
 
 
 
 //
-// check if any buttons are pushed and return its button number
-//  Exit: PUSH_BUTTON_DOWN or PUSH_BUTTON_UP
-//          or PUSH_BUTTON_BACK or PUSH_BUTTON_NONE
+// set the LCD's address counter, commands are only sent for the parts of the 
+// address that change, if the LCD's address counter is already at column X, 
+// or on the right line, that command isn't needed
+//  Enter:  column = pixel column (0 - 83)
+//          lineNumber = character line (0 - 5)
 //
-byte ArduinoUserInterface::readButtonsToGetButtonID(void)
+void ArduinoUserInterface::lcdSetAddress(int column, int lineNumber)
 {
-  int buttonAnalogValue;
+  byte knownX;
+  byte knownY;
 
   //
-  // determine analog voltage readings based on the resistor ladder
+  // sending a command forgets the address, so it's copied first
   //
-  const int DOWN_BUTTON_VALUE = 1024.0 * 0.658;
-  const int UP_BUTTON_VALUE = 1024.0 * 0.476;
-  const int BACK_BUTTON_VALUE = 1024.0 * 0.312;
-  const int SELECT_BUTTON_VALUE = 1024.0 * 0.0;
-  
+  knownX = lcdAddressX;
+  knownY = lcdAddressY;
+
+  if (column != knownX)
+    lcdWriteCommand(0x80 | column);
+
+  if (lineNumber != knownY)
+    lcdWriteCommand(0x40 | lineNumber);
+
   //
-  // read the button voltage, then determine which button it is
+  // remember the address, unless it's off the screen where the LCD's behavior 
+  // isn't known
   //
-  buttonAnalogValue = analogRead(buttonAnalogPin);
-  
-  if (intInRange(buttonAnalogValue, DOWN_BUTTON_VALUE - 40, DOWN_BUTTON_VALUE + 40))
-    return(BUTTON_ID_DOWN);
+  if ((column < LCD_WIDTH_IN_PIXELS) && (lineNumber < LCD_HEIGHT_IN_LINES))
+  {
+    lcdAddressX = column;
+    lcdAddressY = lineNumber;
+  }
+  else
+  {
+    lcdAddressX = LCD_ADDRESS_UNKNOWN;
+    lcdAddressY = LCD_ADDRESS_UNKNOWN;
+  }
+}
 
-  if (intInRange(buttonAnalogValue, UP_BUTTON_VALUE - 40, UP_BUTTON_VALUE + 40))
-    return(BUTTON_ID_UP);
 
-  if (intInRange(buttonAnalogValue, BACK_BUTTON_VALUE - 40, BACK_BUTTON_VALUE + 40))
-    return(BUTTON_ID_BACK);
 
-  if (intInRange(buttonAnalogValue, SELECT_BUTTON_VALUE - 0, SELECT_BUTTON_VALUE + 80))
-    return(BUTTON_ID_SELECT);
+//
+// advance the copy of the LCD's address counter past data bytes being sent, 
+// the LCD moves to the next column after each byte, wrapping to the next line, 
+// then from the bottom line back to the top
+//  Enter:  count = number of data bytes
+//
+void ArduinoUserInterface::lcdAdvanceAddress(int count)
+{
+  int column;
+
+  if (lcdAddressX == LCD_ADDRESS_UNKNOWN)
+    return;
 
-  return(BUTTON_ID_NONE);      
+  column = lcdAddressX + count;
+  while (column >= LCD_WIDTH_IN_PIXELS)
+  {
+    column -= LCD_WIDTH_IN_PIXELS;
+    lcdAddressY++;
+    if (lcdAddressY >= LCD_HEIGHT_IN_LINES)
+      lcdAddressY = 0;
+  }
+  lcdAddressX = column;
 }
 
 
 
 //
-// test if a number is in the given range
-//  Enter:  value = number to test
-//          lowerValue = bottom of range (inclusive)
-//          upperValue = top of range (inclusive)
-//  Exit:   true return if value is in range
+// write a single command byte to the LCD display, the copy of the LCD's 
+// address counter is forgotten since the command may change it
 //
-boolean ArduinoUserInterface::intInRange(int value, int lowerValue, int upperValue)
+void ArduinoUserInterface::lcdWriteCommand(byte command)
 {
-  if ((value <= upperValue)  && (value >= lowerValue))
-    return(true);
-  else
-    return(false);
+  lcdBeginTransfer(LCD_COMMAND_BYTE);
+  lcdSerialOut(command);
+  lcdEndTransfer();
+
+  lcdAddressX = LCD_ADDRESS_UNKNOWN;
+  lcdAddressY = LCD_ADDRESS_UNKNOWN;
 }
 
 
 
 //
-// draw the button bar
-//  Enter:  leftButtonText -> text for left button, empty string will draw no 
-//            button
-//          rightButtonText -> text for right button, empty string will draw no 
-//            button
+// write a block of data bytes to the LCD display, the LCD is selected once for 
+// the entire block rather than for each byte
+//  Enter:  data -> the bytes to write
+//          count = number of bytes to write
 //
-void ArduinoUserInterface::drawButtonBar(char *leftButtonText, char *rightButtonText)
+void ArduinoUserInterface::lcdWriteDataBurst(const byte *data, int count)
 {
-  byte leftButtonLeftX = 0;
-  byte leftButtonRightX = leftButtonLeftX + BUTTON_WIDTH;
-  byte rightButtonLeftX = RIGHT_BUTTON_CENTER_X - BUTTON_WIDTH/2;
-  byte rightButtonRightX = rightButtonLeftX + BUTTON_WIDTH - 1;
-  
-  //
-  // move cursor to the button bar line
-  //
-  lcdSetCursorXY(leftButtonLeftX, LCD_HEIGHT_IN_LINES - 1);
+  if (lcdFrameBuffer != NULL)
+  {
+    while (count > 0)
+    {
+      lcdFrameBufferWrite(*data++);
+      count--;
+    }
+    return;
+  }
 
-  //
-  // draw the left button if not blank
-  //
-  if (leftButtonText[0] != 0)
-    lcdPrintCenteredStringReverse(leftButtonText, LEFT_BUTTON_CENTER_X, BUTTON_WIDTH);
-  
-  //
-  // draw white between the buttons
-  //
-  lcdFillToColumnX(rightButtonLeftX - 1, 0);
+  lcdAdvanceAddress(count);
 
-  //
-  // draw the right button if not blank
-  //
-  if (rightButtonText[0] != 0)
-    lcdPrintCenteredStringReverse(rightButtonText, RIGHT_BUTTON_CENTER_X, BUTTON_WIDTH);
-  else
-    lcdFillToEndOfLine(0);
+  lcdBeginTransfer(LCD_DATA_BYTE);
+  while (count > 0)
+  {
+    lcdSerialOut(*data++);
+    count--;
+  }
+  lcdEndTransfer();
+}
 
-  //
-  // draw a line above the left button so upper case letters are covered
-  //
-  lcdSetCursorXY(leftButtonLeftX, LCD_HEIGHT_IN_LINES - 2);
-  if (leftButtonText[0] != 0)
-    lcdFillToColumnX(leftButtonRightX, 0x80);
+
+
+//
+// write the same data byte to the LCD display many times, the LCD is selected 
+// once for all of them
+//  Enter:  data = the byte to write
+//          count = number of times to write it
+//
+void ArduinoUserInterface::lcdWriteDataFill(byte data, int count)
+{
+  if (lcdFrameBuffer != NULL)
+  {
+    while (count > 0)
+    {
+      lcdFrameBufferWrite(data);
+      count--;
+    }
+    return;
+  }
+
+  lcdAdvanceAddress(count);
+
+  lcdBeginTransfer(LCD_DATA_BYTE);
+  while (count > 0)
+  {
+    lcdSerialOut(data);
+    count--;
+  }
+  lcdEndTransfer();
+}
+
+
+
+//
+// select the LCD so that bytes can be transmitted to it
+//  Enter:  dataOrCommand = LCD_DATA_BYTE or LCD_COMMAND_BYTE
+//
+void ArduinoUserInterface::lcdBeginTransfer(byte dataOrCommand)
+{
+#if defined(__AVR__)
+  uint8_t oldSREG;
+#endif
+
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+  lcdTransferDataOrCommand = dataOrCommand;
+#endif
 
   //
-  // draw white space between buttons on line above
+  // when bytes are given to a callback function, just remember their type
   //
-  lcdFillToColumnX(rightButtonLeftX-1, 0);
+  if (lcdTransport == LCD_TRANSPORT_CALLBACK)
+  {
+    lcdTransferDataOrCommand = dataOrCommand;
+    return;
+  }
 
+  if (lcdTransport == LCD_TRANSPORT_HARDWARE_SPI)
+    SPI.beginTransaction(SPISettings(LCD_SPI_CLOCK_RATE, MSBFIRST, SPI_MODE0));
 
+#if defined(__AVR__)
   //
-  // draw a line above the left button so upper case letters are covered
+  // setting a bit through a port pointer is a read-modify-write, interrupts are 
+  // disabled so an ISR writing another pin on the same port isn't undone
   //
-  if (rightButtonText[0] != 0)
-    lcdFillToColumnX(rightButtonRightX, 0x80);
+  oldSREG = SREG;
+  cli();
+  if (dataOrCommand == LCD_DATA_BYTE)
+    *lcdDataControlPort |= lcdDataControlBitMask;
   else
-    lcdFillToEndOfLine(0);
-}
+    *lcdDataControlPort &= ~lcdDataControlBitMask;
 
+  *lcdChipEnablePort &= ~lcdChipEnableBitMask;
+  SREG = oldSREG;
+#else
+  digitalWrite(lcdDataControlPin, dataOrCommand);
+  digitalWrite(lcdChipEnablePin, LOW);
+#endif
+}
 
-// ---------------------------------------------------------------------------------
-//                                    LCD functions  
-// ---------------------------------------------------------------------------------
 
 
 //
-// constants for the LCD display
+// deselect the LCD after transmitting bytes to it
 //
-const int LCD_COMMAND_BYTE = LOW;
-const int LCD_DATA_BYTE = HIGH;
+void ArduinoUserInterface::lcdEndTransfer(void)
+{
+#if defined(__AVR__)
+  uint8_t oldSREG;
+#endif
 
+  if (lcdTransport == LCD_TRANSPORT_CALLBACK)
+    return;
 
-//
-// ASCII font, 5 x 8 pixels, this font is stored in program memory rather than RAM
-//
+#if defined(__AVR__)
+  oldSREG = SREG;
+  cli();
+  *lcdChipEnablePort |= lcdChipEnableBitMask;
+  SREG = oldSREG;
+#else
+  digitalWrite(lcdChipEnablePin, HIGH);
+#endif
 
-const byte Font[][5] PROGMEM = 
-  {
-   {0x00, 0x00, 0x00, 0x00, 0x00},     // 20  
-   {0x00, 0x00, 0x5f, 0x00, 0x00},     // 21 !
-   {0x00, 0x07, 0x00, 0x07, 0x00},     // 22 "
-   {0x14, 0x7f, 0x14, 0x7f, 0x14},     // 23 #
-   {0x24, 0x2a, 0x7f, 0x2a, 0x12},     // 24 $
-   {0x23, 0x13, 0x08, 0x64, 0x62},     // 25 %
-   {0x36, 0x49, 0x55, 0x22, 0x50},     // 26 &
-   {0x00, 0x05, 0x03, 0x00, 0x00},     // 27 '
-   {0x00, 0x1c, 0x22, 0x41, 0x00},     // 28 (
-   {0x00, 0x41, 0x22, 0x1c, 0x00},     // 29 )
-   {0x14, 0x08, 0x3e, 0x08, 0x14},     // 2a *
-   {0x08, 0x08, 0x3e, 0x08, 0x08},     // 2b +
-   {0x00, 0x50, 0x30, 0x00, 0x00},     // 2c ,
-   {0x08, 0x08, 0x08, 0x08, 0x08},     // 2d -
-   {0x00, 0x60, 0x60, 0x00, 0x00},     // 2e .
-   {0x20, 0x10, 0x08, 0x04, 0x02},     // 2f /
-   {0x3e, 0x51, 0x49, 0x45, 0x3e},     // 30 0
-   {0x00, 0x42, 0x7f, 0x40, 0x00},     // 31 1
-   {0x42, 0x61, 0x51, 0x49, 0x46},     // 32 2
-   {0x21, 0x41, 0x45, 0x4b, 0x31},     // 33 3
-   {0x18, 0x14, 0x12, 0x7f, 0x10},     // 34 4
-   {0x27, 0x45, 0x45, 0x45, 0x39},     // 35 5
-   {0x3c, 0x4a, 0x49, 0x49, 0x30},     // 36 6
-   {0x01, 0x71, 0x09, 0x05, 0x03},     // 37 7
-   {0x36, 0x49, 0x49, 0x49, 0x36},     // 38 8
-   {0x06, 0x49, 0x49, 0x29, 0x1e},     // 39 9
-   {0x00, 0x36, 0x36, 0x00, 0x00},     // 3a :
-   {0x00, 0x56, 0x36, 0x00, 0x00},     // 3b ;
-   {0x08, 0x14, 0x22, 0x41, 0x00},     // 3c <
-   {0x14, 0x14, 0x14, 0x14, 0x14},     // 3d =
-   {0x00, 0x41, 0x22, 0x14, 0x08},     // 3e >
-   {0x02, 0x01, 0x51, 0x09, 0x06},     // 3f ?
-   {0x32, 0x49, 0x79, 0x41, 0x3e},     // 40 @
-   {0x7e, 0x11, 0x11, 0x11, 0x7e},     // 41 A
-   {0x7f, 0x49, 0x49, 0x49, 0x36},     // 42 B
-   {0x3e, 0x41, 0x41, 0x41, 0x22},     // 43 C
-   {0x7f, 0x41, 0x41, 0x22, 0x1c},     // 44 D
-   {0x7f, 0x49, 0x49, 0x49, 0x41},     // 45 E
-   {0x7f, 0x09, 0x09, 0x09, 0x01},     // 46 F
-   {0x3e, 0x41, 0x49, 0x49, 0x7a},     // 47 G
-   {0x7f, 0x08, 0x08, 0x08, 0x7f},     // 48 H
-   {0x00, 0x41, 0x7f, 0x41, 0x00},     // 49 I
-   {0x20, 0x40, 0x41, 0x3f, 0x01},     // 4a J
-   {0x7f, 0x08, 0x14, 0x22, 0x41},     // 4b K
-   {0x7f, 0x40, 0x40, 0x40, 0x40},     // 4c L
-   {0x7f, 0x02, 0x0c, 0x02, 0x7f},     // 4d M
-   {0x7f, 0x04, 0x08, 0x10, 0x7f},     // 4e N
-   {0x3e, 0x41, 0x41, 0x41, 0x3e},     // 4f O
-   {0x7f, 0x09, 0x09, 0x09, 0x06},     // 50 P
-   {0x3e, 0x41, 0x51, 0x21, 0x5e},     // 51 Q
-   {0x7f, 0x09, 0x19, 0x29, 0x46},     // 52 R
-   {0x46, 0x49, 0x49, 0x49, 0x31},     // 53 S
-   {0x01, 0x01, 0x7f, 0x01, 0x01},     // 54 T
-   {0x3f, 0x40, 0x40, 0x40, 0x3f},     // 55 U
-   {0x1f, 0x20, 0x40, 0x20, 0x1f},     // 56 V
-   {0x3f, 0x40, 0x38, 0x40, 0x3f},     // 57 W
-   {0x63, 0x14, 0x08, 0x14, 0x63},     // 58 X
-   {0x07, 0x08, 0x70, 0x08, 0x07},     // 59 Y
-   {0x61, 0x51, 0x49, 0x45, 0x43},     // 5a Z
-   {0x00, 0x7f, 0x41, 0x41, 0x00},     // 5b [
-   {0x02, 0x04, 0x08, 0x10, 0x20},     // 5c 
-   {0x00, 0x41, 0x41, 0x7f, 0x00},     // 5d ]
-   {0x04, 0x02, 0x01, 0x02, 0x04},     // 5e ^
-   {0x40, 0x40, 0x40, 0x40, 0x40},     // 5f _
-   {0x00, 0x01, 0x02, 0x04, 0x00},     // 60 `
-   {0x20, 0x54, 0x54, 0x54, 0x78},     // 61 a
-   {0x7f, 0x48, 0x44, 0x44, 0x38},     // 62 b
-   {0x38, 0x44, 0x44, 0x44, 0x20},     // 63 c
-   {0x38, 0x44, 0x44, 0x48, 0x7f},     // 64 d
-   {0x38, 0x54, 0x54, 0x54, 0x18},     // 65 e
-   {0x08, 0x7e, 0x09, 0x01, 0x02},     // 66 f
-   {0x0c, 0x52, 0x52, 0x52, 0x3e},     // 67 g
-   {0x7f, 0x08, 0x04, 0x04, 0x78},     // 68 h
-   {0x00, 0x44, 0x7d, 0x40, 0x00},     // 69 i
-   {0x20, 0x40, 0x44, 0x3d, 0x00},     // 6a j 
-   {0x7f, 0x10, 0x28, 0x44, 0x00},     // 6b k
-   {0x00, 0x41, 0x7f, 0x40, 0x00},     // 6c l
-   {0x7c, 0x04, 0x18, 0x04, 0x78},     // 6d m
-   {0x7c, 0x08, 0x04, 0x04, 0x78},     // 6e n
-   {0x38, 0x44, 0x44, 0x44, 0x38},     // 6f o
-   {0x7c, 0x14, 0x14, 0x14, 0x08},     // 70 p
-   {0x08, 0x14, 0x14, 0x18, 0x7c},     // 71 q
-   {0x7c, 0x08, 0x04, 0x04, 0x08},     // 72 r
-   {0x48, 0x54, 0x54, 0x54, 0x20},     // 73 s
-   {0x04, 0x3f, 0x44, 0x40, 0x20},     // 74 t
-   {0x3c, 0x40, 0x40, 0x20, 0x7c},     // 75 u
-   {0x1c, 0x20, 0x40, 0x20, 0x1c},     // 76 v
-   {0x3c, 0x40, 0x30, 0x40, 0x3c},     // 77 w
-   {0x44, 0x28, 0x10, 0x28, 0x44},     // 78 x
-   {0x0c, 0x50, 0x50, 0x50, 0x3c},     // 79 y
-   {0x44, 0x64, 0x54, 0x4c, 0x44},     // 7a z
-   {0x00, 0x08, 0x36, 0x41, 0x00},     // 7b {
-   {0x00, 0x00, 0x7f, 0x00, 0x00},     // 7c |
-   {0x00, 0x41, 0x36, 0x08, 0x00},     // 7d }
-   {0x10, 0x08, 0x08, 0x10, 0x08},     // 7e ~
-   {0x78, 0x46, 0x41, 0x46, 0x78},     // 7f 
-   {0x3c, 0x3c, 0x18, 0x18, 0x00}      // 80 right pointing arrow 
-  };
+  if (lcdTransport == LCD_TRANSPORT_HARDWARE_SPI)
+    SPI.endTransaction();
+}
 
 
-// ---------------------------------------------------------------------------------
 
 //
-// initialize the LCD display
+// serially transmit the data byte
 //
-void ArduinoUserInterface::lcdInitialise(void)
+void ArduinoUserInterface::lcdSerialOut(byte data)
 {
+  byte bitCount = 8;
+#if defined(__AVR__)
+  ARDUINO_USER_INTERFACE_PORT_REGISTER *clockPort = lcdClockPort;
+  ARDUINO_USER_INTERFACE_PORT_REGISTER *dataInPort = lcdDataInPort;
+  byte clockBitMask = lcdClockBitMask;
+  byte dataInBitMask = lcdDataInBitMask;
+  uint8_t oldSREG;
+#endif
+
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+  if (lcdTransferDataOrCommand == LCD_DATA_BYTE)
+    LCD_INSTRUMENT_COUNT(DataByteCount);
+  else
+    LCD_INSTRUMENT_COUNT(CommandCount);
+#endif
+
   //
-  // setup the IO pins
+  // if the LCD is wired to the SPI pins, let the hardware shift out the bits, 
+  // or give the byte to the application's transport function
   //
-  digitalWrite(lcdChipEnablePin, HIGH);
-  pinMode(lcdChipEnablePin, OUTPUT);
-  digitalWrite(lcdChipEnablePin, HIGH);
+  if (lcdTransport != LCD_TRANSPORT_BIT_BANG)
+  {
+    if (lcdTransport == LCD_TRANSPORT_HARDWARE_SPI)
+      SPI.transfer(data);
+    else
+      lcdTransportCallback(lcdTransferDataOrCommand, data);
+    return;
+  }
 
-  pinMode(lcdDataControlPin, OUTPUT);
-  pinMode(lcdDataInPin, OUTPUT);
+#if defined(__AVR__)
+  //
+  // transmit 8 bits by writing directly to the port registers, the pointers 
+  // and masks are copied into locals above so they stay in CPU registers.  
+  // Interrupts are disabled for the byte (about 3uS) since each write is a 
+  // read-modify-write of the whole port.
+  //
+  oldSREG = SREG;
+  cli();
+  do
+  {
+    if (data & 0x80)
+      *dataInPort |= dataInBitMask;
+    else
+      *dataInPort &= ~dataInBitMask;
 
-  pinMode(lcdClockPin, OUTPUT);
-  digitalWrite(lcdClockPin, LOW);
+    *clockPort |= clockBitMask;
+    data = data << 1;
+    bitCount--;
+    *clockPort &= ~clockBitMask;
+  } while(bitCount != 0);
+  SREG = oldSREG;
 
-  
+#else
   //
-  // configure the display
+  // transmit 8 bits
   //
-  lcdWriteCommand(0x00);      // NOP
-  lcdWriteCommand(0x21);      // set H bit to program config registers
-  lcdWriteCommand(0xC0);      // set LCD Vop (Contrast) (0x80 - 0xff)
-  lcdWriteCommand(0x06);      // set LCD temp coefficent (0x04 - 0x07)
-  lcdWriteCommand(0x14);      // set LCD bias mode to 1:48 (0x10 - 0x17)
-  lcdWriteCommand(0x20);      // clear H bit to access X & Y registers
-  lcdWriteCommand(0x0C);      // set "normal mode"
+  do
+  {
+    //
+    // write the MSB bit
+    //
+    if (data & 0x80)
+      digitalWrite(lcdDataInPin, HIGH);
+    else
+      digitalWrite(lcdDataInPin, LOW);
 
-  lcdCursorColumnX = 0;       // remember the LCD cursor's current position
-  lcdCursorRowY = 0;  
+    //
+    // set the clock high
+    //
+    digitalWrite(lcdClockPin, HIGH);
+
+    //
+    // move the next bit into the MSB position
+    //
+    data = data << 1;
+    bitCount--;
+
+    //
+    // set the clock low
+    //
+    digitalWrite(lcdClockPin, LOW);
+  } while(bitCount != 0);
+#endif
 }
 
 
+// ---------------------------------------------------------------------------------
+//                                   EEPROM functions
+// ---------------------------------------------------------------------------------
 
 //
-// print a signed int at location of the cursor
-//  Enter:  n = signed number to print 
+// hold configuration writes in a RAM journal instead of writing them to the 
+// EEPROM right away.  Writes to the same address are combined, and the journal 
+// is written when configurationCommit() is called, when it fills, or once the 
+// buttons have been idle for a while (checked by getButtonEvent())
+//  Enter:  enableFlg = true to use the journal, false to write right away
+//          idleCommitMillis = milliseconds after the last write that the 
+//            journal is written to the EEPROM
 //
-void ArduinoUserInterface::lcdPrintInt(int n)
+void ArduinoUserInterface::configurationUseWriteJournal(boolean enableFlg, unsigned int idleCommitMillis)
 {
-  char stringBuffer[7];
-  byte numberOfDigits;
-  
-  itoa(n, stringBuffer, 10);
-  lcdPrintString(stringBuffer);
+  if (!enableFlg)
+    configurationCommit();
+
+  configJournalEnabled = enableFlg;
+  configJournalIdleCommitMillis = idleCommitMillis;
 }
 
 
 
 //
-// print a signed int at location of the cursor, left justified, optional white 
-// space will be added after the digits to pad to the given width
-//  Enter:  n = signed number to print 
-//          padToNumberOfDigits = total width of the number (in characters)  
-//            including white space after the digits (0 to 6)
+// write the configuration values held in the journal to the EEPROM, only the 
+// bytes whose values change are written
 //
-void ArduinoUserInterface::lcdPrintIntLeftJustified(int n, int padToNumberOfDigits)
+void ArduinoUserInterface::configurationCommit(void)
 {
-  char stringBuffer[7];
-  
-  //
-  // print the number
-  //
-  itoa(n, stringBuffer, 10);
-  lcdPrintStringLeftJustified(stringBuffer, padToNumberOfDigits);
+  byte i;
+
+  for (i = 0; i < configJournalCount; i++)
+    configUpdateEEPROM(configJournalAddress[i], configJournalValue[i]);
+
+  configJournalCount = 0;
 }
 
 
 
 //
-// print a signed int at location of the cursor, right justified, optional white 
-// space will be added before the digits to pad to the given width
-//  Enter:  n = signed number to print 
-//          padToNumberOfDigits = total width of the number (in characters)  
-//            including white space after the digits (0 to 6)
+// set functions to read and write the configuration storage in place of the 
+// Arduino's EEPROM, such as an external EEPROM or a model of one when testing
+//  Enter:  readCallback -> function returning the byte at an address, NULL to 
+//            use the EEPROM
+//          writeCallback -> function writing a byte to an address, NULL to use 
+//            the EEPROM
+//
+void ArduinoUserInterface::configurationSetEEPROMCallbacks(byte (*readCallback)(int EEPromAddress), 
+  void (*writeCallback)(int EEPromAddress, byte value))
+{
+  configReadCallback = readCallback;
+  configWriteCallback = writeCallback;
+}
+
+
+
+
+//
+// write a configuration byte to the EEPROM
+//  Enter:  EEPromAddress = address in EEPROM to write 
+//          value = 8 bit value to write to EEPROM
+//          note: 2 bytes of EEPROM space are used 
 //
-void ArduinoUserInterface::lcdPrintIntRightJustified(int n, int padToNumberOfDigits)
+void ArduinoUserInterface::writeConfigurationByte(int EEPromAddress, byte value)
 {
-  char stringBuffer[7];
-  
-  //
-  // conver the number to a string
-  //
-  itoa(n, stringBuffer, 10);
-  lcdPrintStringRightJustified(stringBuffer, padToNumberOfDigits);
+  if (configReadByte(EEPromAddress) == 0xff)
+    configWriteByte(EEPromAddress, 0);
+	
+  configWriteByte(EEPromAddress + 1, value);
 }
 
 
 
 //
-// print a signed int at location of the cursor, center, optional white 
-// space will be added before and after the digits to pad to the given width
-//  Enter:  n = signed number to print 
-//          padToNumberOfDigits = total width of the number (in characters)  
-//            including white space after the digits (0 to 6)
+// read a configuration byte from the EEPROM
+//  Enter:  EEPromAddress = address in EEPROM to read from 
+//          defaultValue = default value to return if value has never been 
+//            written to the EEPROM
+//          note: 2 bytes of EEPROM space are used 
+//  Exit:   byte value from EEPROM (or default value) returned
 //
-void ArduinoUserInterface::lcdPrintIntCentered(int n, int padToNumberOfDigits)
+byte ArduinoUserInterface::readConfigurationByte(int EEPromAddress, byte defaultValue)
 {
-  char stringBuffer[7];
-  
-  //
-  // conver the number to a string
-  //
-  itoa(n, stringBuffer, 10);
-  lcdPrintStringCentered(stringBuffer, padToNumberOfDigits);
+  if (configReadByte(EEPromAddress) == 0xff)
+    return(defaultValue);
+	
+    return(configReadByte(EEPromAddress + 1));
 }
 
 
 
 //
-// print a string to the LCD display
-//  Enter:  s -> a null terminated string 
+// write a configuration int to the EEPROM
+//  Enter:  EEPromAddress = address in EEPROM to write 
+//          value = 16 bit value to write to EEPROM
+//          note: 3 bytes of EEPROM space are used 
 //
-void ArduinoUserInterface::lcdPrintString(char *s)
+void ArduinoUserInterface::writeConfigurationInt(int EEPromAddress, int value)
 {
-  //
-  // loop, writing one character at a time until the end of the string is reached
-  //
-  while (*s)
-  {
-    lcdPrintCharacter(*s++);
-  }
+  if (configReadByte(EEPromAddress) == 0xff)
+    configWriteByte(EEPromAddress, 0);
+	
+  configWriteByte(EEPromAddress + 1, (byte)((unsigned int)value & 0xFF));
+  configWriteByte(EEPromAddress + 2, (byte)((unsigned int)value >> 8));
 }
 
 
 
 //
-// print a string at location of the cursor, left justified, optional white 
-// space will be added after the string to pad to the given character width
-//  Enter:  s -> string to print 
-//          padToNumberOfCharacters = total width of printed string (in characters)  
-//            including white space after the string (0 to 13)
+// read a configuration int from the EEPROM
+//  Enter:  EEPromAddress = address in EEPROM to read from 
+//          defaultValue = default value to return if value has never been 
+//            written to the EEPROM
+//          note: 3 bytes of EEPROM space are used 
+//  Exit:   int value from EEPROM (or default value) returned
 //
-void ArduinoUserInterface::lcdPrintStringLeftJustified(char *s, 
-                            int padToNumberOfCharacters)
+int ArduinoUserInterface::readConfigurationInt(int EEPromAddress, int defaultValue)
 {
-  byte numberOfCharacters;
-  
-  //
-  // print the string
-  //
-  lcdPrintString(s);
-  
-  //
-  // add optional padding after the string
-  //
-  numberOfCharacters = strlen(s);
-  if (padToNumberOfCharacters > numberOfCharacters)
-    lcdFillToColumnX(lcdCursorColumnX + ((padToNumberOfCharacters - numberOfCharacters) * 6), 0x00);
+  unsigned int i;
+	
+  if (configReadByte(EEPromAddress) == 0xff)
+    return(defaultValue);
+		
+  i = configReadByte(EEPromAddress + 1);
+  i += ((unsigned int) (configReadByte(EEPromAddress + 2)) << 8);
+	
+  return((int) i);
 }
 
 
 
 //
-// print a string at location of the cursor, right justified, optional white 
-// space will be added before the string to pad to the given width
-//  Enter:  s -> string to print 
-//          padToNumberOfCharacters = total width of printed string (in characters)  
-//            including white space after the string (0 to 13)
+// write a configuration long to the EEPROM
+//  Enter:  EEPromAddress = address in EEPROM to write 
+//          value = 16 bit value to write to EEPROM
+//          note: 5 bytes of EEPROM space are used 
 //
-void ArduinoUserInterface::lcdPrintStringRightJustified(char *s, 
-                              int padToNumberOfCharacters)
+void ArduinoUserInterface::writeConfigurationLong(int EEPromAddress, long value)
 {
-  byte numberOfCharacters;
-  int newCursorColumnX;
+  if (configReadByte(EEPromAddress) == 0xff)
+    configWriteByte(EEPromAddress, 0);
+	
+  configWriteByte(EEPromAddress + 1, (byte)((unsigned long)value & 0xFF));
   
-  numberOfCharacters = strlen(s);
+  value = value >> 8;
+  configWriteByte(EEPromAddress + 2, (byte)((unsigned long)value & 0xFF));
   
-  if (padToNumberOfCharacters > numberOfCharacters)
-  {
-    newCursorColumnX = lcdCursorColumnX - (padToNumberOfCharacters * 6);
-    
-    if (newCursorColumnX < 0)
-      newCursorColumnX = 0;
-      
-    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
-      
-    lcdFillToColumnX(lcdCursorColumnX + ((padToNumberOfCharacters - numberOfCharacters) * 6), 0x00);
-    
-    lcdPrintString(s);
-  }
+  value = value >> 8;
+  configWriteByte(EEPromAddress + 3, (byte)((unsigned long)value & 0xFF));
   
-  else
-  {
-    newCursorColumnX = lcdCursorColumnX - (numberOfCharacters * 6);
-    
-    if (newCursorColumnX < 0)
-      newCursorColumnX = 0;
-      
-    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
-    
-    lcdPrintString(s);    
-  }
+  value = value >> 8;
+  configWriteByte(EEPromAddress + 4, (byte)((unsigned long)value & 0xFF));
 }
 
 
 
 //
-// print a string at location of the cursor, center, optional white 
-// space will be added before and after the string to pad to the given width
-//  Enter:  s -> string to print 
-//          padToNumberOfCharacters = total width of printed string (in   
-//            characters) including white space after the string (0 to 13)
+// read a configuration long from the EEPROM
+//  Enter:  EEPromAddress = address in EEPROM to read from 
+//          defaultValue = default value to return if value has never been 
+//            written to the EEPROM
+//          note: 5 bytes of EEPROM space are used 
+//  Exit:   long value from EEPROM (or default value) returned
 //
-void ArduinoUserInterface::lcdPrintStringCentered(char *s, int padToNumberOfCharacters)
+long ArduinoUserInterface::readConfigurationLong(int EEPromAddress, long defaultValue)
 {
-  byte numberOfCharacters;
-  int newCursorColumnX;
-  byte pixelsOfPadding;
-  
-  numberOfCharacters = strlen(s);
-  
-  if (padToNumberOfCharacters > numberOfCharacters)
-  {
-    newCursorColumnX = lcdCursorColumnX - (padToNumberOfCharacters * 3);
-    
-    if (newCursorColumnX < 0)
-      newCursorColumnX = 0;
-      
-    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
-    
-    pixelsOfPadding = (padToNumberOfCharacters - numberOfCharacters) * 3;
-    lcdFillToColumnX(lcdCursorColumnX + pixelsOfPadding, 0x00);
-    
-    lcdPrintString(s);
-
-    lcdFillToColumnX(lcdCursorColumnX + pixelsOfPadding, 0x00);
-  }
-  
-  else
-  {
-    newCursorColumnX = lcdCursorColumnX - (numberOfCharacters * 3);
-    
-    if (newCursorColumnX < 0)
-      newCursorColumnX = 0;
-      
-    lcdSetCursorXY(newCursorColumnX, lcdCursorRowY);
-    
-    lcdPrintString(s);    
-  }
+  unsigned long i;
+	
+  if (configReadByte(EEPromAddress) == 0xff)
+    return(defaultValue);
+		
+  i = configReadByte(EEPromAddress + 1);
+  i += ((unsigned long) (configReadByte(EEPromAddress + 2)) << 8);
+  i += ((unsigned long) (configReadByte(EEPromAddress + 3)) << 16);
+  i += ((unsigned long) (configReadByte(EEPromAddress + 4)) << 24);
+	
+  return((long) i);
 }
 
 
-
 //
-// print a string in reverse video to the LCD with centering on the current line
-//  Enter:  s -> a null terminated string 
-//          X = X coord to the center position to print (0 - 83)
-//          padToWidth = desired with of reverse video string, black padding will
-//            be added on each side of the string if needed, set to zero to add no 
-//            padding
+// write a long that changes often, such as a counter, to the EEPROM.  Each 
+// write goes to the next of several slots so that the wear is spread across 
+// them.  The value is written before its sequence number, so if the power 
+// fails part way through, the previous value is still read back.  That order 
+// matters, so this never goes through the journal
+//  Enter:  EEPromAddress = address in EEPROM of the first slot
+//          numberOfSlots = number of slots to rotate through (1 to 254)
+//          value = 32 bit value to write to EEPROM
+//          note: 5 bytes of EEPROM space are used for each slot
 //
-void ArduinoUserInterface::lcdPrintCenteredStringReverse(char *s, byte X, 
-                               byte padToWidth)
+void ArduinoUserInterface::writeConfigurationLongWearLeveled(int EEPromAddress, 
+  byte numberOfSlots, long value)
 {
-  int startingX;
-  byte stringWidthInPixels;
-  
-  stringWidthInPixels = lcdStringWidthInPixels(s);
+  int latestSlot;
+  int slot;
+  int slotAddress;
+  byte sequenceNumber;
+  byte i;
 
   //
-  // determine padding needed on right and left sides of string
+  // the journal would write the bytes in the order they were first added to 
+  // it, so write anything waiting there first, then write straight to the EEPROM
   //
-  if (padToWidth > stringWidthInPixels)
-  {
-    //
-    // move the cursor to the beginning of the printing
-    //
-    startingX = X - ((padToWidth / 2) + (padToWidth % 2));
-    lcdSetCursorXY(startingX, lcdCursorRowY);  
-    
-    //
-    // add black padding up to the beginning of the string
-    //
-    lcdFillToColumnX(X - (stringWidthInPixels / 2), 0xff);
-
-    //
-    // print the string
-    //
-    lcdPrintStringReverse(s);
+  configurationCommit();
 
-    //
-    // add black padding at the end of the string
-    //
-    lcdFillToColumnX(startingX + padToWidth, 0xff);
+  //
+  // find the slot with the newest value, don't write anything if it's unchanged
+  //
+  latestSlot = configFindLatestSlot(EEPromAddress, numberOfSlots);
+  if (latestSlot < 0)
+  {
+    slot = 0;
+    sequenceNumber = 0;
   }
-  
   else
   {
-    //
-    // move the cursor to the beginning of the printing
-    //
-    lcdSetCursorXY(X - (stringWidthInPixels/2), lcdCursorRowY);  
+    slotAddress = EEPromAddress + (latestSlot * CONFIG_WEAR_LEVELED_SLOT_SIZE);
+    if (readConfigurationLong(slotAddress, 0) == value)
+      return;
 
-    //
-    // print the string
-    //
-    lcdPrintStringReverse(s);
+    slot = (latestSlot + 1) % numberOfSlots;
+    sequenceNumber = (configReadByte(slotAddress) + 1) % CONFIG_SEQUENCE_NUMBER_LIMIT;
   }
-}
-
 
-
-//
-// print a string to the LCD display in reverse video
-//  Enter:  s -> a null terminated string 
-//
-void ArduinoUserInterface::lcdPrintStringReverse(char *s)
-{
   //
-  // loop, writing one character at a time until the end of the string is reached
+  // write the value to the next slot, then mark it as the newest
   //
-  while (*s)
+  slotAddress = EEPromAddress + (slot * CONFIG_WEAR_LEVELED_SLOT_SIZE);
+  for (i = 1; i < CONFIG_WEAR_LEVELED_SLOT_SIZE; i++)
   {
-    lcdPrintCharacterReverse(*s++);
+    configUpdateEEPROM(slotAddress + i, (byte)((unsigned long)value & 0xFF));
+    value = value >> 8;
   }
+
+  configUpdateEEPROM(slotAddress, sequenceNumber);
 }
 
 
 
 //
-// print one ASCII charater to the display
-//  Enter:  c = character to display
+// read a long written with writeConfigurationLongWearLeveled()
+//  Enter:  EEPromAddress = address in EEPROM of the first slot
+//          numberOfSlots = number of slots rotated through (1 to 254)
+//          defaultValue = default value to return if value has never been 
+//            written to the EEPROM
+//  Exit:   long value from EEPROM (or default value) returned
 //
-void ArduinoUserInterface::lcdPrintCharacter(byte character)
+long ArduinoUserInterface::readConfigurationLongWearLeveled(int EEPromAddress, 
+  byte numberOfSlots, long defaultValue)
 {
-  int pixelColumn;
-  
-  //
-  // make sure character is in range of the font table
-  //
-  if ((character < 0x20) || (character > 0x80))
-    character = 0x20;
-  
-  //
-  // from the character, get the index into the font table
-  //
-  character -= 0x20;
-  
-  //
-  // write all 5 columns of the character
-  //
-  for (pixelColumn = 0; pixelColumn < 5; pixelColumn++)
-  {
-    lcdWriteData(pgm_read_byte(&Font[character][pixelColumn]));   
-  }
-  
-  //
-  // write a column of blank pixels after the character
-  //
-  lcdWriteData(0x00);
-  
-  //
-  // move the cursor forward by one character
-  //
-  lcdCursorColumnX += 6;
+  int latestSlot;
+
+  latestSlot = configFindLatestSlot(EEPromAddress, numberOfSlots);
+  if (latestSlot < 0)
+    return(defaultValue);
+
+  return(readConfigurationLong(EEPromAddress + (latestSlot * CONFIG_WEAR_LEVELED_SLOT_SIZE), defaultValue));
 }
 
 
 
 //
-// print one ASCII charater to the display in reverse video
-//  Enter:  c = character to display
+// load the application's settings struct from the EEPROM, call this from 
+// setup() after connectToPins().  The newest copy of the block is read in one 
+// pass, if its CRC is bad the other copy is used, and if neither is good every 
+// field is set to its default.  Fields added since the block was saved get 
+// their defaults, then the schema's migrate function is called and the block 
+// is saved again
+//  Enter:  schema -> description of the settings struct and where it's saved
+//  Exit:   true returned if the settings were read from the EEPROM, false if 
+//          the defaults are being used
 //
-void ArduinoUserInterface::lcdPrintCharacterReverse(byte character)
+boolean ArduinoUserInterface::loadConfiguration(const CONFIG_SCHEMA *schema)
 {
-  int pixelColumn;
-  byte lineOfPixels;
-  
+  byte sequence0;
+  byte sequence1;
+  byte copy;
+  byte savedVersion;
+  unsigned int savedSize;
+
+  configSchema = schema;
+
   //
-  // make sure character is in range of the font table
+  // a struct bigger than the space reserved for it would be saved over its 
+  // CRC and the other copy, so use the defaults and never save it
   //
-  if ((character < 0x20) || (character > 0x80))
-    character = 0x20;
-  
+  if (schema->ConfigurationSize > schema->ReservedSize)
+  {
+    configSetDefaults(0);
+    configSchema = NULL;
+    return(false);
+  }
+
   //
-  // from the character, get the index into the font table
+  // start with the copy that has the newest sequence number, the numbers wrap 
+  // around so the difference between them is checked
   //
-  character -= 0x20;
-  
+  sequence0 = configReadByte(configBlockAddress(0));
+  sequence1 = configReadByte(configBlockAddress(1));
+  if ((sequence1 != sequence0) && ((byte)(sequence1 - sequence0) < 0x80))
+    copy = 1;
+  else
+    copy = 0;
+
   //
-  // write all 5 columns of the character
+  // if the newest copy is damaged, such as by losing power while saving it, 
+  // use the other one
   //
-  for (pixelColumn = 0; pixelColumn < 5; pixelColumn++)
+  if (!configReadBlock(copy, &savedVersion, &savedSize))
   {
-    lineOfPixels = pgm_read_byte(&Font[character][pixelColumn]);
-    lineOfPixels = ~lineOfPixels;
-    lcdWriteData(lineOfPixels);   
+    copy = 1 - copy;
+    if (!configReadBlock(copy, &savedVersion, &savedSize))
+    {
+      configSetDefaults(0);
+      configSchemaNewestCopy = 0xff;
+      configSchemaSequence = 0;
+      return(false);
+    }
   }
-    
-  //
-  // write a column of blank pixels after the character
-  //
-  lcdWriteData(0xff);
-  
+
+  configSchemaNewestCopy = copy;
+  configSchemaSequence = (copy == 0) ? sequence0 : sequence1;
+
   //
-  // move the cursor forward by one character
+  // give defaults to any fields that weren't saved, then convert a block saved 
+  // by an older version of the application
   //
-  lcdCursorColumnX += 6;
-}
+  configSetDefaults(savedSize);
 
+  if (savedVersion != schema->Version)
+  {
+    if (schema->MigrateConfiguration != NULL)
+      (*schema->MigrateConfiguration)(savedVersion, schema->Configuration);
 
+    saveConfiguration();
+  }
 
-//
-// determine the width of a string in pixels
-//
-byte ArduinoUserInterface::lcdStringWidthInPixels(char *s)
-{
-  return(strlen(s) * 6);
+  return(true);
 }
 
 
 
 //
-// clear the LCD display by writing blank pixels
+// save the application's settings struct to the EEPROM, using the schema given 
+// to loadConfiguration().  The copy of the block that isn't the newest is 
+// written, its sequence number last, so until the save is complete the other 
+// copy is still read at power up.  The order matters, so the block is written 
+// straight to the EEPROM, not through the journal.  Nothing is written if the 
+// settings haven't changed, or if loadConfiguration() found the struct doesn't 
+// fit the space reserved for it
 //
-void ArduinoUserInterface::lcdClearDisplay(void)
+void ArduinoUserInterface::saveConfiguration(void)
 {
-  int characterColumn;
-  int lastCharacterColumn;  
-  
-  //
-  // move cursor to the beginning
-  //
-  lcdSetCursorXY(0, 0);          
+  byte *configuration;
+  byte header[CONFIG_BLOCK_HEADER_SIZE];
+  byte copy;
+  int address;
+  unsigned int crc;
+  unsigned int i;
+
+  if (configSchema == NULL)
+    return;
+
+  configuration = (byte *) configSchema->Configuration;
 
   //
-  // determine how many bytes must be written to clear the display
+  // the journal would write the bytes in the order they were first added to 
+  // it, and can fill part way through the block, so write anything waiting 
+  // there first
   //
-  lastCharacterColumn = LCD_WIDTH_IN_PIXELS * LCD_HEIGHT_IN_PIXELS / 8;
-  
+  configurationCommit();
+
   //
-  // write enough blank pixels to clear the display
+  // check if the newest copy already holds these settings
   //
-  for (characterColumn = 0; characterColumn < lastCharacterColumn; characterColumn++)
+  if (configSchemaNewestCopy != 0xff)
   {
-    lcdWriteData(0x00);
+    address = configBlockAddress(configSchemaNewestCopy);
+    if ((configReadByte(address + 1) == configSchema->Version) &&
+      (configReadByte(address + 2) == (byte)(configSchema->ConfigurationSize & 0xff)) &&
+      (configReadByte(address + 3) == (byte)(configSchema->ConfigurationSize >> 8)))
+    {
+      for (i = 0; i < configSchema->ConfigurationSize; i++)
+      {
+        if (configReadByte(address + CONFIG_BLOCK_HEADER_SIZE + i) != configuration[i])
+          break;
+      }
+
+      if (i == configSchema->ConfigurationSize)
+        return;
+    }
   }
-  
+
   //
-  // move cursor to the beginning
+  // build the header for the other copy with the next sequence number
   //
-  lcdSetCursorXY(0, 0);          
-}
+  copy = (configSchemaNewestCopy == 0) ? 1 : 0;
+  address = configBlockAddress(copy);
 
+  header[0] = configSchemaSequence + 1;
+  header[1] = configSchema->Version;
+  header[2] = (byte)(configSchema->ConfigurationSize & 0xff);
+  header[3] = (byte)(configSchema->ConfigurationSize >> 8);
 
+  crc = 0xffff;
+  for (i = 0; i < CONFIG_BLOCK_HEADER_SIZE; i++)
+    crc = configCRC16Update(crc, header[i]);
 
-//
-// fill current line, beginning at the cursor location with a repeating column 
-// of 8 pixels up to the X column
-//          X = fill up to, but not including this column, the cursor will 
-//              then be at this column
-//          byteOfPixels = byte of pixels to repeat
-//
-void ArduinoUserInterface::lcdFillToColumnX(int X, byte byteOfPixels)
-{
-  X--;
-  if(X < 0)
-    return;
-    
-  lcdDrawRowOfPixels(lcdCursorColumnX, X, lcdCursorRowY, byteOfPixels);
+  //
+  // write the struct, the CRC, then the header with the sequence number last
+  //
+  for (i = 0; i < configSchema->ConfigurationSize; i++)
+  {
+    configUpdateEEPROM(address + CONFIG_BLOCK_HEADER_SIZE + i, configuration[i]);
+    crc = configCRC16Update(crc, configuration[i]);
+  }
+
+  configUpdateEEPROM(address + CONFIG_BLOCK_HEADER_SIZE + configSchema->ReservedSize, (byte)(crc & 0xff));
+  configUpdateEEPROM(address + CONFIG_BLOCK_HEADER_SIZE + configSchema->ReservedSize + 1, (byte)(crc >> 8));
+
+  for (i = CONFIG_BLOCK_HEADER_SIZE - 1; i > 0; i--)
+    configUpdateEEPROM(address + i, header[i]);
+  configUpdateEEPROM(address, header[0]);
+
+  configSchemaNewestCopy = copy;
+  configSchemaSequence = header[0];
 }
 
 
 
 //
-// fill current line, beginning at the cursor location to the end of the line, 
-// with a repeating column of 8 pixels
-//          byteOfPixels = byte of pixels to repeat
+// get the address in EEPROM of one copy of the configuration block
+//  Enter:  copy = 0 or 1
+//  Exit:   address returned
 //
-void ArduinoUserInterface::lcdFillToEndOfLine(byte byteOfPixels)
+int ArduinoUserInterface::configBlockAddress(byte copy)
 {
-  lcdDrawRowOfPixels(lcdCursorColumnX, LCD_LAST_COLUMN_X, lcdCursorRowY, byteOfPixels);
+  return(configSchema->EEPromAddress + 
+    (copy * (CONFIG_BLOCK_HEADER_SIZE + configSchema->ReservedSize + CONFIG_BLOCK_CRC_SIZE)));
 }
 
 
 
 //
-// draw a row of pixels, repeating the same column of 8 pixels across
-//  Enter:  X1 = starting pixel column (0 - 83, 0 = left most column)
-//          X2 = ending pixel column (0 - 83)
-//          lineNumber = character line (0 - 5, 0 = top row)
-//          byteOfPixels = byte of pixels to repeat
+// read one copy of the configuration block into the settings struct, checking 
+// its CRC along the way
+//  Enter:  copy = 0 or 1
+//  Exit:   true returned if the copy is good, savedVersion and savedSize are 
+//          set from its header
 //
-void ArduinoUserInterface::lcdDrawRowOfPixels(int X1, int X2, int lineNumber, 
-                                              byte byteOfPixels)
+boolean ArduinoUserInterface::configReadBlock(byte copy, byte *savedVersion, unsigned int *savedSize)
 {
-  int pixelCounter;
-  int pixelCount;
+  byte *configuration;
+  int address;
+  unsigned int crc;
+  unsigned int i;
+  byte data;
+
+  configuration = (byte *) configSchema->Configuration;
+  address = configBlockAddress(copy);
 
   //
-  // move to the first pixel
+  // read the header, a size that doesn't fit means the copy isn't valid
   //
-  lcdSetCursorXY(X1, lineNumber);
+  crc = 0xffff;
+  for (i = 0; i < CONFIG_BLOCK_HEADER_SIZE; i++)
+    crc = configCRC16Update(crc, configReadByte(address + i));
 
+  *savedVersion = configReadByte(address + 1);
+  *savedSize = configReadByte(address + 2) + ((unsigned int) configReadByte(address + 3) << 8);
+  if (*savedSize > configSchema->ReservedSize)
+    return(false);
 
   //
-  // write the pixels
+  // copy the struct to RAM, bytes of fields that have since been removed are 
+  // only used for the CRC
   //
-  pixelCount = X2 - X1 + 1;
-  if(pixelCount <= 0)
-    return;
-  
-  for (pixelCounter = 0; pixelCounter < pixelCount; pixelCounter++)
+  for (i = 0; i < *savedSize; i++)
   {
-    lcdWriteData(byteOfPixels);   
+    data = configReadByte(address + CONFIG_BLOCK_HEADER_SIZE + i);
+    crc = configCRC16Update(crc, data);
+
+    if (i < configSchema->ConfigurationSize)
+      configuration[i] = data;
   }
 
   //
-  // remember the cursor location
+  // check the CRC
   //
-  lcdCursorColumnX += pixelCount;
+  address += CONFIG_BLOCK_HEADER_SIZE + configSchema->ReservedSize;
+  if ((configReadByte(address) != (byte)(crc & 0xff)) || 
+    (configReadByte(address + 1) != (byte)(crc >> 8)))
+    return(false);
+
+  return(true);
 }
 
 
 
 //
-// set the coords where the next character will be written to the LCD display
-//  Enter:  column = pixel column (0 - 83, 0 = left most column)
-//          lineNumber = character line (0 - 5, 0 = top row)
+// set the fields of the settings struct that weren't saved to their defaults
+//  Enter:  savedSize = number of bytes of the struct that were loaded
 //
-void ArduinoUserInterface::lcdSetCursorXY(int column, int lineNumber)
+void ArduinoUserInterface::configSetDefaults(unsigned int savedSize)
 {
-  lcdWriteCommand(0x80 | column);
-  lcdWriteCommand(0x40 | lineNumber);
-  
-  lcdCursorColumnX = column;        // remember the LCD's cursor position
-  lcdCursorRowY = lineNumber; 
+  CONFIG_FIELD field;
+  byte fieldIdx;
+
+  for (fieldIdx = 0; fieldIdx < configSchema->NumberOfFields; fieldIdx++)
+  {
+    memcpy_P(&field, &configSchema->Fields[fieldIdx], sizeof(CONFIG_FIELD));
+    if (field.FieldOffset + field.FieldSize <= savedSize)
+      continue;
+
+    configSetField(field.FieldOffset, field.FieldSize, field.DefaultValue);
+  }
 }
 
 
 
 //
-// set the LCD screen contrast value 
-//  Enter:  contrastValue = value to set for the screen's contrast (0 - 127)
+// get the value of a field in the configuration struct, a byte field is 
+// unsigned, int and long fields are signed
+//  Enter:  fieldOffset = where the field is in the struct
+//          fieldSize = 1 for byte, 2 for int, 4 for long
+//  Exit:   value of the field returned
 //
-void ArduinoUserInterface::lcdSetContrast(int contrastValue)
+long ArduinoUserInterface::configGetField(unsigned int fieldOffset, byte fieldSize)
 {
-  lcdWriteCommand(0x21);                      // set H bit to program config registers
-  lcdWriteCommand(contrastValue | 0x80);      // set LCD Vop (Contrast) (0x80 - 0xff)
-  lcdWriteCommand(0x20);                      // clear H bit to access X & Y registers
-}
+  byte *field;
+  unsigned long value;
+  byte i;
 
+  field = (byte *) configSchema->Configuration + fieldOffset;
 
+  value = 0;
+  for (i = fieldSize; i > 0; i--)
+    value = (value << 8) | field[i - 1];
 
-//
-// write a single command byte to the LCD display
-//
-void ArduinoUserInterface::lcdWriteCommand(byte command)
-{
-  digitalWrite(lcdDataControlPin, LCD_COMMAND_BYTE);
-  digitalWrite(lcdChipEnablePin, LOW);
-  lcdSerialOut(command);
-  digitalWrite(lcdChipEnablePin, HIGH);
+  if (fieldSize == 2)
+    return((long)(int16_t) value);
+  if (fieldSize == 4)
+    return((long)(int32_t) value);
+
+  return((long) value);
 }
 
 
 
 //
-// write a single data byte to the LCD display
+// set the value of a field in the configuration struct
+//  Enter:  fieldOffset = where the field is in the struct
+//          fieldSize = 1 for byte, 2 for int, 4 for long
+//          value = value to set
 //
-void ArduinoUserInterface::lcdWriteData(byte data)
+void ArduinoUserInterface::configSetField(unsigned int fieldOffset, byte fieldSize, long value)
 {
-  digitalWrite(lcdDataControlPin, LCD_DATA_BYTE);
-  digitalWrite(lcdChipEnablePin, LOW);
-  lcdSerialOut(data);
-  digitalWrite(lcdChipEnablePin, HIGH);
+  byte *field;
+  unsigned long fieldValue;
+  byte i;
+
+  field = (byte *) configSchema->Configuration + fieldOffset;
+
+  fieldValue = (unsigned long) value;
+  for (i = 0; i < fieldSize; i++)
+  {
+    field[i] = (byte)(fieldValue & 0xff);
+    fieldValue = fieldValue >> 8;
+  }
 }
 
 
 
 //
-// serially transmit the data byte
+// add one byte to a CRC16 (CCITT polynomial)
+//  Enter:  crc = CRC of the bytes so far, start with 0xffff
+//          data = next byte
+//  Exit:   updated CRC returned
 //
-void ArduinoUserInterface::lcdSerialOut(byte data)
+unsigned int ArduinoUserInterface::configCRC16Update(unsigned int crc, byte data)
 {
-  byte bitCount = 8;
+  byte bit;
 
-  //
-  // transmit 8 bits
-  //
-  do
+  crc ^= (unsigned int) data << 8;
+  for (bit = 0; bit < 8; bit++)
   {
-    //
-    // write the MSB bit
-    //
-    if (data & 0x80)
-      digitalWrite(lcdDataInPin, HIGH);
+    if (crc & 0x8000)
+      crc = (crc << 1) ^ 0x1021;
     else
-      digitalWrite(lcdDataInPin, LOW);
-
-    //
-    // set the clock high
-    //
-    digitalWrite(lcdClockPin, HIGH);
-
-    //
-    // move the next bit into the MSB position
-    //
-    data = data << 1;
-    bitCount--;
+      crc = crc << 1;
+  }
 
-    //
-    // set the clock low
-    //
-    digitalWrite(lcdClockPin, LOW);
-  } while(bitCount != 0);
+  return(crc & 0xffff);
 }
 
 
-// ---------------------------------------------------------------------------------
-//                                   EEPROM functions
-// ---------------------------------------------------------------------------------
 
 //
-// write a configuration byte to the EEPROM
-//  Enter:  EEPromAddress = address in EEPROM to write 
-//          value = 8 bit value to write to EEPROM
-//          note: 2 bytes of EEPROM space are used 
+// find the slot of a wear leveled value that was written last, it's the one 
+// whose following slot doesn't have the next sequence number
+//  Enter:  EEPromAddress = address in EEPROM of the first slot
+//          numberOfSlots = number of slots rotated through
+//  Exit:   slot number returned, -1 if nothing has been written
 //
-void ArduinoUserInterface::writeConfigurationByte(int EEPromAddress, byte value)
+int ArduinoUserInterface::configFindLatestSlot(int EEPromAddress, byte numberOfSlots)
 {
-  if (EEPROM.read(EEPromAddress) == 0xff)
-    EEPROM.write(EEPromAddress, 0);
-	
-  EEPROM.write(EEPromAddress + 1, value);
+  byte slot;
+  byte sequenceNumber;
+  byte nextSequenceNumber;
+
+  sequenceNumber = configReadByte(EEPromAddress);
+  if (sequenceNumber == 0xff)
+    return(-1);
+
+  for (slot = 0; slot < numberOfSlots - 1; slot++)
+  {
+    nextSequenceNumber = configReadByte(EEPromAddress + ((slot + 1) * CONFIG_WEAR_LEVELED_SLOT_SIZE));
+    if (nextSequenceNumber != (sequenceNumber + 1) % CONFIG_SEQUENCE_NUMBER_LIMIT)
+      return(slot);
+
+    sequenceNumber = nextSequenceNumber;
+  }
+
+  return(numberOfSlots - 1);
 }
 
 
 
 //
-// read a configuration byte from the EEPROM
+// read one byte of configuration storage, a value waiting in the journal is 
+// returned in place of the one in the EEPROM
 //  Enter:  EEPromAddress = address in EEPROM to read from 
-//          defaultValue = default value to return if value has never been 
-//            written to the EEPROM
-//          note: 2 bytes of EEPROM space are used 
-//  Exit:   byte value from EEPROM (or default value) returned
+//  Exit:   byte returned
 //
-byte ArduinoUserInterface::readConfigurationByte(int EEPromAddress, byte defaultValue)
+byte ArduinoUserInterface::configReadByte(int EEPromAddress)
 {
-  if (EEPROM.read(EEPromAddress) == 0xff)
-    return(defaultValue);
-	
-    return(EEPROM.read(EEPromAddress + 1));
+  byte i;
+
+  for (i = 0; i < configJournalCount; i++)
+  {
+    if (configJournalAddress[i] == EEPromAddress)
+      return(configJournalValue[i]);
+  }
+
+  if (configReadCallback != NULL)
+    return((*configReadCallback)(EEPromAddress));
+
+  return(EEPROM.read(EEPromAddress));
 }
 
 
 
 //
-// write a configuration int to the EEPROM
+// write one byte of configuration storage, either to the journal or straight 
+// to the EEPROM
 //  Enter:  EEPromAddress = address in EEPROM to write 
-//          value = 16 bit value to write to EEPROM
-//          note: 3 bytes of EEPROM space are used 
+//          value = byte to write
 //
-void ArduinoUserInterface::writeConfigurationInt(int EEPromAddress, int value)
+void ArduinoUserInterface::configWriteByte(int EEPromAddress, byte value)
 {
-  if (EEPROM.read(EEPromAddress) == 0xff)
-    EEPROM.write(EEPromAddress, 0);
-	
-  EEPROM.write(EEPromAddress + 1, (byte)((unsigned int)value & 0xFF));
-  EEPROM.write(EEPromAddress + 2, (byte)((unsigned int)value >> 8));
-}
+  byte i;
 
+  if (!configJournalEnabled)
+  {
+    configUpdateEEPROM(EEPromAddress, value);
+    return;
+  }
 
+  configJournalLastWriteTime = millis();
 
-//
-// read a configuration int from the EEPROM
-//  Enter:  EEPromAddress = address in EEPROM to read from 
-//          defaultValue = default value to return if value has never been 
-//            written to the EEPROM
-//          note: 3 bytes of EEPROM space are used 
-//  Exit:   int value from EEPROM (or default value) returned
-//
-int ArduinoUserInterface::readConfigurationInt(int EEPromAddress, int defaultValue)
-{
-  unsigned int i;
-	
-  if (EEPROM.read(EEPromAddress) == 0xff)
-    return(defaultValue);
-		
-  i = EEPROM.read(EEPromAddress + 1);
-  i += ((unsigned int) (EEPROM.read(EEPromAddress + 2)) << 8);
-	
-  return((int) i);
+  //
+  // a new write to an address already in the journal replaces the old value
+  //
+  for (i = 0; i < configJournalCount; i++)
+  {
+    if (configJournalAddress[i] == EEPromAddress)
+    {
+      configJournalValue[i] = value;
+      return;
+    }
+  }
+
+  if (configJournalCount == CONFIG_JOURNAL_SIZE)
+    configurationCommit();
+
+  configJournalAddress[configJournalCount] = EEPromAddress;
+  configJournalValue[configJournalCount] = value;
+  configJournalCount++;
 }
 
 
 
 //
-// write a configuration long to the EEPROM
+// write one byte to the EEPROM, only if it's different from what's there.  
+// Reading takes microseconds while writing takes milliseconds and wears the 
+// cell, so unchanged values are never written
 //  Enter:  EEPromAddress = address in EEPROM to write 
-//          value = 16 bit value to write to EEPROM
-//          note: 5 bytes of EEPROM space are used 
+//          value = byte to write
 //
-void ArduinoUserInterface::writeConfigurationLong(int EEPromAddress, long value)
+void ArduinoUserInterface::configUpdateEEPROM(int EEPromAddress, byte value)
 {
-  if (EEPROM.read(EEPromAddress) == 0xff)
-    EEPROM.write(EEPromAddress, 0);
-	
-  EEPROM.write(EEPromAddress + 1, (byte)((unsigned long)value & 0xFF));
-  
-  value = value >> 8;
-  EEPROM.write(EEPromAddress + 2, (byte)((unsigned long)value & 0xFF));
-  
-  value = value >> 8;
-  EEPROM.write(EEPromAddress + 3, (byte)((unsigned long)value & 0xFF));
-  
-  value = value >> 8;
-  EEPROM.write(EEPromAddress + 4, (byte)((unsigned long)value & 0xFF));
+  byte currentValue;
+
+  if (configReadCallback != NULL)
+    currentValue = (*configReadCallback)(EEPromAddress);
+  else
+    currentValue = EEPROM.read(EEPromAddress);
+
+  if (currentValue == value)
+    return;
+
+  if (configWriteCallback != NULL)
+    (*configWriteCallback)(EEPromAddress, value);
+  else
+    EEPROM.write(EEPromAddress, value);
 }
 
 
 
 //
-// read a configuration long from the EEPROM
-//  Enter:  EEPromAddress = address in EEPROM to read from 
-//          defaultValue = default value to return if value has never been 
-//            written to the EEPROM
-//          note: 5 bytes of EEPROM space are used 
-//  Exit:   long value from EEPROM (or default value) returned
+// write the journal to the EEPROM if nothing has been written to it for a while
 //
-long ArduinoUserInterface::readConfigurationLong(int EEPromAddress, long defaultValue)
+void ArduinoUserInterface::configCommitIfIdle(void)
 {
-  unsigned long i;
-	
-  if (EEPROM.read(EEPromAddress) == 0xff)
-    return(defaultValue);
-		
-  i = EEPROM.read(EEPromAddress + 1);
-  i += ((unsigned long) (EEPROM.read(EEPromAddress + 2)) << 8);
-  i += ((unsigned long) (EEPROM.read(EEPromAddress + 3)) << 16);
-  i += ((unsigned long) (EEPROM.read(EEPromAddress + 4)) << 24);
-	
-  return((long) i);
+  if (configJournalCount == 0)
+    return;
+
+  if (millis() - configJournalLastWriteTime >= configJournalIdleCommitMillis)
+    configurationCommit();
 }
 
 
 // -------------------------------------- End --------------------------------------
 
-
+
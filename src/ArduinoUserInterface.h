@@ -36,6 +36,7 @@
 
 #include "Arduino.h"
 #include <avr/pgmspace.h>
+#include <stddef.h>
 
 
 //
@@ -65,6 +66,277 @@ const byte MENU_ITEM_TYPE_END_OF_MENU      = 5;
 // menu misc constants
 //
 const byte MAX_MENU_ITEMS_TO_DISPLAY = 4;
+const byte MENU_TOGGLE_TEXT_CACHE_SIZE = 8;
+
+
+//
+// definition of an entry in a menu table stored in flash (PROGMEM), the text 
+// is kept in the entry so it doesn't need its own PROGMEM declaration
+//
+const byte MENU_ITEM_P_TEXT_SIZE = 14;
+
+typedef struct _MENU_ITEM_P
+{
+  byte MenuItemType;
+  char MenuItemText[MENU_ITEM_P_TEXT_SIZE];
+  void (*MenuItemFunction)();
+  const _MENU_ITEM_P *MenuItemSubMenu;
+} MENU_ITEM_P;
+
+
+//
+// definition of a virtual menu, its items are made by the application only 
+// when they are displayed or selected, so a menu can have hundreds of items 
+// without a table for them.  GetMenuItem() is called with the item's number 
+// (0 = first item) and fills in a MENU_ITEM for it, the item's text must stay 
+// valid until GetMenuItem() is called again.  Items can be commands, toggles or 
+// sub menus that link to a MENU_ITEM table.  The header type must be 
+// MENU_ITEM_TYPE_MAIN_MENU_HEADER or MENU_ITEM_TYPE_SUB_MENU_HEADER
+//
+typedef struct _VIRTUAL_MENU
+{
+  byte MenuHeaderType;
+  int MenuItemCount;
+  void (*GetMenuItem)(int itemNumber, MENU_ITEM *menuItem);
+} VIRTUAL_MENU;
+
+
+//
+// types of entries in a settings menu
+//
+const byte SETTING_TYPE_INT     = 0;    // edited with a slider
+const byte SETTING_TYPE_DECIMAL = 1;    // edited with a decimal slider, the 
+                                        //   field holds the value times 10 to 
+                                        //   the power of DigitsRightOfDecimal
+const byte SETTING_TYPE_TOGGLE  = 2;    // steps from MinValue to MaxValue each 
+                                        //   time it's selected, a 0 - 1 toggle 
+                                        //   is shown as Off / On
+
+
+//
+// definition of one entry in a settings menu, tables of these are stored in 
+// flash and built with SETTINGS_TABLE_P().  Each entry edits a field of the 
+// configuration struct given to loadConfiguration()
+//
+typedef struct _SETTING_ITEM
+{
+  byte SettingType;
+  char Label[MENU_ITEM_P_TEXT_SIZE];
+  unsigned int FieldOffset;
+  byte FieldSize;
+  long MinValue;
+  long MaxValue;
+  long Step;
+  byte DigitsRightOfDecimal;
+} SETTING_ITEM;
+
+
+//
+// definition of a settings menu, its items are made from a table of settings 
+// and open the setting's slider or change its toggle.  New values are saved 
+// with saveConfiguration() when Set is pressed.  SettingChanged() is called 
+// with the setting's number (0 = first setting) and SLIDER_DISPLAY_VALUE_CHANGED 
+// while a slider is moving, SLIDER_DISPLAY_VALUE_SET once the value is saved, 
+// or SLIDER_DISPLAY_CANCELED after the field's value is restored, so the 
+// application can use the new value right away.  Like a main menu, pressing 
+// Back returns from the settings menu
+//
+typedef struct _SETTINGS_MENU
+{
+  const SETTING_ITEM *Settings;
+  byte NumberOfSettings;
+  void (*SettingChanged)(int settingNumber, byte operation);
+} SETTINGS_MENU;
+
+
+//
+// one level of the menu navigation stack, the view of a menu that is restored 
+// when "Back" is pressed in the sub menu selected from it
+//
+const byte MAX_MENU_NAVIGATION_DEPTH = 6;
+
+typedef struct _MENU_NAVIGATION_LEVEL
+{
+  MENU_ITEM *MenuTable;
+  const MENU_ITEM_P *MenuTable_P;
+  VIRTUAL_MENU *VirtualMenu;
+  SETTINGS_MENU *SettingsMenu;
+  int MenuItemIdx;
+  int MenuTopLineItemIdx;
+} MENU_NAVIGATION_LEVEL;
+
+
+//
+// get one character of a menu item's text, padding with zeros past its end
+//
+constexpr char menuItemTextCharacter_P(const char *text, int textSize, int i)
+{
+  return((i < textSize) ? text[i] : 0);
+}
+
+
+//
+// build one entry of a menu table stored in flash, this is evaluated by the 
+// compiler and takes the same fields as a MENU_ITEM
+//  Enter:  menuItemType = MENU_ITEM_TYPE_COMMAND, MENU_ITEM_TYPE_SUB_MENU...
+//          text -> the text displayed for the item (13 characters or less)
+//          menuItemFunction -> the item's function, NULL if none
+//          subMenu -> the menu selected by the item, NULL if none
+//
+template<int TEXT_SIZE> 
+constexpr MENU_ITEM_P menuItem_P(byte menuItemType, const char (&text)[TEXT_SIZE], 
+  void (*menuItemFunction)(), const MENU_ITEM_P *subMenu)
+{
+  static_assert(TEXT_SIZE <= MENU_ITEM_P_TEXT_SIZE, "menu item text is too long");
+
+  return(MENU_ITEM_P{menuItemType, {
+    menuItemTextCharacter_P(text, TEXT_SIZE, 0),  menuItemTextCharacter_P(text, TEXT_SIZE, 1), 
+    menuItemTextCharacter_P(text, TEXT_SIZE, 2),  menuItemTextCharacter_P(text, TEXT_SIZE, 3), 
+    menuItemTextCharacter_P(text, TEXT_SIZE, 4),  menuItemTextCharacter_P(text, TEXT_SIZE, 5), 
+    menuItemTextCharacter_P(text, TEXT_SIZE, 6),  menuItemTextCharacter_P(text, TEXT_SIZE, 7), 
+    menuItemTextCharacter_P(text, TEXT_SIZE, 8),  menuItemTextCharacter_P(text, TEXT_SIZE, 9), 
+    menuItemTextCharacter_P(text, TEXT_SIZE, 10), menuItemTextCharacter_P(text, TEXT_SIZE, 11), 
+    menuItemTextCharacter_P(text, TEXT_SIZE, 12), menuItemTextCharacter_P(text, TEXT_SIZE, 13)}, 
+    menuItemFunction, subMenu});
+}
+
+
+//
+// check the entries of a menu table following its header, each must be a 
+// command, toggle or sub menu with what it needs to run, and the last must be 
+// MENU_ITEM_TYPE_END_OF_MENU
+//
+constexpr boolean menuItemsAreValid_P(void)
+{
+  return(false);
+}
+
+constexpr boolean menuItemsAreValid_P(const MENU_ITEM_P &lastItem)
+{
+  return(lastItem.MenuItemType == MENU_ITEM_TYPE_END_OF_MENU);
+}
+
+template<typename... REMAINING_ITEMS> 
+constexpr boolean menuItemsAreValid_P(const MENU_ITEM_P &item, const REMAINING_ITEMS &... remainingItems)
+{
+  return(
+    (((item.MenuItemType == MENU_ITEM_TYPE_SUB_MENU) && (item.MenuItemSubMenu != NULL)) ||
+     ((item.MenuItemType == MENU_ITEM_TYPE_COMMAND) && (item.MenuItemFunction != NULL)) ||
+     ((item.MenuItemType == MENU_ITEM_TYPE_TOGGLE) && (item.MenuItemFunction != NULL))) &&
+    menuItemsAreValid_P(remainingItems...));
+}
+
+
+//
+// check a menu table stored in flash, the first entry must be a main menu 
+// header or a sub menu header
+//
+template<typename... REMAINING_ITEMS> 
+constexpr boolean menuTableIsValid_P(const MENU_ITEM_P &header, const REMAINING_ITEMS &... remainingItems)
+{
+  return(
+    ((header.MenuItemType == MENU_ITEM_TYPE_MAIN_MENU_HEADER) ||
+     (header.MenuItemType == MENU_ITEM_TYPE_SUB_MENU_HEADER)) &&
+    menuItemsAreValid_P(remainingItems...));
+}
+
+
+//
+// define a menu table stored in flash, mistakes in the table are reported 
+// when compiling.  Each entry is built with menuItem_P(), for example:
+//
+//    extern const MENU_ITEM_P mainMenu[];
+//
+//    MENU_TABLE_P(mainMenu,
+//      menuItem_P(MENU_ITEM_TYPE_MAIN_MENU_HEADER,  "",       NULL,          NULL),
+//      menuItem_P(MENU_ITEM_TYPE_COMMAND,           "Run",    menuCommandRun, NULL),
+//      menuItem_P(MENU_ITEM_TYPE_END_OF_MENU,       "",       NULL,          NULL));
+//
+#define MENU_TABLE_P(tableName, ...) \
+  static_assert(menuTableIsValid_P(__VA_ARGS__), \
+    "menu table " #tableName " needs a header, valid items and MENU_ITEM_TYPE_END_OF_MENU"); \
+  const MENU_ITEM_P tableName[] PROGMEM = { __VA_ARGS__ }
+
+
+//
+// build one entry of a settings table, this is evaluated by the compiler.  Use 
+// the SETTING_ENTRY_INT(), SETTING_ENTRY_DECIMAL() and SETTING_ENTRY_TOGGLE() 
+// macros rather than calling this directly
+//
+template<int TEXT_SIZE> 
+constexpr SETTING_ITEM settingItem_P(byte settingType, const char (&label)[TEXT_SIZE], 
+  unsigned int fieldOffset, byte fieldSize, long minValue, long maxValue, long step, 
+  byte digitsRightOfDecimal)
+{
+  static_assert(TEXT_SIZE <= MENU_ITEM_P_TEXT_SIZE, "setting label is too long");
+
+  return(SETTING_ITEM{settingType, {
+    menuItemTextCharacter_P(label, TEXT_SIZE, 0),  menuItemTextCharacter_P(label, TEXT_SIZE, 1), 
+    menuItemTextCharacter_P(label, TEXT_SIZE, 2),  menuItemTextCharacter_P(label, TEXT_SIZE, 3), 
+    menuItemTextCharacter_P(label, TEXT_SIZE, 4),  menuItemTextCharacter_P(label, TEXT_SIZE, 5), 
+    menuItemTextCharacter_P(label, TEXT_SIZE, 6),  menuItemTextCharacter_P(label, TEXT_SIZE, 7), 
+    menuItemTextCharacter_P(label, TEXT_SIZE, 8),  menuItemTextCharacter_P(label, TEXT_SIZE, 9), 
+    menuItemTextCharacter_P(label, TEXT_SIZE, 10), menuItemTextCharacter_P(label, TEXT_SIZE, 11), 
+    menuItemTextCharacter_P(label, TEXT_SIZE, 12), menuItemTextCharacter_P(label, TEXT_SIZE, 13)}, 
+    fieldOffset, fieldSize, minValue, maxValue, step, digitsRightOfDecimal});
+}
+
+
+//
+// entries of a settings table, each names the field of the configuration 
+// struct that it edits.  The limits and step of a decimal setting are given 
+// the same way the field holds them, for example 0 - 500 with 2 digits right 
+// of the decimal is 0.00 - 5.00
+//
+#define SETTING_ENTRY_INT(structType, fieldName, label, minValue, maxValue, step) \
+  settingItem_P(SETTING_TYPE_INT, label, offsetof(structType, fieldName), \
+    sizeof(((structType *) 0)->fieldName), (minValue), (maxValue), (step), 0)
+#define SETTING_ENTRY_DECIMAL(structType, fieldName, label, minValue, maxValue, step, digitsRightOfDecimal) \
+  settingItem_P(SETTING_TYPE_DECIMAL, label, offsetof(structType, fieldName), \
+    sizeof(((structType *) 0)->fieldName), (minValue), (maxValue), (step), (digitsRightOfDecimal))
+#define SETTING_ENTRY_TOGGLE(structType, fieldName, label, minValue, maxValue) \
+  settingItem_P(SETTING_TYPE_TOGGLE, label, offsetof(structType, fieldName), \
+    sizeof(((structType *) 0)->fieldName), (minValue), (maxValue), 1, 0)
+
+
+//
+// check the entries of a settings table: each field must be a byte, int or 
+// long that can hold the setting's range, and int sliders are limited to the 
+// range of an int
+//
+constexpr boolean settingsAreValid_P(void)
+{
+  return(true);
+}
+
+template<typename... REMAINING_SETTINGS> 
+constexpr boolean settingsAreValid_P(const SETTING_ITEM &setting, const REMAINING_SETTINGS &... remainingSettings)
+{
+  return(
+    ((setting.FieldSize == 1) || (setting.FieldSize == 2) || (setting.FieldSize == 4)) &&
+    ((setting.FieldSize != 1) || ((setting.MinValue >= 0) && (setting.MaxValue <= 255))) &&
+    ((setting.FieldSize != 2) || ((setting.MinValue >= -32768) && (setting.MaxValue <= 32767))) &&
+    ((setting.SettingType != SETTING_TYPE_INT) || ((setting.MinValue >= -32768) && (setting.MaxValue <= 32767))) &&
+    (setting.MinValue < setting.MaxValue) && (setting.Step > 0) && (setting.DigitsRightOfDecimal <= 4) &&
+    settingsAreValid_P(remainingSettings...));
+}
+
+
+//
+// define a settings table stored in flash, mistakes in the table are reported 
+// when compiling.  For example:
+//
+//    SETTINGS_TABLE_P(mySettings,
+//      SETTING_ENTRY_INT(MY_CONFIG, Contrast, "Contrast", 1, 127, 1),
+//      SETTING_ENTRY_TOGGLE(MY_CONFIG, LEDOn, "LED", 0, 1));
+//
+//    SETTINGS_MENU mySettingsMenu = {mySettings, 
+//      sizeof(mySettings) / sizeof(mySettings[0]), mySettingChanged};
+//
+#define SETTINGS_TABLE_P(tableName, ...) \
+  static_assert(settingsAreValid_P(__VA_ARGS__), \
+    "settings table " #tableName " has a setting with a bad field size or range"); \
+  const SETTING_ITEM tableName[] PROGMEM = { __VA_ARGS__ }
 
 
 //
@@ -86,6 +358,112 @@ const byte BUTTON_RELEASED_EVENT  = 0x80;   // the button was released
 const byte BUTTON_REPEAT_EVENT    = 0xc0;   // button is held down & periodically repeats
 
 
+//
+// number of button events that can wait in the queue when the buttons are 
+// sampled by an interrupt (must be a power of 2, up to 128).  Events found 
+// while the queue is full are dropped and counted, see 
+// buttonsGetDroppedEventCount()
+//
+#ifndef ARDUINO_USER_INTERFACE_BUTTON_EVENT_QUEUE_SIZE
+#define ARDUINO_USER_INTERFACE_BUTTON_EVENT_QUEUE_SIZE 8
+#endif
+
+const byte BUTTON_EVENT_QUEUE_SIZE = ARDUINO_USER_INTERFACE_BUTTON_EVENT_QUEUE_SIZE;
+
+static_assert((BUTTON_EVENT_QUEUE_SIZE >= 2) && (BUTTON_EVENT_QUEUE_SIZE <= 128) &&
+  ((BUTTON_EVENT_QUEUE_SIZE & (BUTTON_EVENT_QUEUE_SIZE - 1)) == 0), 
+  "the button event queue size must be a power of 2 from 2 to 128");
+
+
+//
+// define the Timer0 compare A ISR set up by buttonsEnableInterruptSampling(), 
+// put this in the sketch after the user interface object is created:
+//
+//    BUTTONS_SAMPLE_FROM_TIMER0_ISR(ui)
+//
+#if defined(__AVR__)
+#define BUTTONS_SAMPLE_FROM_TIMER0_ISR(userInterface) \
+  ISR(TIMER0_COMPA_vect) { (userInterface).buttonsSampleFromISR(); }
+#endif
+
+
+//
+// ADC clock prescalers used when the buttons are read with split phase 
+// conversions (the value of the ADPS bits on AVR), the resistor ladder does not 
+// need 10 bit accuracy so a fast ADC clock is fine
+//
+const byte BUTTON_ADC_PRESCALER_16  = 4;    // 1 MHz ADC clock with a 16 MHz CPU
+const byte BUTTON_ADC_PRESCALER_32  = 5;
+const byte BUTTON_ADC_PRESCALER_64  = 6;
+const byte BUTTON_ADC_PRESCALER_128 = 7;    // Arduino's default, 125 kHz ADC clock
+
+
+//
+// definition of one button on a resistor ladder, the range of ADC readings 
+// (0 - 1023) given when that button is pressed.  A ladder is described by a 
+// constexpr array of these, for example:
+//
+//    constexpr BUTTON_LADDER_STEP myLadder[] = {
+//      {BUTTON_ID_SELECT, 0, 80},
+//      {BUTTON_ID_BACK, 279, 359},
+//      ... };
+//
+typedef struct _BUTTON_LADDER_STEP
+{
+  byte ButtonID;
+  int LowestADCValue;
+  int HighestADCValue;
+} BUTTON_LADDER_STEP;
+
+
+//
+// the buttons are found with a lookup table indexed by the top 6 bits of the 
+// ADC reading, each entry covers 16 ADC counts
+//
+const byte BUTTON_LADDER_TABLE_SHIFT = 4;
+const byte BUTTON_LADDER_TABLE_SIZE = 1024 >> BUTTON_LADDER_TABLE_SHIFT;
+
+
+//
+// find the button pressed for an ADC reading from a ladder description, this 
+// is evaluated by the compiler when building a lookup table
+//  Enter:  ladderSteps -> array describing the ladder
+//          numberOfSteps = number of entries in the array
+//          adcValue = ADC reading to classify
+//  Exit:   button ID returned, BUTTON_ID_NONE if no button
+//
+constexpr byte buttonLadderClassify(const BUTTON_LADDER_STEP *ladderSteps, int numberOfSteps, int adcValue)
+{
+  return((numberOfSteps == 0) ? BUTTON_ID_NONE :
+    ((adcValue >= ladderSteps[0].LowestADCValue) && (adcValue <= ladderSteps[0].HighestADCValue)) ? ladderSteps[0].ButtonID :
+    buttonLadderClassify(ladderSteps + 1, numberOfSteps - 1, adcValue));
+}
+
+
+//
+// build a PROGMEM lookup table from a ladder description, each entry gives the 
+// button found at the middle of its range of ADC readings.  Pass the table to 
+// buttonsSetLadderTable() to use it.  For example:
+//
+//    BUTTON_LADDER_LOOKUP_TABLE(myLadderTable, myLadder);
+//    ...
+//    ui.buttonsSetLadderTable(myLadderTable);
+//
+#define BUTTON_LADDER_TABLE_ENTRY(ladderSteps, i) \
+  buttonLadderClassify(ladderSteps, sizeof(ladderSteps) / sizeof(ladderSteps[0]), \
+    ((i) << BUTTON_LADDER_TABLE_SHIFT) + (1 << (BUTTON_LADDER_TABLE_SHIFT - 1)))
+#define BUTTON_LADDER_TABLE_ENTRIES_4(ladderSteps, i) \
+  BUTTON_LADDER_TABLE_ENTRY(ladderSteps, (i)), BUTTON_LADDER_TABLE_ENTRY(ladderSteps, (i) + 1), \
+  BUTTON_LADDER_TABLE_ENTRY(ladderSteps, (i) + 2), BUTTON_LADDER_TABLE_ENTRY(ladderSteps, (i) + 3)
+#define BUTTON_LADDER_TABLE_ENTRIES_16(ladderSteps, i) \
+  BUTTON_LADDER_TABLE_ENTRIES_4(ladderSteps, (i)), BUTTON_LADDER_TABLE_ENTRIES_4(ladderSteps, (i) + 4), \
+  BUTTON_LADDER_TABLE_ENTRIES_4(ladderSteps, (i) + 8), BUTTON_LADDER_TABLE_ENTRIES_4(ladderSteps, (i) + 12)
+#define BUTTON_LADDER_LOOKUP_TABLE(tableName, ladderSteps) \
+  const byte tableName[BUTTON_LADDER_TABLE_SIZE] PROGMEM = { \
+    BUTTON_LADDER_TABLE_ENTRIES_16(ladderSteps, 0), BUTTON_LADDER_TABLE_ENTRIES_16(ladderSteps, 16), \
+    BUTTON_LADDER_TABLE_ENTRIES_16(ladderSteps, 32), BUTTON_LADDER_TABLE_ENTRIES_16(ladderSteps, 48) }
+
+
 //
 // Slider Display callback actions
 //
@@ -94,6 +472,91 @@ const byte SLIDER_DISPLAY_VALUE_SET     = 2;
 const byte SLIDER_DISPLAY_CANCELED      = 3;
 
 
+//
+// configuration writes can be held in a RAM journal and written to the EEPROM 
+// together, either when committed or after the buttons have been idle a while
+//
+const byte CONFIG_JOURNAL_SIZE = 8;
+const unsigned int CONFIG_JOURNAL_IDLE_COMMIT_MILLIS = 2000;
+
+
+//
+// each slot of a wear leveled long is a sequence number followed by the value, 
+// the sequence numbers count from 0 to CONFIG_SEQUENCE_NUMBER_LIMIT - 1 so 
+// never match erased EEPROM (0xff)
+//
+const byte CONFIG_WEAR_LEVELED_SLOT_SIZE = 5;
+const byte CONFIG_SEQUENCE_NUMBER_LIMIT = 0xff;
+
+
+//
+// definition of one field in a configuration struct saved with a schema, 
+// tables of these are stored in program memory.  Build each entry with 
+// CONFIG_FIELD_ENTRY(), for example:
+//
+//    const CONFIG_FIELD myConfigFields[] PROGMEM = {
+//      CONFIG_FIELD_ENTRY(MY_CONFIG, Contrast, 65),
+//      CONFIG_FIELD_ENTRY(MY_CONFIG, RunCount, 0)};
+//
+typedef struct _CONFIG_FIELD
+{
+  unsigned int FieldOffset;          // where the field is in the struct
+  byte FieldSize;                    // 1 for byte, 2 for int, 4 for long
+  long DefaultValue;                 // value used when the field isn't saved
+} CONFIG_FIELD;
+
+#define CONFIG_FIELD_ENTRY(structType, fieldName, defaultValue) \
+  {offsetof(structType, fieldName), sizeof(((structType *) 0)->fieldName), (defaultValue)}
+
+
+//
+// definition of a configuration block, the application's settings struct is 
+// saved with a version number and CRC, in two copies so that a write 
+// interrupted by a power failure never loses the settings
+//
+typedef struct _CONFIG_SCHEMA
+{
+  int EEPromAddress;                 // address of the first copy in EEPROM
+  unsigned int ReservedSize;         // bytes reserved for the struct in each 
+                                     //   copy, leave room for adding fields
+  byte Version;                      // change when fields are added
+  void *Configuration;               // the application's settings struct
+  unsigned int ConfigurationSize;    // sizeof() the settings struct
+  const CONFIG_FIELD *Fields;        // table of the struct's fields (PROGMEM)
+  byte NumberOfFields;               // number of entries in the field table
+  void (*MigrateConfiguration)(byte savedVersion, void *configuration);
+                                     // called after loading an older version, 
+                                     //   new fields already have defaults, NULL 
+                                     //   if not needed
+} CONFIG_SCHEMA;
+
+
+//
+// define a configuration schema, the compiler checks that the settings struct 
+// fits in the space reserved for it.  For example:
+//
+//    CONFIG_SCHEMA_DEFINE(myConfigSchema, 0, 32, 1, config, myConfigFields, NULL);
+//
+// gives the block at EEPROM address 0, 32 bytes reserved for the struct, 
+// version 1, the struct, its field table and no migrate function
+//
+#define CONFIG_SCHEMA_DEFINE(schemaName, EEPromAddress, reservedSize, version, configuration, fields, migrateFunction) \
+  static_assert(sizeof(configuration) <= (reservedSize), \
+    "the settings struct of " #schemaName " is bigger than the space reserved for it"); \
+  CONFIG_SCHEMA schemaName = { \
+    (EEPromAddress), (reservedSize), (version), \
+    &(configuration), sizeof(configuration), \
+    (fields), sizeof(fields) / sizeof((fields)[0]), (migrateFunction)}
+
+
+//
+// each copy of a configuration block is a header (sequence number, version 
+// and size of the saved struct), the struct, then a CRC16 of both
+//
+const byte CONFIG_BLOCK_HEADER_SIZE = 4;
+const byte CONFIG_BLOCK_CRC_SIZE = 2;
+
+
 //
 // LCD size constants
 //
@@ -101,6 +564,115 @@ const byte LCD_WIDTH_IN_PIXELS = 84;
 const byte LCD_LAST_COLUMN_X = LCD_WIDTH_IN_PIXELS-1;
 const byte LCD_HEIGHT_IN_PIXELS = 48;
 const byte LCD_HEIGHT_IN_LINES = 6;
+const int LCD_FRAME_BUFFER_SIZE = LCD_WIDTH_IN_PIXELS * LCD_HEIGHT_IN_LINES;
+
+
+//
+// definition of a font, all tables are stored in program memory.  Every glyph 
+// is 8 pixels high, one byte per column, and is followed by one blank column 
+// when drawn.
+//
+typedef struct _LCD_FONT
+{
+  const byte *GlyphColumns;          // columns of all the glyphs packed together
+  const unsigned int *GlyphOffsets;  // where each glyph starts in GlyphColumns, plus 
+                                     //   one entry for the end, NULL if fixed width
+  byte GlyphWidth;                   // width of every glyph in a fixed width font, 
+                                     //   or of the digits in a proportional font
+  byte FirstCharacter;               // first character in the font
+  byte LastCharacter;                // last character in the font
+} LCD_FONT;
+
+
+//
+// the widest glyph that can be drawn
+//
+const byte LCD_FONT_MAX_GLYPH_WIDTH = 8;
+
+
+//
+// largest text scale, text scaled by 3 is 24 pixels (3 lines) high
+//
+const byte LCD_MAX_TEXT_SCALE = 3;
+
+
+//
+// fonts included with the library, the 5 x 8 fixed width font is used unless 
+// lcdSetFont() selects another
+//
+extern const LCD_FONT lcdFont5x8;
+extern const LCD_FONT lcdFontProportional;
+
+
+//
+// LCD transports, selects how bytes are sent to the LCD
+//
+const byte LCD_TRANSPORT_BIT_BANG     = 0;    // any digital pins, bits toggled in software
+const byte LCD_TRANSPORT_HARDWARE_SPI = 1;    // CLK & DIN wired to the SPI SCK & MOSI pins
+const byte LCD_TRANSPORT_CALLBACK     = 2;    // bytes given to the lcdSetTransportCallback() function
+
+
+//
+// set to 1 to count the commands, data bytes and cursor moves sent to the LCD 
+// by each drawing operation, along with the time it takes, see 
+// lcdPrintInstrumentTrace().  When 0, the instrumentation compiles to nothing.
+//
+#ifndef ARDUINO_USER_INTERFACE_INSTRUMENT
+#define ARDUINO_USER_INTERFACE_INSTRUMENT 0
+#endif
+
+
+//
+// set to 1 to store a second, pre-inverted copy of the font in program memory 
+// (485 bytes) so reverse video text is drawn as fast as normal text
+//
+#ifndef ARDUINO_USER_INTERFACE_REVERSE_FONT
+#define ARDUINO_USER_INTERFACE_REVERSE_FONT 0
+#endif
+
+
+//
+// type of the AVR port registers written to send bits to the LCD, the host 
+// tests in extras/test replace it with a model that records each write
+//
+#ifndef ARDUINO_USER_INTERFACE_PORT_REGISTER
+#define ARDUINO_USER_INTERFACE_PORT_REGISTER volatile uint8_t
+#endif
+
+
+//
+// drawing operations that are measured by the instrumentation
+//
+const byte LCD_OPERATION_NONE                = 0;
+const byte LCD_OPERATION_DRAW_MENU           = 1;
+const byte LCD_OPERATION_MOVE_MENU_SELECTION = 2;
+const byte LCD_OPERATION_DRAW_SLIDER         = 3;
+const byte LCD_OPERATION_UPDATE_SLIDER       = 4;
+const byte LCD_OPERATION_DRAW_BUTTON_BAR     = 5;
+const byte LCD_OPERATION_CLEAR_DISPLAY_SPACE = 6;
+const byte LCD_OPERATION_CLEAR_DISPLAY       = 7;
+const byte LCD_OPERATION_PRINT_STRING        = 8;
+const byte LCD_OPERATION_FLUSH               = 9;
+
+
+//
+// number of measured operations kept for lcdPrintInstrumentTrace() (must be a 
+// power of 2)
+//
+const byte LCD_INSTRUMENT_TRACE_SIZE = 8;
+
+
+//
+// what was sent to the LCD by one drawing operation
+//
+typedef struct _LCD_INSTRUMENT_RECORD
+{
+  byte Operation;
+  unsigned int CommandCount;
+  unsigned int DataByteCount;
+  unsigned int CursorMoveCount;
+  unsigned long ElapsedMicros;
+} LCD_INSTRUMENT_RECORD;
 
 
 //
@@ -114,20 +686,41 @@ class ArduinoUserInterface
     //
     byte toggleMenuChangeStateFlag;
     char *toggleMenuStateText;
+    int menuItemNumber;
 
 
     //
     // public functions
     //
     ArduinoUserInterface(void);
-    void connectToPins(byte _lcdClockPin, byte _lcdDataInPin, byte _lcdDataControlPin, byte _lcdChipEnablePin, byte _buttonAnalogPin);
+    void connectToPins(byte _lcdClockPin, byte _lcdDataInPin, byte _lcdDataControlPin, byte _lcdChipEnablePin, byte _buttonAnalogPin, byte _lcdTransport = LCD_TRANSPORT_BIT_BANG);
     void displayAndExecuteMenu(MENU_ITEM *menu);
+    void displayAndExecuteMenu(const MENU_ITEM_P *menu);
+    void displayAndExecuteMenu(VIRTUAL_MENU *menu);
+    void displayAndExecuteMenu(SETTINGS_MENU *menu);
     void displaySlider(int minValue, int maxValue, int step, int initialValue, char *label, void (*callbackFunc)(byte, int));
     void displayFloatSlider(float minValue, float maxValue, float step, float initialValue, char *label, byte digitsRightOfDecimal, void (*callbackFunc)(byte, float));
+    void displayDecimalSlider(long minValue, long maxValue, long step, long initialValue, char *label, byte digitsRightOfDecimal, void (*callbackFunc)(byte, long));
+    void beginMenu(MENU_ITEM *menu);
+    void beginMenu(const MENU_ITEM_P *menu);
+    void beginMenu(VIRTUAL_MENU *menu);
+    void beginMenu(SETTINGS_MENU *menu);
+    void beginSlider(int minValue, int maxValue, int step, int initialValue, char *label, void (*callbackFunc)(byte, int));
+    void beginFloatSlider(float minValue, float maxValue, float step, float initialValue, char *label, byte digitsRightOfDecimal, void (*callbackFunc)(byte, float));
+    void beginDecimalSlider(long minValue, long maxValue, long step, long initialValue, char *label, byte digitsRightOfDecimal, void (*callbackFunc)(byte, long));
+    void tick(void);
+    boolean isActive(void);
     void clearDisplaySpace(void);
     byte getButtonEvent(void);
+    byte processButtonSample(byte currentButtonID, unsigned long currentTime);
+    void buttonsEnableInterruptSampling(boolean configureTimerFlg = true);
+    void buttonsSampleFromISR(void);
+    byte buttonsGetDroppedEventCount(void);
+    void buttonsUseSplitPhaseADC(boolean enableFlg, byte adcPrescaler = BUTTON_ADC_PRESCALER_16);
+    int analogReadOther(byte pin);
+    void buttonsSetLadderTable(const byte *ladderLookupTable);
     boolean intInRange(int value, int lowerValue, int upperValue);
-    void drawButtonBar(char *leftButtonText, char *rightButtonText);
+    void drawButtonBar(const char *leftButtonText, const char *rightButtonText);
     void lcdPrintInt(int n);
     void lcdPrintIntLeftJustified(int n, int padToNumberOfDigits);
     void lcdPrintIntRightJustified(int n, int padToNumberOfDigits);
@@ -136,23 +729,43 @@ class ArduinoUserInterface
     void lcdPrintStringLeftJustified(char *s, int padToNumberOfCharacters);
     void lcdPrintStringRightJustified(char *s, int padToNumberOfCharacters);
     void lcdPrintStringCentered(char *s, int padToNumberOfCharacters);
-    void lcdPrintCenteredStringReverse(char *s, byte X, byte padToWidth);
-    void lcdPrintStringReverse(char *s);
+    void lcdPrintCenteredStringReverse(const char *s, byte X, byte padToWidth);
+    void lcdPrintStringReverse(const char *s);
+    void lcdPrintString_P(const char *s);
+    void lcdPrintStringReverse_P(const char *s);
+    void lcdPrintf(const __FlashStringHelper *format, ...);
     void lcdPrintCharacter(byte character);
     void lcdPrintCharacterReverse(byte character);
-    byte lcdStringWidthInPixels(char *s);
+    byte lcdStringWidthInPixels(const char *s);
+    void lcdSetFont(const LCD_FONT *font);
+    void lcdPrintStringLarge(char *s, byte scale);
+    void lcdUpdateStringLarge(char *s, char *previousString, byte scale);
     void lcdClearDisplay(void);
     void lcdFillToColumnX(int X, byte byteOfPixels);
     void lcdFillToEndOfLine(byte byteOfPixels);
     void lcdDrawRowOfPixels(int X1, int X2, int lineNumber, byte byteOfPixels);
     void lcdSetCursorXY(int column, int lineNumber);
     void lcdSetContrast(int contrastValue);
+    void lcdUseFrameBuffer(byte *frameBuffer);
+    void lcdFlush(void);
+    void lcdWriteFrameBufferAsPBM(Print &output);
+    void lcdSetTransportCallback(void (*transportCallback)(byte dataOrCommand, byte lcdByte));
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+    void lcdPrintInstrumentTrace(Print &output);
+#endif
     void writeConfigurationByte(int EEPromAddress, byte value);
     byte readConfigurationByte(int EEPromAddress, byte defaultValue);
     void writeConfigurationInt(int EEPromAddress, int value);
     int readConfigurationInt(int EEPromAddress, int defaultValue);
     void writeConfigurationLong(int EEPromAddress, long value);
     long readConfigurationLong(int EEPromAddress, long defaultValue);
+    void writeConfigurationLongWearLeveled(int EEPromAddress, byte numberOfSlots, long value);
+    long readConfigurationLongWearLeveled(int EEPromAddress, byte numberOfSlots, long defaultValue);
+    void configurationUseWriteJournal(boolean enableFlg, unsigned int idleCommitMillis = CONFIG_JOURNAL_IDLE_COMMIT_MILLIS);
+    void configurationCommit(void);
+    boolean loadConfiguration(const CONFIG_SCHEMA *schema);
+    void saveConfiguration(void);
+    void configurationSetEEPROMCallbacks(byte (*readCallback)(int EEPromAddress), void (*writeCallback)(int EEPromAddress, byte value));
 
 
   private:
@@ -163,17 +776,74 @@ class ArduinoUserInterface
     byte lcdDataInPin;
     byte lcdDataControlPin;
     byte lcdChipEnablePin;
+    byte lcdTransport;
+    void (*lcdTransportCallback)(byte dataOrCommand, byte lcdByte);
+    byte lcdTransferDataOrCommand;
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+    byte lcdInstrumentDepth;
+    LCD_INSTRUMENT_RECORD lcdInstrumentRecord;
+    LCD_INSTRUMENT_RECORD lcdInstrumentTrace[LCD_INSTRUMENT_TRACE_SIZE];
+    byte lcdInstrumentTraceHead;
+    byte lcdInstrumentTraceCount;
+#endif
+#if defined(__AVR__)
+    ARDUINO_USER_INTERFACE_PORT_REGISTER *lcdClockPort;
+    ARDUINO_USER_INTERFACE_PORT_REGISTER *lcdDataInPort;
+    ARDUINO_USER_INTERFACE_PORT_REGISTER *lcdDataControlPort;
+    ARDUINO_USER_INTERFACE_PORT_REGISTER *lcdChipEnablePort;
+    byte lcdClockBitMask;
+    byte lcdDataInBitMask;
+    byte lcdDataControlBitMask;
+    byte lcdChipEnableBitMask;
+#endif
     byte lcdCursorColumnX;
     byte lcdCursorRowY;
+    byte lcdAddressX;
+    byte lcdAddressY;
+    const LCD_FONT *lcdFont;
+
+    byte *lcdFrameBuffer;
+    byte lcdFrameBufferX;
+    byte lcdFrameBufferY;
+    byte lcdFrameBufferDirtyFirstX[LCD_HEIGHT_IN_LINES];
+    byte lcdFrameBufferDirtyLastX[LCD_HEIGHT_IN_LINES];
 
     byte buttonAnalogPin;
     byte buttonState;
     byte buttonID;
     unsigned long buttonEventStartTime;
+    boolean buttonSamplingFromInterrupt;
+    volatile byte buttonEventQueue[BUTTON_EVENT_QUEUE_SIZE];
+    volatile byte buttonEventQueueHead;
+    volatile byte buttonEventQueueTail;
+    volatile byte buttonEventQueueDroppedCount;
+    const byte *buttonLadderTable;
+    boolean buttonADCSplitPhase;
+    byte buttonADCLastButtonID;
+    byte buttonADCMux;
+    byte buttonADCSavedPrescaler;
+
+    byte engineState;
+    void (ArduinoUserInterface::*engineButtonEvent)(byte buttonEvent);
+    byte engineStateAfterSlider;
+    boolean engineMenuRedrawPending;
 
     MENU_ITEM *currentMenuTable;
-    byte currentMenuItemIdx;
-    byte currentMenuTopLineItemIdx;
+    const MENU_ITEM_P *currentMenuTable_P;
+    VIRTUAL_MENU *currentVirtualMenu;
+    SETTINGS_MENU *currentSettingsMenu;
+    MENU_ITEM virtualMenuItem;
+    int virtualMenuItemIdx;
+    int currentMenuItemCount;
+    byte menuLineWidthInPixels;
+    unsigned int menuRepeatCount;
+    int currentMenuItemIdx;
+    int currentMenuTopLineItemIdx;
+    int menuToggleTextCacheItemIdx[MAX_MENU_ITEMS_TO_DISPLAY];
+    MENU_NAVIGATION_LEVEL menuNavigationStack[MAX_MENU_NAVIGATION_DEPTH];
+    byte menuNavigationDepth;
+    byte menuNavigationBase;
+    char menuToggleTextCache[MAX_MENU_ITEMS_TO_DISPLAY][MENU_TOGGLE_TEXT_CACHE_SIZE];
 
     int sliderDisplayMinValue;
     int sliderDisplayMaxValue;
@@ -181,6 +851,8 @@ class ArduinoUserInterface
     int sliderDisplayValue;
     void (*sliderDisplayCallbackFunc)(byte, int);
     unsigned int sliderDisplayRepeatCount;
+    byte sliderDisplayNeedleLength;
+    char sliderDisplayValueText[13];
     
     float sliderDisplayFloatMinValue;
     float sliderDisplayFloatMaxValue;
@@ -189,22 +861,108 @@ class ArduinoUserInterface
     byte sliderDisplayDigitsRightOfDecimal;
     void (*sliderDisplayFloatCallbackFunc)(byte, float);
 
+    long sliderDisplayDecimalMinValue;
+    long sliderDisplayDecimalMaxValue;
+    long sliderDisplayDecimalStep;
+    long sliderDisplayDecimalValue;
+    void (*sliderDisplayDecimalCallbackFunc)(byte, long);
+    boolean sliderEditingSetting;
+
+    SETTING_ITEM settingsEditItem;
+    int settingsEditNumber;
+    long settingsOriginalValue;
+    char settingsValueText[13];
+
+    boolean configJournalEnabled;
+    unsigned int configJournalIdleCommitMillis;
+    unsigned long configJournalLastWriteTime;
+    byte configJournalCount;
+    int configJournalAddress[CONFIG_JOURNAL_SIZE];
+    byte configJournalValue[CONFIG_JOURNAL_SIZE];
+    byte (*configReadCallback)(int EEPromAddress);
+    void (*configWriteCallback)(int EEPromAddress, byte value);
+    const CONFIG_SCHEMA *configSchema;
+    byte configSchemaNewestCopy;
+    byte configSchemaSequence;
+
     
     //
     // private functions
     //
+    void menuButtonEvent(byte buttonEvent);
+    void sliderButtonEvent(byte buttonEvent);
+    void floatSliderButtonEvent(byte buttonEvent);
+    void decimalSliderButtonEvent(byte buttonEvent);
+    void endSlider(void);
     void selectAndDrawMenu(MENU_ITEM *menu);
+    void selectAndDrawMenu(const MENU_ITEM_P *menu);
+    void selectAndDrawMenu(VIRTUAL_MENU *menu);
+    void selectAndDrawMenu(SETTINGS_MENU *menu);
+    MENU_ITEM *getVirtualMenuItem(int menuIdx);
+    void selectAndDrawCurrentMenu(void);
+    void redrawCurrentMenu(void);
+    void displayAndExecuteMenuTable(MENU_ITEM *menu, const MENU_ITEM_P *menu_P, VIRTUAL_MENU *virtualMenu, SETTINGS_MENU *settingsMenu);
+    void startMenuNavigation(void);
+    void saveMenuNavigationLevel(MENU_NAVIGATION_LEVEL *menuLevel);
+    void restoreMenuNavigationLevel(MENU_NAVIGATION_LEVEL *menuLevel);
+    void selectAndDrawLinkedMenu(int menuIdx);
+    boolean menuItemHasLinkedMenu(int menuIdx);
+    byte getMenuItemType(int menuIdx);
+    void callMenuItemFunction(int menuIdx);
+    void drawMenuItemText(int menuIdx, boolean reverseFlag);
     void drawMenu(void);
-    void drawMenuItem(byte menuIdx, byte menuLine);
+    void drawMenuItem(int menuIdx, byte menuLine);
+    void moveMenuSelection(int newMenuItemIdx);
+    int getMenuScrollStride(void);
+    void drawMenuScrollBar(int previousTopLineItemIdx);
+    byte getMenuScrollBarColumn(byte menuLine, int topLineItemIdx);
+    int countMenuItems(void);
+    char *getMenuToggleStateText(int menuIdx, boolean changeStateFlag);
     void drawSlider(void);
     void drawFloatSlider(void);
+    void drawDecimalSlider(void);
+    void formatDecimalValue(long value, byte digitsRightOfDecimal, char *buffer);
+    void sliderCallback(byte operation, int value);
+    void decimalSliderCallback(byte operation, long value);
+    void settingsMenuItemFunction(int settingNumber);
+    void settingsSliderEvent(byte operation, long value);
+    void drawSliderNeedleAndValue(byte needleLength, char *valueText, byte padToNumberOfCharacters);
     void executeMenuItem();
     void buttonsInitialize(void);
     byte readButtonsToGetButtonID(void);
+    byte getButtonIDFromAnalogValue(int buttonAnalogValue);
     void lcdInitialise(void);
     void lcdWriteCommand(byte command);
-    void lcdWriteData(byte data);
+    void lcdWriteDataBurst(const byte *data, int count);
+    void lcdWriteDataFill(byte data, int count);
+    byte lcdGetGlyph(const LCD_FONT *font, byte character, byte *glyph);
+    byte lcdCharacterWidthInPixels(byte character);
+    void lcdPrintfNumber(unsigned long magnitude, boolean negativeFlag, byte digitsRightOfDecimal, byte fieldWidth, byte fieldFlags);
+    void lcdPrintfString(const char *s, boolean flashFlag, byte fieldWidth, byte fieldFlags);
+    int lcdPrintfBeginField(int contentWidthInPixels, byte fieldWidth, byte fieldFlags);
+    void lcdPrintCharacterLarge(byte character, byte scale);
+    void lcdSetAddress(int column, int lineNumber);
+    void lcdAdvanceAddress(int count);
+    void lcdFrameBufferWrite(byte data);
+    void lcdBeginTransfer(byte dataOrCommand);
+    void lcdEndTransfer(void);
     void lcdSerialOut(byte data);
+    byte configReadByte(int EEPromAddress);
+    void configWriteByte(int EEPromAddress, byte value);
+    void configUpdateEEPROM(int EEPromAddress, byte value);
+    void configCommitIfIdle(void);
+    int configFindLatestSlot(int EEPromAddress, byte numberOfSlots);
+    int configBlockAddress(byte copy);
+    boolean configReadBlock(byte copy, byte *savedVersion, unsigned int *savedSize);
+    void configSetDefaults(unsigned int savedSize);
+    long configGetField(unsigned int fieldOffset, byte fieldSize);
+    void configSetField(unsigned int fieldOffset, byte fieldSize, long value);
+    unsigned int configCRC16Update(unsigned int crc, byte data);
+#if ARDUINO_USER_INTERFACE_INSTRUMENT
+    void lcdInstrumentBegin(byte operation);
+    void lcdInstrumentEnd(void);
+    friend class LcdInstrumentScope;
+#endif
 };
 
 // ------------------------------------ End ---------------------------------
@@ -0,0 +1,134 @@
+//      ******************************************************************
+//      *                                                                *
+//      *        Font table included by ArduinoUserInterface.cpp         *
+//      *                                                                *
+//      *              Copyright (c) S. Reifel & Co,  2014               *
+//      *                                                                *
+//      ******************************************************************
+
+
+// MIT License
+// 
+// Copyright (c) 2014 Stanley Reifel & Co.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is furnished
+// to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//
+// ASCII font, 5 x 8 pixels, one glyph per line starting with character 0x20.  
+// Each glyph is 5 columns of pixels, the LSB of each byte is the top pixel.  
+// This file is included with FONT_GLYPH() defined to build each font table 
+// from the same data.
+//
+FONT_GLYPH(0x00, 0x00, 0x00, 0x00, 0x00)      // 20  
+FONT_GLYPH(0x00, 0x00, 0x5f, 0x00, 0x00)      // 21 !
+FONT_GLYPH(0x00, 0x07, 0x00, 0x07, 0x00)      // 22 "
+FONT_GLYPH(0x14, 0x7f, 0x14, 0x7f, 0x14)      // 23 #
+FONT_GLYPH(0x24, 0x2a, 0x7f, 0x2a, 0x12)      // 24 $
+FONT_GLYPH(0x23, 0x13, 0x08, 0x64, 0x62)      // 25 %
+FONT_GLYPH(0x36, 0x49, 0x55, 0x22, 0x50)      // 26 &
+FONT_GLYPH(0x00, 0x05, 0x03, 0x00, 0x00)      // 27 '
+FONT_GLYPH(0x00, 0x1c, 0x22, 0x41, 0x00)      // 28 (
+FONT_GLYPH(0x00, 0x41, 0x22, 0x1c, 0x00)      // 29 )
+FONT_GLYPH(0x14, 0x08, 0x3e, 0x08, 0x14)      // 2a *
+FONT_GLYPH(0x08, 0x08, 0x3e, 0x08, 0x08)      // 2b +
+FONT_GLYPH(0x00, 0x50, 0x30, 0x00, 0x00)      // 2c ,
+FONT_GLYPH(0x08, 0x08, 0x08, 0x08, 0x08)      // 2d -
+FONT_GLYPH(0x00, 0x60, 0x60, 0x00, 0x00)      // 2e .
+FONT_GLYPH(0x20, 0x10, 0x08, 0x04, 0x02)      // 2f /
+FONT_GLYPH(0x3e, 0x51, 0x49, 0x45, 0x3e)      // 30 0
+FONT_GLYPH(0x00, 0x42, 0x7f, 0x40, 0x00)      // 31 1
+FONT_GLYPH(0x42, 0x61, 0x51, 0x49, 0x46)      // 32 2
+FONT_GLYPH(0x21, 0x41, 0x45, 0x4b, 0x31)      // 33 3
+FONT_GLYPH(0x18, 0x14, 0x12, 0x7f, 0x10)      // 34 4
+FONT_GLYPH(0x27, 0x45, 0x45, 0x45, 0x39)      // 35 5
+FONT_GLYPH(0x3c, 0x4a, 0x49, 0x49, 0x30)      // 36 6
+FONT_GLYPH(0x01, 0x71, 0x09, 0x05, 0x03)      // 37 7
+FONT_GLYPH(0x36, 0x49, 0x49, 0x49, 0x36)      // 38 8
+FONT_GLYPH(0x06, 0x49, 0x49, 0x29, 0x1e)      // 39 9
+FONT_GLYPH(0x00, 0x36, 0x36, 0x00, 0x00)      // 3a :
+FONT_GLYPH(0x00, 0x56, 0x36, 0x00, 0x00)      // 3b ;
+FONT_GLYPH(0x08, 0x14, 0x22, 0x41, 0x00)      // 3c <
+FONT_GLYPH(0x14, 0x14, 0x14, 0x14, 0x14)      // 3d =
+FONT_GLYPH(0x00, 0x41, 0x22, 0x14, 0x08)      // 3e >
+FONT_GLYPH(0x02, 0x01, 0x51, 0x09, 0x06)      // 3f ?
+FONT_GLYPH(0x32, 0x49, 0x79, 0x41, 0x3e)      // 40 @
+FONT_GLYPH(0x7e, 0x11, 0x11, 0x11, 0x7e)      // 41 A
+FONT_GLYPH(0x7f, 0x49, 0x49, 0x49, 0x36)      // 42 B
+FONT_GLYPH(0x3e, 0x41, 0x41, 0x41, 0x22)      // 43 C
+FONT_GLYPH(0x7f, 0x41, 0x41, 0x22, 0x1c)      // 44 D
+FONT_GLYPH(0x7f, 0x49, 0x49, 0x49, 0x41)      // 45 E
+FONT_GLYPH(0x7f, 0x09, 0x09, 0x09, 0x01)      // 46 F
+FONT_GLYPH(0x3e, 0x41, 0x49, 0x49, 0x7a)      // 47 G
+FONT_GLYPH(0x7f, 0x08, 0x08, 0x08, 0x7f)      // 48 H
+FONT_GLYPH(0x00, 0x41, 0x7f, 0x41, 0x00)      // 49 I
+FONT_GLYPH(0x20, 0x40, 0x41, 0x3f, 0x01)      // 4a J
+FONT_GLYPH(0x7f, 0x08, 0x14, 0x22, 0x41)      // 4b K
+FONT_GLYPH(0x7f, 0x40, 0x40, 0x40, 0x40)      // 4c L
+FONT_GLYPH(0x7f, 0x02, 0x0c, 0x02, 0x7f)      // 4d M
+FONT_GLYPH(0x7f, 0x04, 0x08, 0x10, 0x7f)      // 4e N
+FONT_GLYPH(0x3e, 0x41, 0x41, 0x41, 0x3e)      // 4f O
+FONT_GLYPH(0x7f, 0x09, 0x09, 0x09, 0x06)      // 50 P
+FONT_GLYPH(0x3e, 0x41, 0x51, 0x21, 0x5e)      // 51 Q
+FONT_GLYPH(0x7f, 0x09, 0x19, 0x29, 0x46)      // 52 R
+FONT_GLYPH(0x46, 0x49, 0x49, 0x49, 0x31)      // 53 S
+FONT_GLYPH(0x01, 0x01, 0x7f, 0x01, 0x01)      // 54 T
+FONT_GLYPH(0x3f, 0x40, 0x40, 0x40, 0x3f)      // 55 U
+FONT_GLYPH(0x1f, 0x20, 0x40, 0x20, 0x1f)      // 56 V
+FONT_GLYPH(0x3f, 0x40, 0x38, 0x40, 0x3f)      // 57 W
+FONT_GLYPH(0x63, 0x14, 0x08, 0x14, 0x63)      // 58 X
+FONT_GLYPH(0x07, 0x08, 0x70, 0x08, 0x07)      // 59 Y
+FONT_GLYPH(0x61, 0x51, 0x49, 0x45, 0x43)      // 5a Z
+FONT_GLYPH(0x00, 0x7f, 0x41, 0x41, 0x00)      // 5b [
+FONT_GLYPH(0x02, 0x04, 0x08, 0x10, 0x20)      // 5c 
+FONT_GLYPH(0x00, 0x41, 0x41, 0x7f, 0x00)      // 5d ]
+FONT_GLYPH(0x04, 0x02, 0x01, 0x02, 0x04)      // 5e ^
+FONT_GLYPH(0x40, 0x40, 0x40, 0x40, 0x40)      // 5f _
+FONT_GLYPH(0x00, 0x01, 0x02, 0x04, 0x00)      // 60 `
+FONT_GLYPH(0x20, 0x54, 0x54, 0x54, 0x78)      // 61 a
+FONT_GLYPH(0x7f, 0x48, 0x44, 0x44, 0x38)      // 62 b
+FONT_GLYPH(0x38, 0x44, 0x44, 0x44, 0x20)      // 63 c
+FONT_GLYPH(0x38, 0x44, 0x44, 0x48, 0x7f)      // 64 d
+FONT_GLYPH(0x38, 0x54, 0x54, 0x54, 0x18)      // 65 e
+FONT_GLYPH(0x08, 0x7e, 0x09, 0x01, 0x02)      // 66 f
+FONT_GLYPH(0x0c, 0x52, 0x52, 0x52, 0x3e)      // 67 g
+FONT_GLYPH(0x7f, 0x08, 0x04, 0x04, 0x78)      // 68 h
+FONT_GLYPH(0x00, 0x44, 0x7d, 0x40, 0x00)      // 69 i
+FONT_GLYPH(0x20, 0x40, 0x44, 0x3d, 0x00)      // 6a j 
+FONT_GLYPH(0x7f, 0x10, 0x28, 0x44, 0x00)      // 6b k
+FONT_GLYPH(0x00, 0x41, 0x7f, 0x40, 0x00)      // 6c l
+FONT_GLYPH(0x7c, 0x04, 0x18, 0x04, 0x78)      // 6d m
+FONT_GLYPH(0x7c, 0x08, 0x04, 0x04, 0x78)      // 6e n
+FONT_GLYPH(0x38, 0x44, 0x44, 0x44, 0x38)      // 6f o
+FONT_GLYPH(0x7c, 0x14, 0x14, 0x14, 0x08)      // 70 p
+FONT_GLYPH(0x08, 0x14, 0x14, 0x18, 0x7c)      // 71 q
+FONT_GLYPH(0x7c, 0x08, 0x04, 0x04, 0x08)      // 72 r
+FONT_GLYPH(0x48, 0x54, 0x54, 0x54, 0x20)      // 73 s
+FONT_GLYPH(0x04, 0x3f, 0x44, 0x40, 0x20)      // 74 t
+FONT_GLYPH(0x3c, 0x40, 0x40, 0x20, 0x7c)      // 75 u
+FONT_GLYPH(0x1c, 0x20, 0x40, 0x20, 0x1c)      // 76 v
+FONT_GLYPH(0x3c, 0x40, 0x30, 0x40, 0x3c)      // 77 w
+FONT_GLYPH(0x44, 0x28, 0x10, 0x28, 0x44)      // 78 x
+FONT_GLYPH(0x0c, 0x50, 0x50, 0x50, 0x3c)      // 79 y
+FONT_GLYPH(0x44, 0x64, 0x54, 0x4c, 0x44)      // 7a z
+FONT_GLYPH(0x00, 0x08, 0x36, 0x41, 0x00)      // 7b {
+FONT_GLYPH(0x00, 0x00, 0x7f, 0x00, 0x00)      // 7c |
+FONT_GLYPH(0x00, 0x41, 0x36, 0x08, 0x00)      // 7d }
+FONT_GLYPH(0x10, 0x08, 0x08, 0x10, 0x08)      // 7e ~
+FONT_GLYPH(0x78, 0x46, 0x41, 0x46, 0x78)      // 7f 
+FONT_GLYPH(0x3c, 0x3c, 0x18, 0x18, 0x00)      // 80 right pointing arrow 
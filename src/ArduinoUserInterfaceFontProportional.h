@@ -0,0 +1,154 @@
+//      ******************************************************************
+//      *                                                                *
+//      *  Proportional font table included by ArduinoUserInterface.cpp  *
+//      *                                                                *
+//      *              Copyright (c) S. Reifel & Co,  2014               *
+//      *                                                                *
+//      ******************************************************************
+
+// MIT License
+// 
+// Copyright (c) 2014 Stanley Reifel & Co.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is furnished
+// to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+//
+// proportional ASCII font, 8 pixels high, made from the 5 x 8 font with the 
+// blank columns on each side of a glyph removed.  Digits keep their full width 
+// so columns of numbers still line up.  The columns of every glyph, starting 
+// with character 0x20, are packed together.  The offset table gives where each 
+// glyph starts, with an extra entry at the end, so a glyph's width is the 
+// difference between its offset and the next.
+//
+
+const byte FontProportionalColumns[] PROGMEM = 
+  {
+   0x00, 0x00,                         // 20  
+   0x5f,                               // 21 !
+   0x07, 0x00, 0x07,                   // 22 "
+   0x14, 0x7f, 0x14, 0x7f, 0x14,       // 23 #
+   0x24, 0x2a, 0x7f, 0x2a, 0x12,       // 24 $
+   0x23, 0x13, 0x08, 0x64, 0x62,       // 25 %
+   0x36, 0x49, 0x55, 0x22, 0x50,       // 26 &
+   0x05, 0x03,                         // 27 '
+   0x1c, 0x22, 0x41,                   // 28 (
+   0x41, 0x22, 0x1c,                   // 29 )
+   0x14, 0x08, 0x3e, 0x08, 0x14,       // 2a *
+   0x08, 0x08, 0x3e, 0x08, 0x08,       // 2b +
+   0x50, 0x30,                         // 2c ,
+   0x08, 0x08, 0x08, 0x08, 0x08,       // 2d -
+   0x60, 0x60,                         // 2e .
+   0x20, 0x10, 0x08, 0x04, 0x02,       // 2f /
+   0x3e, 0x51, 0x49, 0x45, 0x3e,       // 30 0
+   0x00, 0x42, 0x7f, 0x40, 0x00,       // 31 1
+   0x42, 0x61, 0x51, 0x49, 0x46,       // 32 2
+   0x21, 0x41, 0x45, 0x4b, 0x31,       // 33 3
+   0x18, 0x14, 0x12, 0x7f, 0x10,       // 34 4
+   0x27, 0x45, 0x45, 0x45, 0x39,       // 35 5
+   0x3c, 0x4a, 0x49, 0x49, 0x30,       // 36 6
+   0x01, 0x71, 0x09, 0x05, 0x03,       // 37 7
+   0x36, 0x49, 0x49, 0x49, 0x36,       // 38 8
+   0x06, 0x49, 0x49, 0x29, 0x1e,       // 39 9
+   0x36, 0x36,                         // 3a :
+   0x56, 0x36,                         // 3b ;
+   0x08, 0x14, 0x22, 0x41,             // 3c <
+   0x14, 0x14, 0x14, 0x14, 0x14,       // 3d =
+   0x41, 0x22, 0x14, 0x08,             // 3e >
+   0x02, 0x01, 0x51, 0x09, 0x06,       // 3f ?
+   0x32, 0x49, 0x79, 0x41, 0x3e,       // 40 @
+   0x7e, 0x11, 0x11, 0x11, 0x7e,       // 41 A
+   0x7f, 0x49, 0x49, 0x49, 0x36,       // 42 B
+   0x3e, 0x41, 0x41, 0x41, 0x22,       // 43 C
+   0x7f, 0x41, 0x41, 0x22, 0x1c,       // 44 D
+   0x7f, 0x49, 0x49, 0x49, 0x41,       // 45 E
+   0x7f, 0x09, 0x09, 0x09, 0x01,       // 46 F
+   0x3e, 0x41, 0x49, 0x49, 0x7a,       // 47 G
+   0x7f, 0x08, 0x08, 0x08, 0x7f,       // 48 H
+   0x41, 0x7f, 0x41,                   // 49 I
+   0x20, 0x40, 0x41, 0x3f, 0x01,       // 4a J
+   0x7f, 0x08, 0x14, 0x22, 0x41,       // 4b K
+   0x7f, 0x40, 0x40, 0x40, 0x40,       // 4c L
+   0x7f, 0x02, 0x0c, 0x02, 0x7f,       // 4d M
+   0x7f, 0x04, 0x08, 0x10, 0x7f,       // 4e N
+   0x3e, 0x41, 0x41, 0x41, 0x3e,       // 4f O
+   0x7f, 0x09, 0x09, 0x09, 0x06,       // 50 P
+   0x3e, 0x41, 0x51, 0x21, 0x5e,       // 51 Q
+   0x7f, 0x09, 0x19, 0x29, 0x46,       // 52 R
+   0x46, 0x49, 0x49, 0x49, 0x31,       // 53 S
+   0x01, 0x01, 0x7f, 0x01, 0x01,       // 54 T
+   0x3f, 0x40, 0x40, 0x40, 0x3f,       // 55 U
+   0x1f, 0x20, 0x40, 0x20, 0x1f,       // 56 V
+   0x3f, 0x40, 0x38, 0x40, 0x3f,       // 57 W
+   0x63, 0x14, 0x08, 0x14, 0x63,       // 58 X
+   0x07, 0x08, 0x70, 0x08, 0x07,       // 59 Y
+   0x61, 0x51, 0x49, 0x45, 0x43,       // 5a Z
+   0x7f, 0x41, 0x41,                   // 5b [
+   0x02, 0x04, 0x08, 0x10, 0x20,       // 5c 
+   0x41, 0x41, 0x7f,                   // 5d ]
+   0x04, 0x02, 0x01, 0x02, 0x04,       // 5e ^
+   0x40, 0x40, 0x40, 0x40, 0x40,       // 5f _
+   0x01, 0x02, 0x04,                   // 60 `
+   0x20, 0x54, 0x54, 0x54, 0x78,       // 61 a
+   0x7f, 0x48, 0x44, 0x44, 0x38,       // 62 b
+   0x38, 0x44, 0x44, 0x44, 0x20,       // 63 c
+   0x38, 0x44, 0x44, 0x48, 0x7f,       // 64 d
+   0x38, 0x54, 0x54, 0x54, 0x18,       // 65 e
+   0x08, 0x7e, 0x09, 0x01, 0x02,       // 66 f
+   0x0c, 0x52, 0x52, 0x52, 0x3e,       // 67 g
+   0x7f, 0x08, 0x04, 0x04, 0x78,       // 68 h
+   0x44, 0x7d, 0x40,                   // 69 i
+   0x20, 0x40, 0x44, 0x3d,             // 6a j 
+   0x7f, 0x10, 0x28, 0x44,             // 6b k
+   0x41, 0x7f, 0x40,                   // 6c l
+   0x7c, 0x04, 0x18, 0x04, 0x78,       // 6d m
+   0x7c, 0x08, 0x04, 0x04, 0x78,       // 6e n
+   0x38, 0x44, 0x44, 0x44, 0x38,       // 6f o
+   0x7c, 0x14, 0x14, 0x14, 0x08,       // 70 p
+   0x08, 0x14, 0x14, 0x18, 0x7c,       // 71 q
+   0x7c, 0x08, 0x04, 0x04, 0x08,       // 72 r
+   0x48, 0x54, 0x54, 0x54, 0x20,       // 73 s
+   0x04, 0x3f, 0x44, 0x40, 0x20,       // 74 t
+   0x3c, 0x40, 0x40, 0x20, 0x7c,       // 75 u
+   0x1c, 0x20, 0x40, 0x20, 0x1c,       // 76 v
+   0x3c, 0x40, 0x30, 0x40, 0x3c,       // 77 w
+   0x44, 0x28, 0x10, 0x28, 0x44,       // 78 x
+   0x0c, 0x50, 0x50, 0x50, 0x3c,       // 79 y
+   0x44, 0x64, 0x54, 0x4c, 0x44,       // 7a z
+   0x08, 0x36, 0x41,                   // 7b {
+   0x7f,                               // 7c |
+   0x41, 0x36, 0x08,                   // 7d }
+   0x10, 0x08, 0x08, 0x10, 0x08,       // 7e ~
+   0x78, 0x46, 0x41, 0x46, 0x78,       // 7f 
+   0x3c, 0x3c, 0x18, 0x18,             // 80 right pointing arrow 
+  };
+
+const unsigned int FontProportionalOffsets[] PROGMEM = 
+  {
+     0,   2,   3,   6,  11,  16,  21,  26,  28,  31,
+    34,  39,  44,  46,  51,  53,  58,  63,  68,  73,
+    78,  83,  88,  93,  98, 103, 108, 110, 112, 116,
+   121, 125, 130, 135, 140, 145, 150, 155, 160, 165,
+   170, 175, 178, 183, 188, 193, 198, 203, 208, 213,
+   218, 223, 228, 233, 238, 243, 248, 253, 258, 263,
+   266, 271, 274, 279, 284, 287, 292, 297, 302, 307,
+   312, 317, 322, 327, 330, 334, 338, 341, 346, 351,
+   356, 361, 366, 371, 376, 381, 386, 391, 396, 401,
+   406, 411, 414, 415, 418, 423, 428, 432
+  };